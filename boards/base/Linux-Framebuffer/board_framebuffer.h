@@ -10,6 +10,15 @@
 	#define GDISP_LLD_PIXELFORMAT		GDISP_PIXELFORMAT_RGB888
 #endif
 
+// Uncomment this to draw off-screen and only update the display when gdispFlush() is called.
+//	This prevents tearing. Use GDISP_NEED_AUTOFLUSH or GDISP_NEED_TIMERFLUSH to flush automatically.
+//	If the frame buffer device can have a virtual height of twice the display height the two halves
+//	are page flipped using FBIOPAN_DISPLAY. Otherwise the changed area is copied to the display.
+//#define USE_BACK_BUFFER
+#ifdef USE_BACK_BUFFER
+	#define GDISP_HARDWARE_FLUSH		TRUE
+#endif
+
 #ifdef GDISP_DRIVER_VMT
 
 	#define FBDEV_PATH1		"/dev/fb0"
@@ -63,6 +72,16 @@
 		}
 	#endif
 
+	#ifdef USE_BACK_BUFFER
+		static struct fbBackBuffer {
+			int							fb;				// The frame buffer device (kept open for panning)
+			struct fb_var_screeninfo	var;
+			char *						screen;			// The displayed memory (the first page when page flipping)
+			size_t						pagelen;		// The number of bytes in one screen
+			bool_t						flip;			// Are we page flipping
+		} fbback;
+	#endif
+
 	static void board_init(GDisplay *g, fbInfo *fbi) {
 		int							fb;
 		char *						env;
@@ -135,6 +154,21 @@
 			exit(-1);
 		}
 
+		#ifdef USE_BACK_BUFFER
+			// Try for a virtual display twice the height so we can page flip
+			if (fb_var.yres_virtual < fb_var.yres * 2) {
+				struct fb_var_screeninfo	fb_try;
+
+				fb_try = fb_var;
+				fb_try.yres_virtual = fb_var.yres * 2;
+				fb_try.activate = FB_ACTIVATE_NOW;
+				if (ioctl(fb, FBIOPUT_VSCREENINFO, &fb_try) != -1)
+					ioctl(fb, FBIOGET_VSCREENINFO, &fb_var);
+				ioctl(fb, FBIOGET_FSCREENINFO, &fb_fix);
+			}
+			fbback.flip = fb_var.yres_virtual >= fb_var.yres * 2 && fb_fix.ypanstep && !(fb_var.yres % fb_fix.ypanstep) ? TRUE : FALSE;
+		#endif
+
 		// Ensure we are at the origin of the virtual display area
 		if (fb_var.xoffset || fb_var.yoffset) {
 			fb_var.xoffset = 0;
@@ -149,6 +183,11 @@
 
 		// Calculate the frame buffer length
 		fblen = fb_var.yres * fb_fix.line_length;
+		#ifdef USE_BACK_BUFFER
+			fbback.pagelen = fblen;
+			if (fbback.flip)
+				fblen *= 2;
+		#endif
 
 		// Different systems need mapping in slightly different ways - Yuck!
 		#ifdef ARCH_LINUX_SPARC
@@ -185,8 +224,22 @@
 		// If this program gets children they should not inherit this file descriptor
 		fcntl(fb, F_SETFD, FD_CLOEXEC);
 
-		// We are finished with the file descriptor
-		close(fb);
+		#ifdef USE_BACK_BUFFER
+			// We draw on the hidden page or into a buffer in memory
+			fbback.fb = fb;
+			fbback.var = fb_var;
+			fbback.screen = (char *)fbi->pixels;
+			if (fbback.flip)
+				fbi->pixels = fbback.screen + fbback.pagelen;
+			else if (!(fbi->pixels = calloc(1, fbback.pagelen))) {
+				fprintf(stderr, "GDISP Framebuffer: Failed to allocate the back buffer\n");
+				exit(-1);
+			}
+			g->board = fbi;
+		#else
+			// We are finished with the file descriptor
+			close(fb);
+		#endif
 
 		// Set the rest of the details of the frame buffer
 		g->g.Width = fb_var.xres;
@@ -198,7 +251,52 @@
 
 	#if GDISP_HARDWARE_FLUSH
 		static void board_flush(GDisplay *g) {
-			(void) g;
+			#ifdef USE_BACK_BUFFER
+				fbInfo *	fbi;
+				char *		src;
+				char *		dst;
+				size_t		len;
+				coord_t		y;
+
+				fbi = (fbInfo *)g->board;
+				if (!fbi->dx1)
+					return;
+
+				if (fbback.flip) {
+					// Show the page we have been drawing on
+					src = (char *)fbi->pixels;
+					fbback.var.yoffset = src == fbback.screen ? 0 : fbback.var.yres;
+					if (ioctl(fbback.fb, FBIOPAN_DISPLAY, &fbback.var) != -1) {
+						// Draw on the other page from now on. It needs the changes we just made.
+						dst = src == fbback.screen ? fbback.screen + fbback.pagelen : fbback.screen;
+						fbi->pixels = dst;
+					} else {
+						// Panning doesn't work after all. Keep drawing on the hidden page and copy all of it.
+						fbback.flip = FALSE;
+						dst = fbback.screen;
+						fbi->dx0 = fbi->dy0 = 0;
+						fbi->dx1 = fbback.var.xres;
+						fbi->dy1 = fbback.var.yres;
+						if (src == dst)
+							return;
+					}
+				} else {
+					// Copy the changed area to the display during the vertical blank (if the driver supports it)
+					uint32_t	crtc = 0;
+
+					ioctl(fbback.fb, FBIO_WAITFORVSYNC, &crtc);
+					src = (char *)fbi->pixels;
+					dst = fbback.screen;
+				}
+
+				len = (fbi->dx1 - fbi->dx0) * sizeof(LLDCOLOR_TYPE);
+				src += fbi->dy0 * fbi->linelen + fbi->dx0 * sizeof(LLDCOLOR_TYPE);
+				dst += fbi->dy0 * fbi->linelen + fbi->dx0 * sizeof(LLDCOLOR_TYPE);
+				for(y = fbi->dy0; y < fbi->dy1; y++, src += fbi->linelen, dst += fbi->linelen)
+					memcpy(dst, src, len);
+			#else
+				(void) g;
+			#endif
 		}
 	#endif
 
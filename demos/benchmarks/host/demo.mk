@@ -0,0 +1,3 @@
+DEMODIR = $(GFXLIB)/demos/benchmarks/host
+GFXINC +=   $(DEMODIR)
+GFXSRC +=	$(DEMODIR)/main.c
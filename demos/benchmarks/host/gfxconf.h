@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2012, 2013, Joel Bodenmann aka Tectu <joel@unormal.org>
+ * Copyright (c) 2012, 2013, Andrew Hannam aka inmarket
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the <organization> nor the
+ *      names of its contributors may be used to endorse or promote products
+ *      derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _GFXCONF_H
+#define _GFXCONF_H
+
+/* The operating system to use. This benchmark is intended to be run on a Linux host */
+//#define GFX_USE_OS_LINUX		TRUE
+
+/* GFX sub-systems to turn on */
+#define GFX_USE_GDISP					TRUE
+#define GFX_USE_GFILE					TRUE
+#define GFX_USE_GMISC					TRUE
+
+/* The TestStub driver display size. The pixmap is created the same size. */
+#define GDISP_SCREEN_WIDTH				320
+#define GDISP_SCREEN_HEIGHT				240
+
+/* Features for the GDISP sub-system. */
+#define GDISP_NEED_STARTUP_LOGO			FALSE
+#define GDISP_NEED_VALIDATION			TRUE
+#define GDISP_NEED_CLIP					TRUE
+#define GDISP_NEED_PIXMAP				TRUE
+#define GDISP_NEED_CIRCLE				TRUE
+#define GDISP_NEED_ARC					TRUE
+#define GDISP_NEED_CONVEX_POLYGON		TRUE
+#define GDISP_NEED_SCROLL				TRUE
+#define GDISP_NEED_PIXELREAD			TRUE
+#define GDISP_NEED_TEXT					TRUE
+#define GDISP_NEED_ANTIALIAS			TRUE
+#define GDISP_NEED_TEXT_WORDWRAP		TRUE
+#define GDISP_NEED_IMAGE				TRUE
+
+/* Fonts */
+#define GDISP_INCLUDE_FONT_DEJAVUSANS16		TRUE
+#define GDISP_INCLUDE_FONT_DEJAVUSANS16_AA	TRUE
+
+/* Image decoders */
+#define GDISP_NEED_IMAGE_BMP			TRUE
+#define GDISP_NEED_IMAGE_GIF			TRUE
+#define GDISP_NEED_IMAGE_PNG			TRUE
+
+/* The test images are stored in a ROMFS so the results don't depend on the host disk */
+#define GFILE_NEED_ROMFS				TRUE
+
+/* Use integer trig for the arcs so that no maths library is required */
+#define GMISC_NEED_FIXEDTRIG			TRUE
+
+#endif /* _GFXCONF_H */
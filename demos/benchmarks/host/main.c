@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2012, 2013, Joel Bodenmann aka Tectu <joel@unormal.org>
+ * Copyright (c) 2012, 2013, Andrew Hannam aka inmarket
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the <organization> nor the
+ *      names of its contributors may be used to endorse or promote products
+ *      derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * A host based GDISP benchmark.
+ *
+ * This is designed to be built for Linux (GFX_USE_OS_LINUX) using the TestStub display driver.
+ * Every test is run twice:
+ *		- on the TestStub display. As the driver does nothing this measures the GDISP core overhead
+ *			(clipping, algorithms, text decoding, image decoding etc).
+ *		- on a pixmap of the same size. This measures real rendering into RAM.
+ *
+ * A fixed pseudo random sequence is used so that every run draws exactly the same thing.
+ *
+ * The results are printed to stdout in CSV format (one line per display per test) so they can be
+ * easily compared between builds. The columns are...
+ *		display,test,calls,pixels,usec,calls_per_sec,pixels_per_sec
+ *
+ * Pixel counts for the non-rectangular primitives are the nominal area covered (eg PI*r*r for a
+ * filled circle) and not an exact count of the pixels written.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "gfx.h"
+
+// The number of calls made for each test. Increase this for more stable results on a noisy machine.
+#ifndef BENCH_CALLS
+	#define BENCH_CALLS		2000
+#endif
+
+// Image decoding is much slower than the other tests
+#ifndef BENCH_IMAGE_CALLS
+	#define BENCH_IMAGE_CALLS	100
+#endif
+
+static const char	BenchText[]	= "The quick brown fox jumps over the lazy dog 0123456789";
+static const char	BenchWrap[]	= "uGFX word wrap benchmark. This text is long enough that it must be wrapped "
+								  "across several lines of the string box before it can be completely displayed.";
+
+static coord_t		width, height;
+static font_t		font, fontaa;
+static pixel_t		*blitbuf;
+static uint32_t		seed;
+
+// A simple LCG so the sequence is identical on every host and C library
+static uint32_t brand(uint32_t range) {
+	seed = seed * 1103515245 + 12345;
+	return ((seed >> 8) & 0x00FFFFFF) % range;
+}
+
+static color_t bcolor(void) {
+	return RGB2COLOR(brand(256), brand(256), brand(256));
+}
+
+static uint64_t nowusec(void) {
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/*
+ * The tests.
+ * Each test performs one call and returns the number of pixels (nominally) drawn.
+ */
+
+static uint32_t t_fill(GDisplay *g) {
+	coord_t x, y, cx, cy;
+
+	x = brand(width-10);
+	y = brand(height-10);
+	cx = brand(width-x-10)+10;
+	cy = brand(height-y-10)+10;
+	gdispGFillArea(g, x, y, cx, cy, bcolor());
+	return (uint32_t)cx*cy;
+}
+
+static uint32_t t_clear(GDisplay *g) {
+	gdispGClear(g, bcolor());
+	return (uint32_t)width*height;
+}
+
+static uint32_t t_line(GDisplay *g) {
+	coord_t x0, y0, x1, y1, dx, dy;
+
+	x0 = brand(width);	y0 = brand(height);
+	x1 = brand(width);	y1 = brand(height);
+	gdispGDrawLine(g, x0, y0, x1, y1, bcolor());
+	dx = x1 > x0 ? x1-x0 : x0-x1;
+	dy = y1 > y0 ? y1-y0 : y0-y1;
+	return (dx > dy ? dx : dy) + 1;
+}
+
+static uint32_t t_hline(GDisplay *g) {
+	coord_t x0, x1, y;
+
+	x0 = brand(width);	x1 = brand(width);
+	y = brand(height);
+	gdispGDrawLine(g, x0, y, x1, y, bcolor());
+	return (x1 > x0 ? x1-x0 : x0-x1) + 1;
+}
+
+static uint32_t t_box(GDisplay *g) {
+	coord_t x, y, cx, cy;
+
+	x = brand(width-10);
+	y = brand(height-10);
+	cx = brand(width-x-10)+10;
+	cy = brand(height-y-10)+10;
+	gdispGDrawBox(g, x, y, cx, cy, bcolor());
+	return 2*((uint32_t)cx+cy);
+}
+
+static uint32_t t_circle(GDisplay *g) {
+	coord_t	r;
+
+	r = brand(height/2)+2;
+	gdispGDrawCircle(g, brand(width), brand(height), r, bcolor());
+	return (uint32_t)r*628/100;
+}
+
+static uint32_t t_fillcircle(GDisplay *g) {
+	coord_t	r;
+
+	r = brand(height/2)+2;
+	gdispGFillCircle(g, brand(width), brand(height), r, bcolor());
+	return (uint32_t)r*r*314/100;
+}
+
+static uint32_t t_arc(GDisplay *g) {
+	coord_t	r, a0, a1;
+
+	r = brand(height/2)+2;
+	a0 = brand(360);
+	a1 = a0 + brand(359) + 1;
+	gdispGDrawArc(g, brand(width), brand(height), r, a0, a1, bcolor());
+	return (uint32_t)r*628/100 * (a1-a0) / 360;
+}
+
+static uint32_t t_fillarc(GDisplay *g) {
+	coord_t	r, a0, a1;
+
+	r = brand(height/2)+2;
+	a0 = brand(360);
+	a1 = a0 + brand(359) + 1;
+	gdispGFillArc(g, brand(width), brand(height), r, a0, a1, bcolor());
+	return (uint32_t)r*r*314/100 * (a1-a0) / 360;
+}
+
+static uint32_t t_convexpoly(GDisplay *g) {
+	point		p[5];
+	coord_t		r, x, y;
+	int32_t		area;
+	unsigned	i;
+
+	// A random pentagon - always convex
+	static const int8_t	unit[5][2] = { {0,-100}, {95,-31}, {59,81}, {-59,81}, {-95,-31} };
+
+	r = brand(height/2)+4;
+	x = brand(width);
+	y = brand(height);
+	for(i = 0; i < 5; i++) {
+		p[i].x = unit[i][0] * r / 100;
+		p[i].y = unit[i][1] * r / 100;
+	}
+	gdispGFillConvexPoly(g, x, y, p, 5, bcolor());
+
+	// Shoelace formula
+	for(area = 0, i = 0; i < 5; i++)
+		area += (int32_t)p[i].x * p[(i+1)%5].y - (int32_t)p[(i+1)%5].x * p[i].y;
+	return (area < 0 ? -area : area) / 2;
+}
+
+static uint32_t t_text(GDisplay *g) {
+	gdispGDrawString(g, brand(width/2), brand(height-20), BenchText, font, bcolor());
+	return (uint32_t)gdispGetStringWidth(BenchText, font) * gdispGetFontMetric(font, fontHeight);
+}
+
+static uint32_t t_filltext(GDisplay *g) {
+	gdispGFillString(g, brand(width/2), brand(height-20), BenchText, font, bcolor(), bcolor());
+	return (uint32_t)gdispGetStringWidth(BenchText, font) * gdispGetFontMetric(font, fontHeight);
+}
+
+static uint32_t t_textaa(GDisplay *g) {
+	gdispGDrawString(g, brand(width/2), brand(height-20), BenchText, fontaa, bcolor());
+	return (uint32_t)gdispGetStringWidth(BenchText, fontaa) * gdispGetFontMetric(fontaa, fontHeight);
+}
+
+static uint32_t t_filltextaa(GDisplay *g) {
+	gdispGFillString(g, brand(width/2), brand(height-20), BenchText, fontaa, bcolor(), bcolor());
+	return (uint32_t)gdispGetStringWidth(BenchText, fontaa) * gdispGetFontMetric(fontaa, fontHeight);
+}
+
+static uint32_t t_wordwrap(GDisplay *g) {
+	gdispGFillStringBox(g, 0, 0, width/2, height/2, BenchWrap, font, bcolor(), bcolor(), justifyLeft);
+	return (uint32_t)(width/2) * (height/2);
+}
+
+static uint32_t t_blit(GDisplay *g) {
+	coord_t x, y, cx, cy;
+
+	x = brand(width-10);
+	y = brand(height-10);
+	cx = brand(width-x-10)+10;
+	cy = brand(height-y-10)+10;
+	gdispGBlitArea(g, x, y, cx, cy, 0, 0, width, blitbuf);
+	return (uint32_t)cx*cy;
+}
+
+static uint32_t t_scroll(GDisplay *g) {
+	gdispGVerticalScroll(g, 0, 0, width, height, (int)brand(20)+1, bcolor());
+	return (uint32_t)width*height;
+}
+
+static uint32_t drawimage(GDisplay *g, const char *fname) {
+	gdispImage	img;
+	uint32_t	pixels;
+
+	gdispImageInit(&img);
+	if (gdispImageOpenFile(&img, fname) != GDISP_IMAGE_ERR_OK)
+		return 0;
+	gdispGImageDraw(g, &img, 0, 0, img.width, img.height, 0, 0);
+	pixels = (uint32_t)img.width * img.height;
+	gdispImageClose(&img);
+	return pixels;
+}
+
+static uint32_t t_bmp(GDisplay *g) { return drawimage(g, "test-pal8.bmp"); }
+static uint32_t t_gif(GDisplay *g) { return drawimage(g, "romfs_img_ugfx.gif"); }
+static uint32_t t_png(GDisplay *g) { return drawimage(g, "bench_rgba.png"); }
+
+typedef struct benchtest {
+	const char	*name;
+	uint32_t	(*fn)(GDisplay *g);
+	unsigned	calls;
+} benchtest;
+
+static const benchtest BenchTests[] = {
+	{ "fill",			t_fill,			BENCH_CALLS },
+	{ "clear",			t_clear,		BENCH_CALLS/10 },
+	{ "line",			t_line,			BENCH_CALLS },
+	{ "hline",			t_hline,		BENCH_CALLS },
+	{ "box",			t_box,			BENCH_CALLS },
+	{ "circle",			t_circle,		BENCH_CALLS },
+	{ "fillcircle",		t_fillcircle,	BENCH_CALLS },
+	{ "arc",			t_arc,			BENCH_CALLS },
+	{ "fillarc",		t_fillarc,		BENCH_CALLS },
+	{ "convexpoly",		t_convexpoly,	BENCH_CALLS },
+	{ "text",			t_text,			BENCH_CALLS },
+	{ "filltext",		t_filltext,		BENCH_CALLS },
+	{ "text_aa",		t_textaa,		BENCH_CALLS },
+	{ "filltext_aa",	t_filltextaa,	BENCH_CALLS },
+	{ "wordwrap",		t_wordwrap,		BENCH_CALLS/10 },
+	{ "blit",			t_blit,			BENCH_CALLS },
+	{ "scroll",			t_scroll,		BENCH_CALLS/10 },
+	{ "image_bmp",		t_bmp,			BENCH_IMAGE_CALLS },
+	{ "image_gif",		t_gif,			BENCH_IMAGE_CALLS },
+	{ "image_png",		t_png,			BENCH_IMAGE_CALLS },
+};
+
+static void runtests(GDisplay *g, const char *dname) {
+	const benchtest	*t;
+	unsigned		i;
+	uint64_t		pixels, start, usec;
+
+	for(t = BenchTests; t < BenchTests+sizeof(BenchTests)/sizeof(BenchTests[0]); t++) {
+		// Every test on every display draws the same sequence
+		seed = 1;
+		gdispGClear(g, Black);
+
+		pixels = 0;
+		start = nowusec();
+		for(i = 0; i < t->calls; i++)
+			pixels += t->fn(g);
+		usec = nowusec() - start;
+		if (!usec)
+			usec = 1;
+
+		printf("%s,%s,%u,%llu,%llu,%llu,%llu\n", dname, t->name, t->calls,
+				(unsigned long long)pixels, (unsigned long long)usec,
+				(unsigned long long)t->calls * 1000000 / usec,
+				(unsigned long long)pixels * 1000000 / usec);
+		fflush(stdout);
+	}
+}
+
+int main(void) {
+	GDisplay	*pixmap;
+	coord_t		i, j;
+
+	gfxInit();
+
+	width = gdispGetWidth();
+	height = gdispGetHeight();
+	font = gdispOpenFont("DejaVuSans16");
+	fontaa = gdispOpenFont("DejaVuSans16_aa");
+
+	// The pixmap is the same size as the TestStub display
+	pixmap = gdispPixmapCreate(width, height);
+	if (!pixmap)
+		gfxHalt("Benchmark: Unable to create the pixmap");
+
+	// A screen sized source image for the blits
+	blitbuf = gfxAlloc((size_t)width * height * sizeof(pixel_t));
+	if (!blitbuf)
+		gfxHalt("Benchmark: Out of memory");
+	for(j = 0; j < height; j++)
+		for(i = 0; i < width; i++)
+			blitbuf[j*width + i] = RGB2COLOR(i*255/width, j*255/height, (i^j)&0xFF);
+
+	printf("display,test,calls,pixels,usec,calls_per_sec,pixels_per_sec\n");
+	runtests(GDISP, "teststub");
+	runtests(pixmap, "pixmap");
+
+	gfxFree(blitbuf);
+	gdispPixmapDelete(pixmap);
+	return 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * This file was generated from "bench_rgba.png" using...
+ *
+ *	file2c -dcs bench_rgba.png romfs_bench_rgba.h
+ *
+ */
+static const char bench_rgba[] = {
+	0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x60, 0x00, 0x00, 0x00, 0x40, 0x08, 0x06, 0x00, 0x00, 0x00, 0xE5, 0x34, 0x72,
+	0x0E, 0x00, 0x00, 0x0A, 0x9E, 0x49, 0x44, 0x41, 0x54, 0x78, 0xDA, 0xED, 0xDC, 0x01, 0x44, 0xA5,
+	0x6B, 0x83, 0x07, 0xF0, 0xEE, 0xDC, 0x1B, 0x89, 0x48, 0x6E, 0x8C, 0x6C, 0x24, 0x5A, 0xC9, 0x46,
+	0x2B, 0x11, 0x4D, 0x9C, 0x31, 0x22, 0x92, 0x8D, 0x44, 0x2B, 0x11, 0xB9, 0x69, 0x65, 0x13, 0xD1,
+	0x76, 0x65, 0x3B, 0xE7, 0x6C, 0x24, 0x32, 0x69, 0x45, 0x24, 0xE2, 0xC8, 0x46, 0x22, 0x12, 0xD1,
+	0x46, 0xE3, 0x88, 0xE8, 0x4A, 0x44, 0x22, 0xD2, 0x6A, 0x25, 0x22, 0xD1, 0x95, 0x88, 0x78, 0xF7,
+	0xD7, 0xF7, 0x35, 0xF7, 0xCE, 0x37, 0x53, 0xD3, 0xEC, 0x54, 0x33, 0x4D, 0xD3, 0xE1, 0x37, 0xF3,
+	0x38, 0xFD, 0x9F, 0xDE, 0xF3, 0x8A, 0xF9, 0xCF, 0xF3, 0xF4, 0xBE, 0x6F, 0x42, 0x42, 0x42, 0x28,
+	0xF2, 0x8C, 0x44, 0x92, 0x48, 0x26, 0x85, 0x54, 0xD2, 0x48, 0x4F, 0x08, 0x22, 0xCF, 0xC9, 0x20,
+	0x93, 0x2C, 0xB2, 0xC9, 0x21, 0x97, 0x3C, 0x99, 0x7C, 0x0A, 0x28, 0xA4, 0x88, 0x62, 0x4A, 0x28,
+	0x25, 0x24, 0xF3, 0x8A, 0x32, 0xCA, 0xA9, 0xA0, 0x92, 0x2A, 0xAA, 0xA9, 0x91, 0xA9, 0xA5, 0x8E,
+	0x7A, 0x1A, 0x68, 0xA4, 0x89, 0x66, 0x5A, 0x64, 0x5A, 0x69, 0xA3, 0x9D, 0x0E, 0x3A, 0xE9, 0xA2,
+	0x9B, 0x88, 0x4C, 0x0F, 0xBD, 0xF4, 0xD1, 0xCF, 0x00, 0x83, 0x0C, 0x31, 0x2C, 0x33, 0xC2, 0x28,
+	0x63, 0xC4, 0x18, 0x67, 0x82, 0x49, 0xA6, 0x64, 0xA6, 0x99, 0x61, 0x96, 0x39, 0xE6, 0x59, 0x60,
+	0x91, 0xB8, 0xCC, 0x12, 0xCB, 0xAC, 0xB0, 0xCA, 0x1A, 0xEB, 0x6C, 0xB0, 0x29, 0xB3, 0xC5, 0x36,
+	0x3B, 0xEC, 0xB2, 0xC7, 0x3E, 0x07, 0x1C, 0xCA, 0x1C, 0x71, 0xCC, 0x09, 0xA7, 0x9C, 0x71, 0x4E,
+	0xC0, 0x0F, 0x09, 0x3F, 0x5D, 0xFC, 0x00, 0x12, 0x12, 0x7E, 0xBC, 0xF4, 0xE1, 0xF8, 0xCD, 0x35,
+	0xEF, 0xBF, 0x1D, 0xBF, 0xFC, 0x63, 0x7C, 0xDB, 0xF9, 0xEF, 0xBE, 0x7F, 0xDB, 0xF9, 0x7F, 0x8E,
+	0x6F, 0x3F, 0xFF, 0xEA, 0xCF, 0xF5, 0x79, 0xF3, 0x3F, 0xFC, 0x5E, 0x3F, 0xF9, 0xF3, 0xC9, 0x57,
+	0xF3, 0x63, 0x42, 0x52, 0x56, 0xE8, 0x07, 0x3F, 0x96, 0x67, 0x97, 0x3E, 0x1C, 0x37, 0x5C, 0xF3,
+	0xFE, 0xDB, 0x71, 0xEC, 0x8F, 0xF1, 0x6D, 0xE7, 0xBF, 0xFB, 0xFE, 0x7B, 0xF3, 0xC3, 0xC6, 0xA1,
+	0x67, 0x97, 0xFE, 0x76, 0x1C, 0xBB, 0xE6, 0xFD, 0xB7, 0xE3, 0x86, 0xF8, 0xE7, 0x1C, 0xFF, 0xCF,
+	0x71, 0xC3, 0x35, 0x9F, 0xEB, 0xF3, 0xE6, 0xBF, 0xFF, 0xBD, 0x7E, 0xFA, 0xCB, 0x4F, 0xE2, 0x61,
+	0xBE, 0xC2, 0xF7, 0xF0, 0x7D, 0xA2, 0x0F, 0xEF, 0x34, 0x7F, 0xD6, 0x01, 0x24, 0x92, 0x44, 0x32,
+	0x29, 0xA4, 0x92, 0x46, 0xFA, 0xCF, 0x4A, 0x98, 0x0C, 0x32, 0xC9, 0x22, 0x9B, 0x1C, 0x72, 0xC9,
+	0x93, 0xC9, 0xA7, 0x80, 0x42, 0x8A, 0x28, 0xA6, 0x84, 0x52, 0x42, 0x32, 0xAF, 0x28, 0xA3, 0x9C,
+	0x0A, 0x2A, 0xA9, 0xA2, 0x9A, 0x1A, 0x99, 0x5A, 0xEA, 0xA8, 0xFF, 0x39, 0x14, 0x34, 0xD0, 0x48,
+	0x13, 0xCD, 0xB4, 0xFC, 0x1C, 0x04, 0xAD, 0xB4, 0xD1, 0x4E, 0x07, 0x9D, 0x74, 0xD1, 0x4D, 0x44,
+	0xA6, 0x87, 0x5E, 0xFA, 0xE8, 0x67, 0x80, 0x41, 0x86, 0x18, 0x96, 0x19, 0x61, 0x94, 0x31, 0x62,
+	0x8C, 0x33, 0xE1, 0xD8, 0x93, 0x4C, 0x39, 0xEE, 0x34, 0x33, 0xCC, 0x32, 0xC7, 0x3C, 0x0B, 0x2C,
+	0x12, 0x97, 0x59, 0x62, 0x99, 0x15, 0x56, 0x59, 0x63, 0x9D, 0x0D, 0x36, 0x65, 0xB6, 0xD8, 0x66,
+	0x87, 0x5D, 0xF6, 0xD8, 0xE7, 0x80, 0x43, 0x99, 0x23, 0x8E, 0x39, 0xE1, 0x94, 0x33, 0xCE, 0x09,
+	0x7E, 0xBE, 0x28, 0xE1, 0xE7, 0x0F, 0xA6, 0x84, 0xC3, 0x5F, 0xA1, 0x84, 0xA3, 0x4F, 0x25, 0xFC,
+	0x93, 0x7F, 0x22, 0xFE, 0xEA, 0x7B, 0x3B, 0xF6, 0x65, 0x09, 0xA7, 0xFD, 0x8F, 0xC2, 0x6A, 0xB8,
+	0x2C, 0xBB, 0x8B, 0xC2, 0x78, 0x7F, 0xFC, 0x92, 0xD8, 0x65, 0xD9, 0xC4, 0xAE, 0x18, 0xBF, 0xF9,
+	0x23, 0xFF, 0x19, 0xF3, 0xC3, 0xEF, 0xCE, 0x7F, 0x77, 0xEE, 0xE7, 0x1C, 0xFF, 0xEA, 0xF3, 0xF8,
+	0xA4, 0xF9, 0x7F, 0x29, 0xEB, 0xEB, 0xE6, 0xBF, 0x9B, 0xFF, 0x9C, 0xE3, 0x5F, 0x77, 0xEC, 0x0B,
+	0x5F, 0xAB, 0x84, 0xC3, 0x0F, 0xB8, 0xF4, 0xBF, 0x70, 0x51, 0xE7, 0x06, 0x91, 0x67, 0x24, 0x92,
+	0x44, 0x32, 0x29, 0xA4, 0x92, 0x46, 0x7A, 0x6E, 0x28, 0xF2, 0x9C, 0x0C, 0x32, 0xC9, 0x22, 0x9B,
+	0x1C, 0x72, 0xC9, 0x93, 0xC9, 0xA7, 0x80, 0x42, 0x8A, 0x28, 0xA6, 0x84, 0x52, 0x42, 0x32, 0xAF,
+	0x28, 0xA3, 0x9C, 0x8A, 0xDC, 0x50, 0x50, 0x49, 0x15, 0xD5, 0xD4, 0xE4, 0x06, 0x41, 0x2D, 0x75,
+	0xD4, 0xD3, 0x40, 0x23, 0x4D, 0x34, 0xD3, 0x22, 0xD3, 0x4A, 0x1B, 0xED, 0x74, 0xD0, 0x49, 0x17,
+	0xDD, 0x44, 0x64, 0x7A, 0xE8, 0xA5, 0x8F, 0x7E, 0x06, 0x18, 0x64, 0x88, 0x61, 0x99, 0x11, 0x46,
+	0x19, 0x23, 0xC6, 0x38, 0x13, 0x4C, 0x32, 0x25, 0x33, 0xCD, 0x0C, 0xB3, 0xCC, 0x31, 0xEF, 0x73,
+	0x2F, 0xB0, 0x48, 0xDC, 0x67, 0x5E, 0x62, 0x99, 0x15, 0x56, 0x59, 0x63, 0x9D, 0x0D, 0x36, 0x65,
+	0xB6, 0xD8, 0x66, 0x87, 0x5D, 0xF6, 0xD8, 0xE7, 0x80, 0x43, 0x99, 0x23, 0x8E, 0x39, 0xE1, 0x94,
+	0x33, 0xCE, 0x09, 0xF8, 0x21, 0xE1, 0x1F, 0x82, 0x1B, 0x4A, 0xF8, 0xE5, 0x0D, 0x25, 0xF8, 0xE6,
+	0x86, 0x12, 0xFE, 0x9B, 0xF9, 0xE1, 0x8F, 0xCD, 0xBF, 0xBA, 0xEC, 0x3E, 0xFD, 0xF8, 0x57, 0x67,
+	0x3E, 0x7B, 0x7E, 0xF4, 0xED, 0xFC, 0x8F, 0x97, 0xF0, 0xCD, 0xC7, 0x7F, 0x28, 0x25, 0x1C, 0xFE,
+	0xC6, 0x56, 0xA9, 0xE1, 0x2F, 0x53, 0xC2, 0x7F, 0x17, 0xB9, 0x61, 0x25, 0x1C, 0xBB, 0x61, 0x25,
+	0xDB, 0x70, 0xC3, 0x4A, 0x38, 0xF6, 0x76, 0x25, 0x7B, 0xE3, 0xFC, 0xAB, 0x57, 0x9C, 0x9F, 0x7E,
+	0xFC, 0xAB, 0x33, 0xB7, 0x9A, 0xAF, 0x9C, 0x63, 0xF1, 0x8F, 0xAF, 0x84, 0x6F, 0x3E, 0xFE, 0xB7,
+	0xBA, 0x12, 0xFE, 0x4E, 0x5E, 0x2F, 0x74, 0x00, 0x89, 0x24, 0x91, 0x4C, 0x0A, 0xA9, 0xA4, 0x91,
+	0xFE, 0x42, 0x09, 0x93, 0x41, 0x26, 0x59, 0x64, 0x93, 0x43, 0x2E, 0x79, 0x32, 0xF9, 0x14, 0x50,
+	0x48, 0x11, 0xC5, 0x94, 0x50, 0x4A, 0xE8, 0x45, 0x28, 0x78, 0x45, 0x19, 0xE5, 0x54, 0x50, 0x49,
+	0x15, 0xD5, 0xD4, 0xBC, 0x50, 0xC2, 0xD4, 0x51, 0x4F, 0x03, 0x8D, 0x34, 0xD1, 0x4C, 0x8B, 0x4C,
+	0x2B, 0x6D, 0xB4, 0xD3, 0x41, 0x27, 0x5D, 0x74, 0x13, 0x91, 0xE9, 0xA1, 0x97, 0x3E, 0xFA, 0x19,
+	0x60, 0x90, 0x21, 0x86, 0x65, 0x46, 0x18, 0x65, 0x8C, 0x18, 0xE3, 0x4C, 0x30, 0xC9, 0x94, 0xCC,
+	0x34, 0x33, 0xCC, 0x32, 0xC7, 0x3C, 0x0B, 0x2C, 0x12, 0x97, 0x59, 0x72, 0x9E, 0xCB, 0xAC, 0xB0,
+	0xCA, 0x1A, 0xEB, 0x6C, 0xB0, 0xE9, 0x1C, 0xB7, 0xD8, 0x66, 0x87, 0x5D, 0xF6, 0xD8, 0xE7, 0x80,
+	0x43, 0x99, 0x23, 0x8E, 0x39, 0xE1, 0x94, 0x33, 0xCE, 0x09, 0x5E, 0x5C, 0x94, 0x70, 0xE8, 0x5E,
+	0x57, 0xC2, 0xE1, 0x47, 0xB4, 0x1D, 0x1D, 0x7D, 0xDA, 0x8E, 0x7E, 0x94, 0xDB, 0xD1, 0x7F, 0x7F,
+	0x6F, 0xDB, 0xD1, 0xE1, 0x3B, 0xDC, 0x8E, 0xBE, 0xD5, 0x76, 0xF2, 0x1D, 0x6D, 0x47, 0x5F, 0x6C,
+	0x6F, 0xC7, 0xBF, 0x95, 0xED, 0xE8, 0xF0, 0x23, 0x6D, 0xCC, 0xF0, 0xDD, 0xAF, 0x94, 0xAB, 0x74,
+	0x00, 0x89, 0x24, 0x91, 0x4C, 0x0A, 0xA9, 0xA4, 0x91, 0x5E, 0x15, 0x44, 0x9E, 0x93, 0x41, 0x26,
+	0x59, 0x64, 0x93, 0x43, 0x2E, 0x79, 0x32, 0xF9, 0x14, 0x50, 0x48, 0x11, 0xC5, 0x55, 0xA1, 0xA0,
+	0x84, 0x52, 0x42, 0x55, 0x41, 0xF0, 0x8A, 0x32, 0xCA, 0xA9, 0xA0, 0x92, 0x2A, 0xAA, 0xA9, 0x91,
+	0xA9, 0xA5, 0x8E, 0x7A, 0x1A, 0x68, 0xA4, 0x89, 0x66, 0x5A, 0x64, 0x5A, 0x69, 0xA3, 0x9D, 0x0E,
+	0x3A, 0xE9, 0xA2, 0x9B, 0x88, 0x4C, 0x0F, 0xBD, 0xF4, 0xD1, 0xCF, 0x00, 0x83, 0x0C, 0x31, 0x2C,
+	0x33, 0xC2, 0x28, 0x63, 0xC4, 0x18, 0x67, 0x82, 0x49, 0xA6, 0x64, 0xA6, 0x99, 0x61, 0x96, 0x39,
+	0xE6, 0x59, 0x60, 0x91, 0xB8, 0xCC, 0x12, 0xCB, 0xAC, 0xB0, 0xEA, 0x9C, 0xD7, 0x58, 0x67, 0x83,
+	0x4D, 0xE7, 0xBB, 0xC5, 0x36, 0x3B, 0xEC, 0xB2, 0xC7, 0x3E, 0x07, 0x1C, 0xCA, 0x1C, 0x71, 0xCC,
+	0x09, 0xA7, 0x9C, 0x71, 0x4E, 0x50, 0x75, 0xB1, 0x1D, 0x5D, 0x73, 0x2F, 0x25, 0x1C, 0x7E, 0xC4,
+	0xBF, 0x13, 0x8E, 0x3E, 0xF4, 0x12, 0x0E, 0x3F, 0xF2, 0xE2, 0x0C, 0xDF, 0x6D, 0x09, 0xFF, 0xE3,
+	0x9D, 0x97, 0x70, 0xE8, 0x1E, 0x7E, 0x27, 0xFC, 0x10, 0x4A, 0xF8, 0xDD, 0xAF, 0xC5, 0xEF, 0xB0,
+	0x84, 0xDF, 0xDC, 0x50, 0x12, 0x2F, 0x6F, 0xF8, 0xFA, 0xD3, 0xFC, 0xDB, 0xCD, 0xFF, 0xC5, 0x4A,
+	0x98, 0x44, 0x92, 0x48, 0x26, 0x85, 0x54, 0xD2, 0x48, 0xFF, 0xC5, 0x4A, 0x98, 0x0C, 0x32, 0xC9,
+	0x22, 0x9B, 0x1C, 0x72, 0xC9, 0x93, 0xC9, 0xA7, 0x80, 0xC2, 0x5F, 0x82, 0xA0, 0x88, 0x62, 0x4A,
+	0x28, 0x25, 0xF4, 0x8B, 0x95, 0x30, 0x65, 0x94, 0x53, 0x41, 0x25, 0x55, 0x54, 0x53, 0x23, 0x53,
+	0x4B, 0x1D, 0xF5, 0x34, 0xD0, 0x48, 0x13, 0xCD, 0xB4, 0xC8, 0xB4, 0xD2, 0x46, 0x3B, 0x1D, 0x74,
+	0xD2, 0x45, 0x37, 0x11, 0x99, 0x1E, 0x7A, 0xE9, 0xA3, 0x9F, 0x01, 0x06, 0x19, 0x62, 0x58, 0x66,
+	0x84, 0x51, 0xC6, 0x88, 0x31, 0xCE, 0x04, 0x93, 0x4C, 0xC9, 0x4C, 0x33, 0xC3, 0x2C, 0x73, 0xCC,
+	0xB3, 0xC0, 0x22, 0x71, 0x99, 0x25, 0x96, 0x59, 0x61, 0x95, 0x35, 0xD6, 0x9D, 0xFB, 0x06, 0x9B,
+	0xCE, 0x7B, 0x8B, 0x6D, 0x76, 0xD8, 0x65, 0x8F, 0x7D, 0x0E, 0x38, 0x94, 0x39, 0xE2, 0x98, 0x13,
+	0x4E, 0x39, 0xE3, 0x9C, 0xE0, 0x97, 0x8B, 0x95, 0xF0, 0xBF, 0xDC, 0xE9, 0x76, 0x74, 0xF8, 0x36,
+	0xF3, 0x1F, 0xD8, 0x76, 0x74, 0xC2, 0x0D, 0xDB, 0xD1, 0xD1, 0x6F, 0x6D, 0x3B, 0xFA, 0xC9, 0x95,
+	0x25, 0x5C, 0x72, 0xA7, 0xDB, 0xD1, 0xA1, 0x1F, 0xEE, 0x68, 0x3B, 0xF9, 0x81, 0x6C, 0x47, 0x7F,
+	0xB0, 0x9D, 0xFC, 0xCE, 0xD7, 0xE2, 0x4F, 0xDB, 0xD1, 0x8F, 0xE2, 0xF5, 0xAB, 0x0E, 0x20, 0x91,
+	0x24, 0x92, 0x49, 0x21, 0x95, 0x34, 0xD2, 0x7F, 0x55, 0xC2, 0x64, 0x90, 0x49, 0x16, 0xD9, 0xE4,
+	0x90, 0x4B, 0x9E, 0x4C, 0x3E, 0x05, 0x14, 0xFE, 0xAA, 0x84, 0x29, 0xA6, 0x84, 0x52, 0x42, 0xBF,
+	0x2A, 0x61, 0xCA, 0x28, 0xA7, 0x82, 0x4A, 0xAA, 0xA8, 0xA6, 0x46, 0xA6, 0x96, 0x3A, 0xEA, 0x69,
+	0xA0, 0x91, 0x26, 0x9A, 0x69, 0x91, 0x69, 0xA5, 0x8D, 0x76, 0x3A, 0xE8, 0xA4, 0x8B, 0x6E, 0x22,
+	0x32, 0x3D, 0xF4, 0xD2, 0x47, 0x3F, 0x03, 0x0C, 0x32, 0xC4, 0xB0, 0xCC, 0x08, 0xA3, 0x8C, 0x11,
+	0x63, 0x9C, 0x09, 0x26, 0x99, 0x92, 0x99, 0x66, 0x86, 0x59, 0xE6, 0x98, 0x67, 0x81, 0x45, 0xE2,
+	0x32, 0x4B, 0x2C, 0xB3, 0xC2, 0x2A, 0x6B, 0xAC, 0x3B, 0xF7, 0x0D, 0x36, 0x9D, 0xF7, 0x16, 0xDB,
+	0xEC, 0xB0, 0xCB, 0x1E, 0xFB, 0x1C, 0x70, 0x28, 0x73, 0xC4, 0x31, 0x27, 0x9C, 0x72, 0xC6, 0x39,
+	0xC1, 0xAF, 0x17, 0x25, 0xFC, 0xEF, 0x4F, 0x25, 0xFC, 0x95, 0x4B, 0xD8, 0xFF, 0x53, 0x3F, 0xEA,
+	0xCD, 0x0D, 0x9E, 0xE6, 0xDF, 0x66, 0xFE, 0x8F, 0x09, 0x65, 0x77, 0xBA, 0x12, 0x0E, 0xDD, 0xD3,
+	0xD5, 0xD1, 0x0F, 0x6D, 0x25, 0xFC, 0x4E, 0x09, 0x3F, 0xDE, 0xAB, 0xA3, 0xBF, 0x93, 0xD7, 0xEB,
+	0x50, 0xE4, 0x19, 0x89, 0x24, 0x91, 0x4C, 0x0A, 0xA9, 0xA4, 0x91, 0xFE, 0x3A, 0x88, 0x3C, 0x27,
+	0x83, 0x4C, 0xB2, 0xC8, 0x26, 0x87, 0x5C, 0xF2, 0x64, 0xF2, 0x29, 0xA0, 0xF0, 0x75, 0x28, 0x28,
+	0xA2, 0x98, 0x12, 0x4A, 0x09, 0xBD, 0x0E, 0x82, 0x57, 0x94, 0x51, 0x4E, 0x05, 0x95, 0x54, 0x51,
+	0x4D, 0x8D, 0x4C, 0x2D, 0x75, 0xD4, 0xD3, 0x40, 0x23, 0x4D, 0x34, 0xD3, 0x22, 0xD3, 0x4A, 0x1B,
+	0xED, 0x74, 0xD0, 0x49, 0x17, 0xDD, 0x44, 0x64, 0x7A, 0xE8, 0xA5, 0x8F, 0x7E, 0x06, 0x18, 0x64,
+	0x88, 0x61, 0x99, 0x11, 0x46, 0x19, 0x23, 0xC6, 0x38, 0x13, 0x4C, 0x32, 0x25, 0x33, 0xCD, 0x0C,
+	0xB3, 0xCC, 0x31, 0xCF, 0x02, 0x8B, 0xC4, 0x65, 0x96, 0x58, 0x66, 0x85, 0x55, 0xD6, 0x58, 0x77,
+	0xEE, 0x1B, 0x6C, 0x3A, 0xEF, 0x2D, 0xB6, 0xD9, 0x61, 0x97, 0x3D, 0xF6, 0x39, 0xE0, 0x50, 0xE6,
+	0x88, 0x63, 0x4E, 0x38, 0xE5, 0x8C, 0x73, 0x82, 0xD7, 0x17, 0xDB, 0xD1, 0xFF, 0x79, 0xA7, 0xDB,
+	0xD1, 0xE1, 0xEF, 0xE8, 0x16, 0xA5, 0xE8, 0xD3, 0xEF, 0x84, 0x1F, 0xC5, 0x4A, 0xF8, 0x9F, 0x9E,
+	0x4A, 0xF8, 0xA9, 0x84, 0xBF, 0xEB, 0x57, 0xCC, 0x42, 0x8C, 0x44, 0x92, 0x48, 0x26, 0x85, 0x54,
+	0xD2, 0x48, 0x8F, 0x59, 0x09, 0x93, 0x41, 0x26, 0x59, 0x64, 0x93, 0x43, 0x2E, 0x79, 0x32, 0xF9,
+	0x14, 0x50, 0x48, 0x51, 0xCC, 0x4A, 0x98, 0x12, 0x4A, 0x09, 0xC5, 0xAC, 0x84, 0x29, 0xA3, 0x9C,
+	0x0A, 0x2A, 0xA9, 0xA2, 0x9A, 0x1A, 0x99, 0x5A, 0xEA, 0xA8, 0xA7, 0x81, 0x46, 0x9A, 0x68, 0xA6,
+	0x45, 0xA6, 0x95, 0x36, 0xDA, 0xE9, 0xA0, 0x93, 0x2E, 0xBA, 0x89, 0xC8, 0xF4, 0xD0, 0x4B, 0x1F,
+	0xFD, 0x0C, 0x30, 0xC8, 0x10, 0xC3, 0x32, 0x23, 0x8C, 0x32, 0x46, 0x8C, 0x71, 0x26, 0x98, 0x64,
+	0x4A, 0x66, 0x9A, 0x19, 0x66, 0x99, 0x63, 0x9E, 0x05, 0x16, 0x89, 0xCB, 0x2C, 0xB1, 0xCC, 0x0A,
+	0xAB, 0xAC, 0x39, 0xEF, 0x75, 0x36, 0xD8, 0x74, 0xCE, 0x5B, 0x6C, 0xB3, 0xC3, 0x2E, 0x7B, 0xEC,
+	0x73, 0xC0, 0xA1, 0xCC, 0x11, 0xC7, 0x9C, 0x70, 0xCA, 0x19, 0xE7, 0x04, 0xB1, 0x8B, 0x95, 0xF0,
+	0x7F, 0xDD, 0xF9, 0xD5, 0xD1, 0xE1, 0xEF, 0x60, 0x25, 0x1C, 0xBD, 0xBB, 0xAB, 0xA3, 0x13, 0xFD,
+	0xF9, 0xE4, 0xAB, 0xF9, 0x31, 0xE1, 0x9F, 0xEF, 0xFC, 0xEA, 0xE8, 0xF8, 0xE5, 0x45, 0x4C, 0x8F,
+	0x75, 0x3B, 0x3A, 0xFA, 0x74, 0x75, 0xF4, 0xA3, 0x7A, 0xCD, 0xE9, 0x00, 0x12, 0x49, 0x22, 0x99,
+	0x14, 0x52, 0x49, 0x23, 0x7D, 0x4E, 0x09, 0x93, 0x41, 0x26, 0x59, 0x64, 0x93, 0x43, 0x2E, 0x79,
+	0x32, 0xF9, 0x14, 0x50, 0x48, 0x11, 0xC5, 0x73, 0x4A, 0x98, 0x52, 0x42, 0x73, 0x4A, 0x98, 0x32,
+	0xCA, 0xA9, 0xA0, 0x92, 0x2A, 0xAA, 0xA9, 0x91, 0xA9, 0xA5, 0x8E, 0x7A, 0x1A, 0x68, 0xA4, 0x89,
+	0x66, 0x5A, 0x64, 0x5A, 0x69, 0xA3, 0x9D, 0x0E, 0x3A, 0xE9, 0xA2, 0x9B, 0x88, 0x4C, 0x0F, 0xBD,
+	0xF4, 0xD1, 0xCF, 0x00, 0x83, 0x0C, 0x31, 0x2C, 0x33, 0xC2, 0x28, 0x63, 0xC4, 0x18, 0x67, 0x82,
+	0x49, 0xA6, 0x64, 0xA6, 0x99, 0x61, 0x96, 0x39, 0xE6, 0x59, 0x60, 0x91, 0xB8, 0xCC, 0x12, 0xCB,
+	0xAC, 0xB0, 0xEA, 0x9C, 0xD7, 0x58, 0x67, 0x83, 0x4D, 0xE7, 0xBB, 0xC5, 0x36, 0x3B, 0xEC, 0xB2,
+	0xC7, 0x3E, 0x07, 0x1C, 0xCA, 0x1C, 0x71, 0xCC, 0x09, 0xA7, 0x9C, 0x71, 0x4E, 0x30, 0x77, 0x51,
+	0xC2, 0xFF, 0x7D, 0x6F, 0xB7, 0x28, 0x85, 0x1F, 0x61, 0x09, 0x47, 0xBF, 0xA5, 0x5B, 0x94, 0xA2,
+	0x8F, 0x6C, 0xD5, 0x1A, 0xBD, 0x9F, 0x95, 0x70, 0x63, 0x3C, 0x74, 0xFD, 0x3D, 0xB4, 0x17, 0x7F,
+	0xBF, 0xF9, 0xC8, 0x3D, 0xB0, 0x17, 0xE3, 0x97, 0x1F, 0xB9, 0x87, 0xF6, 0xE2, 0x41, 0x1A, 0x9F,
+	0x3E, 0xFF, 0xEA, 0xFB, 0x71, 0x3F, 0x6F, 0xFE, 0x9F, 0xE3, 0xDB, 0xCF, 0xBF, 0xCC, 0xC7, 0x6F,
+	0x39, 0xFF, 0xCA, 0x7B, 0xA1, 0xEF, 0xBB, 0x84, 0xA3, 0x8F, 0xE4, 0x4A, 0xE9, 0x7B, 0xBC, 0x77,
+	0xF8, 0xB7, 0x50, 0xE4, 0x19, 0x89, 0x24, 0x91, 0x4C, 0x0A, 0xA9, 0xA4, 0x91, 0xFE, 0x5B, 0x10,
+	0x79, 0x4E, 0x06, 0x99, 0x64, 0x91, 0x4D, 0x0E, 0xB9, 0xE4, 0xC9, 0xE4, 0x53, 0x40, 0x21, 0x45,
+	0x14, 0x53, 0x42, 0x29, 0x21, 0x99, 0x57, 0xBF, 0x05, 0x41, 0x19, 0xE5, 0x54, 0x50, 0x49, 0x15,
+	0xD5, 0xD4, 0xFC, 0x16, 0x0A, 0x6A, 0xA9, 0xA3, 0x9E, 0x06, 0x1A, 0x69, 0xA2, 0x99, 0x16, 0x99,
+	0x56, 0xDA, 0x68, 0xA7, 0x83, 0x4E, 0xBA, 0xE8, 0x26, 0x22, 0xD3, 0x43, 0x2F, 0x7D, 0xF4, 0x33,
+	0xC0, 0x20, 0x43, 0x0C, 0xCB, 0x8C, 0x30, 0xCA, 0x18, 0x31, 0xC6, 0x99, 0x60, 0x92, 0x29, 0x99,
+	0x69, 0x66, 0x98, 0x65, 0x8E, 0x79, 0x16, 0x58, 0x24, 0xEE, 0xF3, 0x2F, 0xB1, 0xCC, 0x0A, 0xAB,
+	0xAC, 0xB1, 0xCE, 0x06, 0x9B, 0xCE, 0x71, 0x8B, 0x6D, 0x76, 0xD8, 0x65, 0x8F, 0x7D, 0x0E, 0x38,
+	0x94, 0x39, 0xE2, 0x98, 0x13, 0x4E, 0x39, 0xE3, 0x9C, 0xE0, 0xB7, 0x8B, 0xED, 0xE8, 0xB5, 0x2F,
+	0xF2, 0xB0, 0x8E, 0xF0, 0x37, 0xBC, 0x1D, 0x1D, 0x7D, 0x0C, 0x0F, 0xEB, 0x88, 0x3E, 0x15, 0xEF,
+	0x75, 0x25, 0xFC, 0xAF, 0x5F, 0xEC, 0x89, 0x59, 0xEF, 0xAD, 0x90, 0x1F, 0xFC, 0x76, 0x74, 0xF4,
+	0x31, 0x3E, 0x31, 0xEB, 0x5B, 0x29, 0xE5, 0x2F, 0xF8, 0xC0, 0x8E, 0x1D, 0x1D, 0x40, 0x22, 0x49,
+	0x24, 0x93, 0x42, 0x2A, 0x69, 0xA4, 0xEF, 0x28, 0x61, 0x32, 0xC8, 0x24, 0x8B, 0x6C, 0x72, 0xC8,
+	0x25, 0x4F, 0x26, 0x9F, 0x02, 0x0A, 0x29, 0xA2, 0x98, 0x12, 0x4A, 0x09, 0xC9, 0xBC, 0xA2, 0x8C,
+	0x72, 0x2A, 0xA8, 0xDC, 0x51, 0xC2, 0x54, 0x53, 0xB3, 0xA3, 0x84, 0xA9, 0xA3, 0x9E, 0x06, 0x1A,
+	0x69, 0xA2, 0x99, 0x16, 0x99, 0x56, 0xDA, 0x68, 0xA7, 0x83, 0x4E, 0xBA, 0xE8, 0x26, 0x22, 0xD3,
+	0x43, 0x2F, 0x7D, 0xF4, 0x33, 0xC0, 0x20, 0x43, 0x0C, 0xCB, 0x8C, 0x30, 0xCA, 0x18, 0x31, 0xC6,
+	0x99, 0x60, 0x92, 0x29, 0x99, 0x69, 0x66, 0x98, 0x65, 0xCE, 0x67, 0x9E, 0x67, 0x81, 0x45, 0xE2,
+	0x3E, 0xEF, 0x12, 0xCB, 0xAC, 0xB0, 0xCA, 0x1A, 0xEB, 0x6C, 0xB0, 0x29, 0xB3, 0xC5, 0x36, 0x3B,
+	0xEC, 0xB2, 0xC7, 0x3E, 0x07, 0x1C, 0xCA, 0x1C, 0x71, 0xCC, 0x09, 0xA7, 0x9C, 0x71, 0x4E, 0xB0,
+	0x73, 0x51, 0xC2, 0xFF, 0xFB, 0x45, 0x1F, 0xD6, 0x71, 0xC5, 0x6A, 0xF9, 0xC1, 0xAC, 0x84, 0xA3,
+	0xFF, 0xCF, 0x0B, 0xB3, 0x12, 0x1E, 0xC3, 0xD5, 0xD1, 0xD1, 0xEF, 0xA5, 0x6C, 0xAF, 0x2F, 0xE1,
+	0x7F, 0xFB, 0x22, 0x0F, 0xEB, 0xF8, 0xD8, 0xFC, 0xF8, 0xE5, 0xEF, 0x57, 0x43, 0x5F, 0x61, 0x3B,
+	0x3A, 0x7A, 0x79, 0xFC, 0xCF, 0xB9, 0x3A, 0xFA, 0xD1, 0x6D, 0x47, 0x7F, 0xE9, 0x82, 0x7E, 0x20,
+	0x8F, 0xB0, 0xFC, 0x5D, 0x07, 0x90, 0x48, 0x12, 0xC9, 0xA4, 0x90, 0x4A, 0x1A, 0xE9, 0xBF, 0x87,
+	0x22, 0xCF, 0xC9, 0x20, 0x93, 0x2C, 0xB2, 0xC9, 0x21, 0x97, 0x3C, 0x99, 0x7C, 0x0A, 0x28, 0xA4,
+	0x88, 0x62, 0x4A, 0x28, 0x25, 0x24, 0xF3, 0x8A, 0x32, 0xCA, 0xA9, 0xA0, 0x92, 0x2A, 0xAA, 0xA9,
+	0x91, 0xA9, 0xA5, 0x8E, 0x7A, 0x1A, 0x68, 0xA4, 0xE9, 0xF7, 0x20, 0x68, 0xA6, 0xE5, 0xF7, 0x50,
+	0xD0, 0x4A, 0x1B, 0xED, 0x74, 0xD0, 0x49, 0x17, 0xDD, 0x44, 0x64, 0x7A, 0xE8, 0xA5, 0x8F, 0x7E,
+	0x06, 0x18, 0x64, 0x88, 0x61, 0x99, 0x11, 0x46, 0x19, 0x73, 0xBC, 0x18, 0xE3, 0x4C, 0x30, 0xC9,
+	0x94, 0x63, 0x4D, 0x33, 0xC3, 0x2C, 0x73, 0xCC, 0xB3, 0xC0, 0x22, 0x71, 0x99, 0x25, 0x96, 0x59,
+	0x61, 0x95, 0x35, 0xD6, 0xD9, 0x60, 0x53, 0x66, 0x8B, 0x6D, 0x76, 0xD8, 0x65, 0x8F, 0x7D, 0x0E,
+	0x38, 0x94, 0x39, 0xE2, 0x98, 0x13, 0x4E, 0x39, 0xE3, 0x9C, 0xE0, 0xF7, 0x8B, 0xED, 0xE8, 0xD3,
+	0xAF, 0x5A, 0xC2, 0x9F, 0xBA, 0x1D, 0x1D, 0xBE, 0x45, 0x09, 0x47, 0xEF, 0xE9, 0xEA, 0xE8, 0x84,
+	0xEF, 0xE9, 0x16, 0xA5, 0xE8, 0x2D, 0x3C, 0xF0, 0x0B, 0xB3, 0xFE, 0x43, 0x09, 0xFB, 0x51, 0x3C,
+	0xBB, 0xF4, 0xE1, 0x38, 0x76, 0xCD, 0xFB, 0x6F, 0xC7, 0x0D, 0x7F, 0x8C, 0x6F, 0x3B, 0xFF, 0xDD,
+	0xF7, 0x6F, 0x3B, 0xFF, 0xCF, 0xF1, 0xED, 0xE7, 0x5F, 0xFD, 0xB9, 0x3E, 0x6F, 0xFE, 0xFB, 0xDF,
+	0xEB, 0xFF, 0x00, 0x04, 0xDD, 0xF2, 0x75, 0x4F, 0x8A, 0x54, 0xF6, 0x00, 0x00, 0x00, 0x00, 0x49,
+	0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
+};
+
+#ifdef ROMFS_DIRENTRY_HEAD
+	static const ROMFS_DIRENTRY bench_rgba_dir = { 0, 0, ROMFS_DIRENTRY_HEAD, "bench_rgba.png", 2775, bench_rgba };
+	#undef ROMFS_DIRENTRY_HEAD
+	#define ROMFS_DIRENTRY_HEAD &bench_rgba_dir
+#endif
@@ -0,0 +1,10 @@
+/**
+ * This file contains the list of files for the ROMFS.
+ *
+ * The BMP and GIF images are shared with other demos.
+ * The PNG image has been converted using...
+ * 		file2c -dcs bench_rgba.png romfs_bench_rgba.h
+ */
+#include "../../modules/gdisp/images/romfs_testpal8.h"
+#include "../../modules/gwin/widgets/romfs_img_ugfx.h"
+#include "romfs_bench_rgba.h"
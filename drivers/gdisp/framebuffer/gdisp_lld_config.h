@@ -16,6 +16,8 @@
 
 #define GDISP_HARDWARE_DRAWPIXEL		TRUE
 #define GDISP_HARDWARE_PIXELREAD		TRUE
+#define GDISP_HARDWARE_FILLS			TRUE
+#define GDISP_HARDWARE_BITFILLS			TRUE
 #define GDISP_HARDWARE_CONTROL			TRUE
 
 // Any other support comes from the board file
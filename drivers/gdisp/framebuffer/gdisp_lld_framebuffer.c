@@ -9,6 +9,8 @@
 
 #if GFX_USE_GDISP
 
+#include <string.h>
+
 #define GDISP_DRIVER_VMT			GDISPVMT_framebuffer
 #include "gdisp_lld_config.h"
 #include "../../../src/gdisp/gdisp_driver.h"
@@ -16,6 +18,10 @@
 typedef struct fbInfo {
 	void *			pixels;			// The pixel buffer
 	coord_t			linelen;		// The number of bytes per display line
+	#if GDISP_HARDWARE_FLUSH
+		coord_t		dx0, dy0;		// The frame buffer area changed since the last flush.
+		coord_t		dx1, dy1;		//	dx1 and dy1 are exclusive. dx1 is 0 when nothing has changed.
+	#endif
 	} fbInfo;
 
 #include "board_framebuffer.h"
@@ -31,6 +37,83 @@ typedef struct fbPriv {
 #define PIXIL_POS(g, x, y)		((y) * ((fbPriv *)(g)->priv)->fbi.linelen + (x) * sizeof(LLDCOLOR_TYPE))
 #define PIXEL_ADDR(g, pos)		((LLDCOLOR_TYPE *)(((char *)((fbPriv *)(g)->priv)->fbi.pixels)+pos))
 
+// Convert a display area into the same area on the (unrotated) frame buffer
+static void fb_area(GDisplay *g, coord_t *x, coord_t *y, coord_t *cx, coord_t *cy) {
+	#if GDISP_NEED_CONTROL
+		coord_t		t;
+
+		switch(g->g.Orientation) {
+		case GDISP_ROTATE_90:
+			t = *x;
+			*x = *y;
+			*y = g->g.Width - t - *cx;
+			t = *cx; *cx = *cy; *cy = t;
+			break;
+		case GDISP_ROTATE_180:
+			*x = g->g.Width - *x - *cx;
+			*y = g->g.Height - *y - *cy;
+			break;
+		case GDISP_ROTATE_270:
+			t = *x;
+			*x = g->g.Height - *y - *cy;
+			*y = t;
+			t = *cx; *cx = *cy; *cy = t;
+			break;
+		default:
+			break;
+		}
+	#else
+		(void) g; (void) x; (void) y; (void) cx; (void) cy;
+	#endif
+}
+
+#if GDISP_HARDWARE_FLUSH
+	// Add an area of the (unrotated) frame buffer to the area that needs flushing
+	static void fb_damage(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy) {
+		fbInfo *	fbi;
+
+		fbi = &((fbPriv *)g->priv)->fbi;
+		if (!fbi->dx1) {
+			fbi->dx0 = x; fbi->dy0 = y;
+			fbi->dx1 = x + cx; fbi->dy1 = y + cy;
+			return;
+		}
+		if (x < fbi->dx0)		fbi->dx0 = x;
+		if (y < fbi->dy0)		fbi->dy0 = y;
+		if (x + cx > fbi->dx1)	fbi->dx1 = x + cx;
+		if (y + cy > fbi->dy1)	fbi->dy1 = y + cy;
+	}
+#else
+	#define fb_damage(g, x, y, cx, cy)
+#endif
+
+// Fill a frame buffer row with one color.
+//	The middle of the span is written a machine word at a time (several pixels per store for 8 and 16 bit pixels,
+//	and two per store for 32 bit pixels on 64 bit machines).
+typedef unsigned long	fbword;
+#define FB_PIXELS_PER_WORD	(sizeof(fbword) / sizeof(LLDCOLOR_TYPE))
+
+static void fb_fill_span(LLDCOLOR_TYPE *p, LLDCOLOR_TYPE c, coord_t cnt) {
+	fbword		w, *wp;
+	unsigned	i;
+
+	if (FB_PIXELS_PER_WORD > 1 && cnt >= (coord_t)(2 * FB_PIXELS_PER_WORD) && !((size_t)p & (sizeof(LLDCOLOR_TYPE)-1))) {
+		// Get to a word boundary
+		for(; ((size_t)p & (sizeof(fbword)-1)); cnt--)
+			*p++ = c;
+
+		// Pixels are whole bytes so a word of them is the same whatever the byte order
+		w = c;
+		for(i = LLDCOLOR_TYPE_BITS; i < sizeof(fbword)*8; i <<= 1)
+			w |= w << i;
+		for(wp = (fbword *)p; cnt >= (coord_t)FB_PIXELS_PER_WORD; cnt -= FB_PIXELS_PER_WORD)
+			*wp++ = w;
+		p = (LLDCOLOR_TYPE *)wp;
+	}
+	for(; cnt; cnt--)
+		*p++ = c;
+}
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -42,6 +125,9 @@ LLDSPEC bool_t gdisp_lld_init(GDisplay *g) {
 		gfxHalt("GDISP Framebuffer: Failed to allocate private memory");
 	((fbPriv *)g->priv)->fbi.pixels = 0;
 	((fbPriv *)g->priv)->fbi.linelen = 0;
+	#if GDISP_HARDWARE_FLUSH
+		((fbPriv *)g->priv)->fbi.dx1 = 0;
+	#endif
 
 	// Initialize the GDISP structure
 	g->g.Orientation = GDISP_ROTATE_0;
@@ -55,60 +141,118 @@ LLDSPEC bool_t gdisp_lld_init(GDisplay *g) {
 #if GDISP_HARDWARE_FLUSH
 	LLDSPEC void gdisp_lld_flush(GDisplay *g) {
 		board_flush(g);
+		((fbPriv *)g->priv)->fbi.dx1 = 0;
 	}
 #endif
 
 LLDSPEC void gdisp_lld_draw_pixel(GDisplay *g) {
-	unsigned	pos;
+	coord_t		x, y, cx, cy;
 
+	x = g->p.x; y = g->p.y;
+	cx = cy = 1;
+	fb_area(g, &x, &y, &cx, &cy);
+	fb_damage(g, x, y, 1, 1);
+	PIXEL_ADDR(g, PIXIL_POS(g, x, y))[0] = gdispColor2Native(g->p.color);
+}
+
+LLDSPEC void gdisp_lld_fill_area(GDisplay *g) {
+	coord_t			x, y, cx, cy;
+	LLDCOLOR_TYPE	c;
+	char *			row;
+	coord_t			linelen;
+
+	x = g->p.x; y = g->p.y;
+	cx = g->p.cx; cy = g->p.cy;
+	fb_area(g, &x, &y, &cx, &cy);
+	fb_damage(g, x, y, cx, cy);
+
+	// A rectangle is still a rectangle on the unrotated frame buffer so just fill each row
+	c = gdispColor2Native(g->p.color);
+	linelen = ((fbPriv *)g->priv)->fbi.linelen;
+	for(row = (char *)PIXEL_ADDR(g, PIXIL_POS(g, x, y)); cy; cy--, row += linelen)
+		fb_fill_span((LLDCOLOR_TYPE *)row, c, cx);
+}
+
+LLDSPEC void gdisp_lld_blit_area(GDisplay *g) {
+	const pixel_t *	src;
+	char *			row;
+	coord_t			x, y, cx, cy;
+	coord_t			linelen;
+
+	// Find the frame buffer position of the first pixel
+	x = g->p.x; y = g->p.y;
+	cx = cy = 1;
+	fb_area(g, &x, &y, &cx, &cy);
+	row = (char *)PIXEL_ADDR(g, PIXIL_POS(g, x, y));
+
+	x = g->p.x; y = g->p.y;
+	cx = g->p.cx; cy = g->p.cy;
+	fb_area(g, &x, &y, &cx, &cy);
+	fb_damage(g, x, y, cx, cy);
+
+	src = (const pixel_t *)g->p.ptr + g->p.y1 * g->p.x2 + g->p.x1;
+	linelen = ((fbPriv *)g->priv)->fbi.linelen;
+
+	// Each source row is a span in the frame buffer that runs in a different direction for each orientation
 	#if GDISP_NEED_CONTROL
 		switch(g->g.Orientation) {
-		case GDISP_ROTATE_0:
-		default:
-			pos = PIXIL_POS(g, g->p.x, g->p.y);
-			break;
 		case GDISP_ROTATE_90:
-			pos = PIXIL_POS(g, g->p.y, g->g.Width-g->p.x-1);
-			break;
+			// Source rows run up the frame buffer, source columns run right
+			for(y = g->p.cy; y; y--, src += g->p.x2, row += sizeof(LLDCOLOR_TYPE)) {
+				char *		p = row;
+				coord_t		i;
+
+				for(i = 0; i < g->p.cx; i++, p -= linelen)
+					*(LLDCOLOR_TYPE *)p = gdispColor2Native(src[i]);
+			}
+			return;
 		case GDISP_ROTATE_180:
-			pos = PIXIL_POS(g, g->g.Width-g->p.x-1, g->g.Height-g->p.y-1);
-			break;
+			// Source rows run right to left, source columns run up
+			for(y = g->p.cy; y; y--, src += g->p.x2, row -= linelen) {
+				LLDCOLOR_TYPE *	p = (LLDCOLOR_TYPE *)row;
+				coord_t			i;
+
+				for(i = 0; i < g->p.cx; i++)
+					*p-- = gdispColor2Native(src[i]);
+			}
+			return;
 		case GDISP_ROTATE_270:
-			pos = PIXIL_POS(g, g->g.Height-g->p.y-1, g->p.x);
+			// Source rows run down the frame buffer, source columns run left
+			for(y = g->p.cy; y; y--, src += g->p.x2, row -= sizeof(LLDCOLOR_TYPE)) {
+				char *		p = row;
+				coord_t		i;
+
+				for(i = 0; i < g->p.cx; i++, p += linelen)
+					*(LLDCOLOR_TYPE *)p = gdispColor2Native(src[i]);
+			}
+			return;
+		default:
 			break;
 		}
-	#else
-		pos = PIXIL_POS(g, g->p.x, g->p.y);
 	#endif
 
-		PIXEL_ADDR(g, pos)[0] = gdispColor2Native(g->p.color);
+	// Source rows are frame buffer rows
+	for(y = g->p.cy; y; y--, src += g->p.x2, row += linelen) {
+		#if GDISP_PIXELFORMAT == GDISP_LLD_PIXELFORMAT
+			memcpy(row, src, g->p.cx * sizeof(LLDCOLOR_TYPE));
+		#else
+			LLDCOLOR_TYPE *	p = (LLDCOLOR_TYPE *)row;
+			coord_t			i;
+
+			for(i = 0; i < g->p.cx; i++)
+				*p++ = gdispColor2Native(src[i]);
+		#endif
+	}
 }
 
 LLDSPEC	color_t gdisp_lld_get_pixel_color(GDisplay *g) {
-	unsigned		pos;
+	coord_t			x, y, cx, cy;
 	LLDCOLOR_TYPE	color;
 
-	#if GDISP_NEED_CONTROL
-		switch(g->g.Orientation) {
-		case GDISP_ROTATE_0:
-		default:
-			pos = PIXIL_POS(g, g->p.x, g->p.y);
-			break;
-		case GDISP_ROTATE_90:
-			pos = PIXIL_POS(g, g->p.y, g->g.Width-g->p.x-1);
-			break;
-		case GDISP_ROTATE_180:
-			pos = PIXIL_POS(g, g->g.Width-g->p.x-1, g->g.Height-g->p.y-1);
-			break;
-		case GDISP_ROTATE_270:
-			pos = PIXIL_POS(g, g->g.Height-g->p.y-1, g->p.x);
-			break;
-		}
-	#else
-		pos = PIXIL_POS(g, g->p.x, g->p.y);
-	#endif
-
-	color = PIXEL_ADDR(g, pos)[0];
+	x = g->p.x; y = g->p.y;
+	cx = cy = 1;
+	fb_area(g, &x, &y, &cx, &cy);
+	color = PIXEL_ADDR(g, PIXIL_POS(g, x, y))[0];
 	return gdispNative2Color(color);
 }
 
@@ -33,6 +33,9 @@
 #ifndef GDISP_SCREEN_HEIGHT
 	#define GDISP_SCREEN_HEIGHT			480
 #endif
+#ifndef GDISP_SDL_DAMAGE_RECTS
+	#define GDISP_SDL_DAMAGE_RECTS		8
+#endif
 
 #if GINPUT_NEED_MOUSE
 	// Include mouse support code
@@ -155,11 +158,19 @@
 	static GKeyboard *keyboard = 0;
 #endif
 
+// A changed area of the frame buffer. x1 and y1 are exclusive.
+struct SDL_Damage {
+	int16_t		x0, y0, x1, y1;
+};
+
 // shared IPC context
 struct SDL_UGFXContext {
 	uint32_t 	framebuf[GDISP_SCREEN_WIDTH*GDISP_SCREEN_HEIGHT];
-	int16_t		need_redraw;
-	int		minx,miny,maxx,maxy;
+	int16_t		ndamage;
+	struct		SDL_Damage damage[GDISP_SDL_DAMAGE_RECTS];
+	// The area being drawn a pixel at a time. Only the drawing process writes it so it needs no lock.
+	volatile struct SDL_Damage pixels;
+	SDL_atomic_t pixelschanged;
 #if GINPUT_NEED_MOUSE
 	coord_t 	mousex, mousey;
 	uint16_t 	buttons;
@@ -178,32 +189,126 @@ static sem_t *input_event;
 #define INPUT_EVENT_NAME 	"ugfx_input_event"
 
 
+// Add a changed area to the damage list.
+//	Areas that overlap (or nearly so) are merged. When the list is full the new area is merged with whichever
+//	existing area grows the least.
+static void SDL_addDamage (int x0, int y0, int x1, int y1) {
+	struct SDL_Damage *d, *best;
+	long cost, bestcost;
+	int i;
+
+	best = 0;
+	bestcost = 0;
+	sem_wait (ctx_mutex);
+	for (i = 0, d = context->damage; i < context->ndamage; i++, d++) {
+		// How many pixels that haven't changed would be uploaded if we merged
+		cost = (long)((d->x1 > x1 ? d->x1 : x1) - (d->x0 < x0 ? d->x0 : x0)) * ((d->y1 > y1 ? d->y1 : y1) - (d->y0 < y0 ? d->y0 : y0))
+				- (long)(d->x1 - d->x0) * (d->y1 - d->y0) - (long)(x1 - x0) * (y1 - y0);
+		if (!best || cost < bestcost) {
+			best = d;
+			bestcost = cost;
+		}
+	}
+	if (!best || (bestcost > 0 && context->ndamage < GDISP_SDL_DAMAGE_RECTS)) {
+		best = context->damage + context->ndamage++;
+		best->x0 = x0; best->y0 = y0;
+		best->x1 = x1; best->y1 = y1;
+	} else {
+		if (best->x0 > x0) best->x0 = x0;
+		if (best->y0 > y0) best->y0 = y0;
+		if (best->x1 < x1) best->x1 = x1;
+		if (best->y1 < y1) best->y1 = y1;
+	}
+	sem_post (ctx_mutex);
+}
+
+// Add a changed pixel to the damage.
+//	Runs of nearby pixels grow a separate area without taking the lock. It is only added to the damage list
+//	when a pixel can't be added to it cheaply. Until then the SDL process uploads it each time it changes.
+static void SDL_addPixelDamage (int x, int y) {
+	static long npixels;
+	volatile struct SDL_Damage *p;
+	int x0, y0, x1, y1;
+
+	p = &context->pixels;
+	x0 = p->x0 < x ? p->x0 : x;
+	y0 = p->y0 < y ? p->y0 : y;
+	x1 = p->x1 > x ? p->x1 : x+1;
+	y1 = p->y1 > y ? p->y1 : y+1;
+
+	// Grow the area if the pixel touches it and no more than half of it would be unchanged pixels
+	if (npixels && x >= p->x0-1 && x <= p->x1 && y >= p->y0-1 && y <= p->y1 && (long)(x1 - x0) * (y1 - y0) <= 2 * (npixels+1)) {
+		npixels++;
+	} else {
+		if (npixels)
+			SDL_addDamage (p->x0, p->y0, p->x1, p->y1);
+		npixels = 1;
+		x0 = x; y0 = y;
+		x1 = x+1; y1 = y+1;
+	}
+	p->x0 = x0; p->y0 = y0;
+	p->x1 = x1; p->y1 = y1;
+
+	// This is a full barrier so the SDL process sees the area before it sees the flag
+	SDL_AtomicSet (&context->pixelschanged, 1);
+}
+
 static int SDL_loop (void) {
 	SDL_Window   *window = SDL_CreateWindow("uGFX", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, GDISP_SCREEN_WIDTH, GDISP_SCREEN_HEIGHT, 0);
 	SDL_Renderer *render = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
 	SDL_Texture  *texture = SDL_CreateTexture(render, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, GDISP_SCREEN_WIDTH, GDISP_SCREEN_HEIGHT);
+	struct SDL_Damage damage[GDISP_SDL_DAMAGE_RECTS+1];
+	SDL_DisplayMode mode;
+	Uint32 frame, next, now;
 	int done = 0;
+	int i, n;
+
+	// Present once per display refresh
+	if (SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(window), &mode) != 0 || mode.refresh_rate <= 0)
+		mode.refresh_rate = 60;
+	frame = 1000 / mode.refresh_rate;
+	next = SDL_GetTicks();
 
 	while  (!done) {
-		
-		if (context->need_redraw) {
-			context->need_redraw = 0;
-			SDL_Rect r;
-			r.x = context->minx;
-			r.y = context->miny;
-			r.w = context->maxx - context->minx + 1;
-			r.h = context->maxy - context->miny + 1;
-			context->minx = GDISP_SCREEN_WIDTH;
-			context->miny = GDISP_SCREEN_HEIGHT;
-			context->maxx = 0;
-			context->maxy = 0;
-			
-			SDL_UpdateTexture(texture, &r, context->framebuf+r.y*GDISP_SCREEN_WIDTH+r.x, GDISP_SCREEN_WIDTH*sizeof(uint32_t));
+		SDL_Event event;
+
+		// Take the damage list so drawing can continue while we upload
+		sem_wait (ctx_mutex);
+		n = context->ndamage;
+		memcpy (damage, context->damage, n * sizeof (damage[0]));
+		context->ndamage = 0;
+		sem_post (ctx_mutex);
+
+		// Pick up the area being drawn a pixel at a time. It may change while we read it but then it is marked
+		//	as changed again and we see the final area next frame.
+		if (SDL_AtomicSet (&context->pixelschanged, 0)) {
+			damage[n].x0 = context->pixels.x0;
+			damage[n].y0 = context->pixels.y0;
+			damage[n].x1 = context->pixels.x1;
+			damage[n].y1 = context->pixels.y1;
+			if (damage[n].x1 > damage[n].x0 && damage[n].y1 > damage[n].y0)
+				n++;
+		}
+
+		if (n) {
+			for (i = 0; i < n; i++) {
+				SDL_Rect r;
+				r.x = damage[i].x0;
+				r.y = damage[i].y0;
+				r.w = damage[i].x1 - damage[i].x0;
+				r.h = damage[i].y1 - damage[i].y0;
+				SDL_UpdateTexture(texture, &r, context->framebuf+r.y*GDISP_SCREEN_WIDTH+r.x, GDISP_SCREEN_WIDTH*sizeof(uint32_t));
+			}
 			SDL_RenderCopy(render, texture, 0, 0);
-			SDL_RenderPresent(render);
+			SDL_RenderPresent(render);			// With a vsync renderer this waits for the vertical blank
 		}
-		SDL_Event event;
-		for (; SDL_PollEvent(&event); ){
+
+		// Handle input until the next frame is due
+		next += frame;
+		now = SDL_GetTicks();
+		if ((Sint32)(next - now) < 0)
+			next = now;
+		for (; SDL_WaitEventTimeout(&event, (Sint32)(next - now) > 0 ? (int)(next - now) : 0); now = SDL_GetTicks()){
 			switch(event.type){
 #if GINPUT_NEED_MOUSE
 #if 0
@@ -281,8 +386,10 @@ static int SDL_loop (void) {
 			default:
 				break;
 			}
+			// Don't let a stream of events hold up the display
+			if ((Sint32)(next - SDL_GetTicks()) <= 0)
+				break;
 		}
-		SDL_Delay(40);
 	}
 	
 	SDL_DestroyTexture (texture);
@@ -340,11 +447,9 @@ void sdl_driver_init (void) {
 		// Main proccess. It's for host UI and SDL
 		int status;
 		memset (context,0,sizeof (*context));
-		context->need_redraw = 1;
-		context->maxx = GDISP_SCREEN_WIDTH-1;
-		context->maxy = GDISP_SCREEN_HEIGHT-1;
-		context->minx = 0;
-		context->miny = 0;
+		context->ndamage = 1;
+		context->damage[0].x1 = GDISP_SCREEN_WIDTH;
+		context->damage[0].y1 = GDISP_SCREEN_HEIGHT;
 		SDL_loop ();
 		// cleanup
 		kill(gui_pid,SIGKILL);
@@ -384,23 +489,11 @@ LLDSPEC bool_t gdisp_lld_init(GDisplay *g) {
 }
 
 
-static void SDL_extendUpdateRect (int x,int y) {
-	if (context->minx > x)
-		context->minx = x;
-	if (context->miny > y)
-		context->miny = y;
-	if (context->maxx < x)
-		context->maxx = x;
-	if (context->maxy < y)
-		context->maxy = y;
-}
-
 LLDSPEC void gdisp_lld_draw_pixel(GDisplay *g)
 {
 	if (context) {
 		context->framebuf[(g->p.y*GDISP_SCREEN_WIDTH)+g->p.x] = gdispColor2Native(g->p.color);
-		SDL_extendUpdateRect (g->p.x,g->p.y);
-		context->need_redraw = 1;
+		SDL_addPixelDamage (g->p.x, g->p.y);
 	}
 }
 
@@ -416,12 +509,60 @@ LLDSPEC void gdisp_lld_draw_pixel(GDisplay *g)
 					*pbuf++ = c;
 				pbuf += dy;
 			}
-			SDL_extendUpdateRect (g->p.x,g->p.y);
-			SDL_extendUpdateRect (g->p.x+g->p.cx-1,g->p.y+g->p.cy-1);
-			context->need_redraw = 1;
+			SDL_addDamage (g->p.x, g->p.y, g->p.x+g->p.cx, g->p.y+g->p.cy);
 		}
 	}
+#endif
 
+#if GDISP_HARDWARE_BITFILLS
+	LLDSPEC void gdisp_lld_blit_area(GDisplay *g) {
+		if (context) {
+			const pixel_t *src = (const pixel_t *)g->p.ptr + g->p.y1 * g->p.x2 + g->p.x1;
+			uint32_t *pbuf = context->framebuf + g->p.y*GDISP_SCREEN_WIDTH + g->p.x;
+			int y;
+			for (y = 0; y < g->p.cy; ++y, src += g->p.x2, pbuf += GDISP_SCREEN_WIDTH) {
+				#if GDISP_PIXELFORMAT == GDISP_LLD_PIXELFORMAT
+					memcpy (pbuf, src, g->p.cx * sizeof (uint32_t));
+				#else
+					int x;
+					for (x = 0; x < g->p.cx; ++x)
+						pbuf[x] = gdispColor2Native(src[x]);
+				#endif
+			}
+			SDL_addDamage (g->p.x, g->p.y, g->p.x+g->p.cx, g->p.y+g->p.cy);
+		}
+	}
+#endif
+
+#if GDISP_HARDWARE_STREAM_WRITE
+	// The streaming window and the current position within it
+	static struct SDL_Stream {
+		coord_t		x0, y0, x1, y1;
+		coord_t		x, y;
+	} stream;
+
+	LLDSPEC	void gdisp_lld_write_start(GDisplay *g) {
+		stream.x0 = stream.x = g->p.x;
+		stream.y0 = stream.y = g->p.y;
+		stream.x1 = g->p.x + g->p.cx;
+		stream.y1 = g->p.y + g->p.cy;
+	}
+
+	LLDSPEC	void gdisp_lld_write_color(GDisplay *g) {
+		if (context)
+			context->framebuf[(stream.y*GDISP_SCREEN_WIDTH)+stream.x] = gdispColor2Native(g->p.color);
+		if (++stream.x >= stream.x1) {
+			stream.x = stream.x0;
+			if (++stream.y >= stream.y1)
+				stream.y = stream.y0;
+		}
+	}
+
+	LLDSPEC	void gdisp_lld_write_stop(GDisplay *g) {
+		(void) g;
+		if (context)
+			SDL_addDamage (stream.x0, stream.y0, stream.x1, stream.y1);
+	}
 #endif
 
 #if GDISP_HARDWARE_PIXELREAD
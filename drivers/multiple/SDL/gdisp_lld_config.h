@@ -14,7 +14,8 @@
 
 #define GDISP_HARDWARE_DRAWPIXEL		TRUE
 #define GDISP_HARDWARE_FILLS			TRUE
-#define GDISP_HARDWARE_BITFILLS			FALSE
+#define GDISP_HARDWARE_BITFILLS			TRUE
+#define GDISP_HARDWARE_STREAM_WRITE		TRUE
 #define GDISP_HARDWARE_SCROLL			FALSE
 #define GDISP_HARDWARE_PIXELREAD		TRUE
 #define GDISP_HARDWARE_CONTROL			FALSE
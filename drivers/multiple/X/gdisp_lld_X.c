@@ -17,6 +17,7 @@
 #include <X11/Xresource.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define GDISP_DRIVER_VMT				GDISPVMT_X11
 #include "gdisp_lld_config.h"
@@ -32,6 +33,27 @@
 #ifndef GDISP_SCREEN_HEIGHT
 	#define GDISP_SCREEN_HEIGHT			480
 #endif
+#ifndef GDISP_X_USE_SHM
+	/**
+	 * Setting this to TRUE uses the MIT-SHM extension to share the framebuffer
+	 * image with a local X server instead of copying it through the X protocol.
+	 * You will need to link with the Xext library (add Xext to GFXLIBS).
+	 * If the display does not support it the driver falls back to XPutImage.
+	 */
+	#define GDISP_X_USE_SHM				FALSE
+#endif
+#ifndef GDISP_X_DAMAGE_RECTS
+	// The maximum number of separate damaged rectangles remembered between flushes
+	#define GDISP_X_DAMAGE_RECTS		8
+#endif
+#ifndef GDISP_X_FLUSH_PERIOD
+	// How often (in milliseconds) the X thread pushes damaged areas to the window
+	#define GDISP_X_FLUSH_PERIOD		20
+#endif
+#ifndef GDISP_X_COLOR_CACHE_SIZE
+	// The number of colors remembered when the visual needs XAllocColor (not TrueColor)
+	#define GDISP_X_COLOR_CACHE_SIZE	256
+#endif
 #ifndef GKEYBOARD_X_NO_LAYOUT
 	/**
 	 * Setting this to TRUE turns off the layout engine.
@@ -50,6 +72,12 @@
 	#define GKEYBOARD_X_DEFAULT_LAYOUT	KeyboardLayout_X_US
 #endif
 
+#if GDISP_X_USE_SHM
+	#include <sys/ipc.h>
+	#include <sys/shm.h>
+	#include <X11/extensions/XShm.h>
+#endif
+
 // Driver status flags
 #define GDISP_FLG_READY				(GDISP_FLG_DRIVER<<0)
 
@@ -171,11 +199,52 @@ static Colormap			cmap;
 static XVisualInfo		vis;
 static XContext			cxt;
 static Atom				wmDelete;
+static int				hostorder;
+#if GDISP_X_USE_SHM
+	static bool_t		useshm;
+	static bool_t		shmerror;
+#endif
+
+// For TrueColor visuals pixel values are built directly from the visual's color masks
+typedef struct xChannel {
+	uint8_t			shift;				// The position of the lowest bit in the mask
+	uint8_t			bits;				// The number of bits in the mask
+} xChannel;
+
+static bool_t			isTrueColor;
+static xChannel			xRed, xGreen, xBlue;
+
+// For other visuals we remember what XAllocColor gave us to save a round trip per color
+typedef struct xColorCacheEntry {
+	color_t			color;
+	unsigned long	pixel;
+	bool_t			valid;
+} xColorCacheEntry;
+
+static xColorCacheEntry	xColorCache[GDISP_X_COLOR_CACHE_SIZE];
+
+// A damaged area of the window. x1 and y1 are exclusive.
+typedef struct xRect {
+	coord_t			x0, y0, x1, y1;
+} xRect;
 
 typedef struct xPriv {
-	Pixmap			pix;
+	struct xPriv *	next;				// The list of X displays that the X thread flushes
+	XImage *		img;				// The client side framebuffer
+	bool_t			direct;				// The framebuffer can be accessed as native uint32_t pixels
+	#if GDISP_X_USE_SHM
+		bool_t			shm;
+		XShmSegmentInfo	shminfo;
+	#endif
 	GC 				gc;
 	Window			win;
+	gfxMutex		dmutex;				// Protects the damage list
+	unsigned		ndamage;
+	xRect			damage[GDISP_X_DAMAGE_RECTS];
+	#if GDISP_HARDWARE_STREAM_WRITE || GDISP_HARDWARE_STREAM_READ
+		coord_t		sx0, sy0, sx1, sy1;	// The streaming window
+		coord_t		sx, sy;				// The current streaming position
+	#endif
 	#if GINPUT_NEED_MOUSE
 		coord_t		mousex, mousey;
 		uint16_t	buttons;
@@ -183,6 +252,269 @@ typedef struct xPriv {
 	#endif
 } xPriv;
 
+static xPriv *			xList;
+
+/*===========================================================================*/
+/* Color conversion                                                          */
+/*===========================================================================*/
+
+static void InitChannel(xChannel *pc, unsigned long mask) {
+	pc->shift = pc->bits = 0;
+	if (!mask)
+		return;
+	while(!(mask & 1)) {
+		mask >>= 1;
+		pc->shift++;
+	}
+	while(mask & 1) {
+		mask >>= 1;
+		pc->bits++;
+	}
+}
+
+static GFXINLINE unsigned long ToChannel(const xChannel *pc, unsigned v) {
+	if (pc->bits <= 8)
+		return (unsigned long)(v >> (8 - pc->bits)) << pc->shift;
+	return (unsigned long)v << (pc->bits - 8 + pc->shift);
+}
+
+static GFXINLINE unsigned FromChannel(const xChannel *pc, unsigned long pixel) {
+	unsigned long	v;
+
+	v = (pixel >> pc->shift) & ((1UL << pc->bits) - 1);
+	if (pc->bits >= 8)
+		return v >> (pc->bits - 8);
+	// Replicate the top bits into the empty low bits so that white stays white
+	v <<= 8 - pc->bits;
+	return (v | (v >> pc->bits)) & 0xFF;
+}
+
+static unsigned long ColorToPixel(color_t c) {
+	xColorCacheEntry *	pe;
+	XColor				col;
+
+	if (isTrueColor)
+		return ToChannel(&xRed, RED_OF(c)) | ToChannel(&xGreen, GREEN_OF(c)) | ToChannel(&xBlue, BLUE_OF(c));
+
+	pe = &xColorCache[((unsigned)c ^ ((unsigned)c >> 11)) % GDISP_X_COLOR_CACHE_SIZE];
+	if (pe->valid && pe->color == c)
+		return pe->pixel;
+
+	col.red = RED_OF(c) << 8;
+	col.green = GREEN_OF(c) << 8;
+	col.blue = BLUE_OF(c) << 8;
+	XAllocColor(dis, cmap, &col);
+	pe->color = c;
+	pe->pixel = col.pixel;
+	pe->valid = TRUE;
+	return col.pixel;
+}
+
+static color_t PixelToColor(unsigned long pixel) {
+	XColor		col;
+	unsigned	i;
+
+	if (isTrueColor)
+		return RGB2COLOR((uint8_t)FromChannel(&xRed, pixel), (uint8_t)FromChannel(&xGreen, pixel), (uint8_t)FromChannel(&xBlue, pixel));
+
+	for(i = 0; i < GDISP_X_COLOR_CACHE_SIZE; i++) {
+		if (xColorCache[i].valid && xColorCache[i].pixel == pixel)
+			return xColorCache[i].color;
+	}
+	col.pixel = pixel;
+	XQueryColor(dis, cmap, &col);
+	return RGB2COLOR(col.red>>8, col.green>>8, col.blue>>8);
+}
+
+/*===========================================================================*/
+/* Framebuffer access                                                        */
+/*===========================================================================*/
+
+#define XPIXROW(priv, y)		((uint32_t *)((priv)->img->data + (y) * (priv)->img->bytes_per_line))
+
+static GFXINLINE void PutPixel(xPriv *priv, coord_t x, coord_t y, unsigned long pixel) {
+	if (priv->direct)
+		XPIXROW(priv, y)[x] = (uint32_t)pixel;
+	else
+		XPutPixel(priv->img, x, y, pixel);
+}
+
+static GFXINLINE unsigned long GetPixel(xPriv *priv, coord_t x, coord_t y) {
+	if (priv->direct)
+		return XPIXROW(priv, y)[x];
+	return XGetPixel(priv->img, x, y);
+}
+
+static void PutImage(xPriv *priv, int x, int y, unsigned cx, unsigned cy) {
+	#if GDISP_X_USE_SHM
+		if (priv->shm) {
+			XShmPutImage(dis, priv->win, priv->gc, priv->img, x, y, x, y, cx, cy, False);
+			return;
+		}
+	#endif
+	XPutImage(dis, priv->win, priv->gc, priv->img, x, y, x, y, cx, cy);
+}
+
+#if GDISP_X_USE_SHM
+	static int ShmErrorHandler(Display *d, XErrorEvent *e) {
+		(void) d;
+		(void) e;
+
+		shmerror = TRUE;
+		return 0;
+	}
+
+	static bool_t CreateShmImage(xPriv *priv) {
+		XErrorHandler	old;
+
+		priv->img = XShmCreateImage(dis, vis.visual, vis.depth, ZPixmap, 0, &priv->shminfo, GDISP_SCREEN_WIDTH, GDISP_SCREEN_HEIGHT);
+		if (!priv->img)
+			return FALSE;
+
+		priv->shminfo.shmid = shmget(IPC_PRIVATE, priv->img->bytes_per_line * priv->img->height, IPC_CREAT|0600);
+		if (priv->shminfo.shmid < 0)
+			goto fail_image;
+		priv->shminfo.shmaddr = priv->img->data = (char *)shmat(priv->shminfo.shmid, 0, 0);
+		if (priv->shminfo.shmaddr == (char *)-1)
+			goto fail_segment;
+		priv->shminfo.readOnly = False;
+
+		// A remote display will refuse the attach with an X error rather than a return value
+		shmerror = FALSE;
+		old = XSetErrorHandler(ShmErrorHandler);
+		XShmAttach(dis, &priv->shminfo);
+		XSync(dis, False);
+		XSetErrorHandler(old);
+		if (shmerror)
+			goto fail_attach;
+
+		// The segment is released automatically when both we and the server have detached
+		shmctl(priv->shminfo.shmid, IPC_RMID, 0);
+		priv->shm = TRUE;
+		return TRUE;
+
+	fail_attach:
+		shmdt(priv->shminfo.shmaddr);
+	fail_segment:
+		shmctl(priv->shminfo.shmid, IPC_RMID, 0);
+	fail_image:
+		priv->img->data = 0;
+		XDestroyImage(priv->img);
+		priv->img = 0;
+		return FALSE;
+	}
+#endif
+
+static bool_t CreateImage(xPriv *priv) {
+	#if GDISP_X_USE_SHM
+		if (useshm) {
+			if (CreateShmImage(priv))
+				goto done;
+			fprintf(stderr, "MIT-SHM is not available for this display - using XPutImage\n");
+			useshm = FALSE;
+		}
+	#endif
+
+	priv->img = XCreateImage(dis, vis.visual, vis.depth, ZPixmap, 0, 0, GDISP_SCREEN_WIDTH, GDISP_SCREEN_HEIGHT, 32, 0);
+	if (!priv->img)
+		return FALSE;
+
+	// Keep the client side image in our own byte order. Xlib swaps if the server needs it.
+	priv->img->byte_order = hostorder;
+	XInitImage(priv->img);
+	if (!(priv->img->data = (char *)calloc(priv->img->height, priv->img->bytes_per_line))) {
+		XDestroyImage(priv->img);
+		priv->img = 0;
+		return FALSE;
+	}
+
+	#if GDISP_X_USE_SHM
+		done:
+	#endif
+	priv->direct = priv->img->bits_per_pixel == 32 && priv->img->byte_order == hostorder;
+	return TRUE;
+}
+
+/*===========================================================================*/
+/* Damage tracking                                                           */
+/*===========================================================================*/
+
+static GFXINLINE void MergeRect(xRect *pd, const xRect *pr) {
+	if (pr->x0 < pd->x0)	pd->x0 = pr->x0;
+	if (pr->y0 < pd->y0)	pd->y0 = pr->y0;
+	if (pr->x1 > pd->x1)	pd->x1 = pr->x1;
+	if (pr->y1 > pd->y1)	pd->y1 = pr->y1;
+}
+
+static void AddDamage(xPriv *priv, coord_t x, coord_t y, coord_t cx, coord_t cy) {
+	xRect		r, u;
+	xRect *		pd;
+	xRect *		pbest;
+	long		grow, best;
+	unsigned	i;
+
+	r.x0 = x;
+	r.y0 = y;
+	r.x1 = x + cx;
+	r.y1 = y + cy;
+
+	gfxMutexEnter(&priv->dmutex);
+
+	// Grow any rectangle this overlaps or touches
+	for(i = 0, pd = priv->damage; i < priv->ndamage; i++, pd++) {
+		if (r.x0 <= pd->x1 && r.x1 >= pd->x0 && r.y0 <= pd->y1 && r.y1 >= pd->y0) {
+			MergeRect(pd, &r);
+			gfxMutexExit(&priv->dmutex);
+			return;
+		}
+	}
+
+	// Start a new rectangle if there is space
+	if (priv->ndamage < GDISP_X_DAMAGE_RECTS) {
+		priv->damage[priv->ndamage++] = r;
+		gfxMutexExit(&priv->dmutex);
+		return;
+	}
+
+	// Otherwise merge with the rectangle that grows the least
+	pbest = priv->damage;
+	best = 0x7FFFFFFFL;
+	for(i = 0, pd = priv->damage; i < priv->ndamage; i++, pd++) {
+		u = *pd;
+		MergeRect(&u, &r);
+		grow = (long)(u.x1 - u.x0) * (u.y1 - u.y0) - (long)(pd->x1 - pd->x0) * (pd->y1 - pd->y0);
+		if (grow < best) {
+			best = grow;
+			pbest = pd;
+		}
+	}
+	MergeRect(pbest, &r);
+
+	gfxMutexExit(&priv->dmutex);
+}
+
+static void FlushDamage(xPriv *priv) {
+	xRect		d[GDISP_X_DAMAGE_RECTS];
+	unsigned	i, n;
+
+	// Take the damage list so that drawing can continue while we talk to the server
+	gfxMutexEnter(&priv->dmutex);
+	n = priv->ndamage;
+	memcpy(d, priv->damage, n * sizeof(xRect));
+	priv->ndamage = 0;
+	gfxMutexExit(&priv->dmutex);
+
+	if (!n)
+		return;
+	for(i = 0; i < n; i++)
+		PutImage(priv, d[i].x0, d[i].y0, d[i].x1 - d[i].x0, d[i].y1 - d[i].y0);
+	XFlush(dis);
+}
+
+/*===========================================================================*/
+/* X event handling                                                          */
+/*===========================================================================*/
+
 static void ProcessEvent(GDisplay *g, xPriv *priv) {
 	switch(evt.type) {
 	case MapNotify:
@@ -201,10 +533,7 @@ static void ProcessEvent(GDisplay *g, xPriv *priv) {
 		}
 		break;
 	case Expose:
-		XCopyArea(dis, priv->pix, evt.xexpose.window, priv->gc,
-			evt.xexpose.x, evt.xexpose.y,
-			evt.xexpose.width, evt.xexpose.height,
-			evt.xexpose.x, evt.xexpose.y);
+		PutImage(priv, evt.xexpose.x, evt.xexpose.y, evt.xexpose.width, evt.xexpose.height);
 		break;
 	#if GINPUT_NEED_MOUSE
 		case ButtonPress:
@@ -265,19 +594,22 @@ static void ProcessEvent(GDisplay *g, xPriv *priv) {
 	}
 }
 
-/* this is the X11 thread which keeps track of all events */
+/* this is the X11 thread which keeps track of all events and pushes the damaged areas to the server */
 static DECLARE_THREAD_STACK(waXThread, 1024);
 static DECLARE_THREAD_FUNCTION(ThreadX, arg) {
 	GDisplay	*g;
+	xPriv		*priv;
 	(void)arg;
 
 	while(1) {
-		gfxSleepMilliseconds(100);
+		gfxSleepMilliseconds(GDISP_X_FLUSH_PERIOD);
 		while(XPending(dis)) {
 			XNextEvent(dis, &evt);
 			XFindContext(evt.xany.display, evt.xany.window, cxt, (XPointer*)&g);
 			ProcessEvent(g, (xPriv *)g->priv);
 		}
+		for(priv = xList; priv; priv = priv->next)
+			FlushDamage(priv);
 	}
 	return 0;
 }
@@ -299,6 +631,7 @@ LLDSPEC bool_t gdisp_lld_init(GDisplay *g) {
 
 	if (!initdone) {
 		gfxThreadHandle			hth;
+		static const uint16_t	endian = 1;
 
 		initdone = TRUE;
 		#if GFX_USE_OS_LINUX || GFX_USE_OS_OSX
@@ -310,6 +643,7 @@ LLDSPEC bool_t gdisp_lld_init(GDisplay *g) {
 		cxt = XUniqueContext();
 		wmDelete = XInternAtom(dis, "WM_DELETE_WINDOW", False);
 		XSetIOErrorHandler(FatalXIOError);
+		hostorder = *(const uint8_t *)&endian ? LSBFirst : MSBFirst;
 
 		#if GDISP_FORCE_24BIT
 			if (!XMatchVisualInfo(dis, scr, 24, TrueColor, &vis)) {
@@ -320,12 +654,25 @@ LLDSPEC bool_t gdisp_lld_init(GDisplay *g) {
 			cmap = XCreateColormap(dis, RootWindow(dis, scr),
 					vis.visual, AllocNone);
 		#else
-			vis.visual = CopyFromParent;
+			vis.visual = DefaultVisual(dis, scr);
 			vis.depth = DefaultDepth(dis, scr);
+			vis.red_mask = vis.visual->red_mask;
+			vis.green_mask = vis.visual->green_mask;
+			vis.blue_mask = vis.visual->blue_mask;
 			cmap = DefaultColormap(dis, scr);
 		#endif
 		fprintf(stderr, "Running GFX Window in %d bit color\n", vis.depth);
 
+		// Only visuals with color masks let us calculate pixel values ourselves
+		isTrueColor = vis.red_mask && vis.green_mask && vis.blue_mask;
+		InitChannel(&xRed, vis.red_mask);
+		InitChannel(&xGreen, vis.green_mask);
+		InitChannel(&xBlue, vis.blue_mask);
+
+		#if GDISP_X_USE_SHM
+			useshm = XShmQueryExtension(dis);
+		#endif
+
 		if (!(hth = gfxThreadCreate(waXThread, sizeof(waXThread), HIGH_PRIORITY, ThreadX, 0))) {
 			fprintf(stderr, "Cannot start X Thread\n");
 			XCloseDisplay(dis);
@@ -339,6 +686,8 @@ LLDSPEC bool_t gdisp_lld_init(GDisplay *g) {
 
 	g->priv = gfxAlloc(sizeof(xPriv));
 	priv = (xPriv *)g->priv;
+	memset(priv, 0, sizeof(xPriv));
+	gfxMutexInit(&priv->dmutex);
 	g->board = 0;					// No board interface for this driver
 
 	xa.colormap = cmap;
@@ -372,9 +721,13 @@ LLDSPEC bool_t gdisp_lld_init(GDisplay *g) {
 	XFree(pSH);
 	XSync(dis, TRUE);
 
-	priv->pix = XCreatePixmap(dis, priv->win,
-				GDISP_SCREEN_WIDTH, GDISP_SCREEN_HEIGHT, vis.depth);
-	XSync(dis, TRUE);
+	if (!CreateImage(priv)) {
+		fprintf(stderr, "Cannot create the X framebuffer image\n");
+		XDestroyWindow(dis, priv->win);
+		gfxMutexDestroy(&priv->dmutex);
+		gfxFree(priv);
+		return FALSE;
+	}
 
 	priv->gc = XCreateGC(dis, priv->win, 0, 0);
 	XSetBackground(dis, priv->gc, BlackPixel(dis, scr));
@@ -392,6 +745,10 @@ LLDSPEC bool_t gdisp_lld_init(GDisplay *g) {
 	while(!(((volatile GDisplay *)g)->flags & GDISP_FLG_READY))
 		gfxSleepMilliseconds(100);
 
+	// From now on the X thread pushes our damaged areas to the server
+	priv->next = xList;
+	xList = priv;
+
 	/* Initialise the GDISP structure to match */
     g->g.Orientation = GDISP_ROTATE_0;
     g->g.Powermode = powerOn;
@@ -403,75 +760,169 @@ LLDSPEC bool_t gdisp_lld_init(GDisplay *g) {
     return TRUE;
 }
 
-LLDSPEC void gdisp_lld_draw_pixel(GDisplay *g)
-{
-	xPriv *	priv = (xPriv *)g->priv;
-	XColor	col;
+#if GDISP_HARDWARE_FLUSH
+	LLDSPEC void gdisp_lld_flush(GDisplay *g) {
+		FlushDamage((xPriv *)g->priv);
+	}
+#endif
 
-	col.red = RED_OF(g->p.color) << 8;
-	col.green = GREEN_OF(g->p.color) << 8;
-	col.blue = BLUE_OF(g->p.color) << 8;
-	XAllocColor(dis, cmap, &col);
-	XSetForeground(dis, priv->gc, col.pixel);
-	XDrawPoint(dis, priv->pix, priv->gc, (int)g->p.x, (int)g->p.y );
-	XDrawPoint(dis, priv->win, priv->gc, (int)g->p.x, (int)g->p.y );
-	XFlush(dis);
-}
+#if GDISP_HARDWARE_STREAM_WRITE
+	LLDSPEC	void gdisp_lld_write_start(GDisplay *g) {
+		xPriv *	priv = (xPriv *)g->priv;
+
+		priv->sx0 = priv->sx = g->p.x;
+		priv->sy0 = priv->sy = g->p.y;
+		priv->sx1 = g->p.x + g->p.cx;
+		priv->sy1 = g->p.y + g->p.cy;
+	}
+	LLDSPEC	void gdisp_lld_write_color(GDisplay *g) {
+		xPriv *	priv = (xPriv *)g->priv;
+
+		PutPixel(priv, priv->sx, priv->sy, ColorToPixel(g->p.color));
+		if (++priv->sx >= priv->sx1) {
+			priv->sx = priv->sx0;
+			if (++priv->sy >= priv->sy1)
+				priv->sy = priv->sy0;
+		}
+	}
+	LLDSPEC	void gdisp_lld_write_stop(GDisplay *g) {
+		xPriv *	priv = (xPriv *)g->priv;
+
+		AddDamage(priv, priv->sx0, priv->sy0, priv->sx1 - priv->sx0, priv->sy1 - priv->sy0);
+	}
+#endif
+
+#if GDISP_HARDWARE_STREAM_READ
+	LLDSPEC	void gdisp_lld_read_start(GDisplay *g) {
+		xPriv *	priv = (xPriv *)g->priv;
+
+		priv->sx0 = priv->sx = g->p.x;
+		priv->sy0 = priv->sy = g->p.y;
+		priv->sx1 = g->p.x + g->p.cx;
+		priv->sy1 = g->p.y + g->p.cy;
+	}
+	LLDSPEC	color_t gdisp_lld_read_color(GDisplay *g) {
+		xPriv *			priv = (xPriv *)g->priv;
+		unsigned long	pixel;
+
+		pixel = GetPixel(priv, priv->sx, priv->sy);
+		if (++priv->sx >= priv->sx1) {
+			priv->sx = priv->sx0;
+			if (++priv->sy >= priv->sy1)
+				priv->sy = priv->sy0;
+		}
+		return PixelToColor(pixel);
+	}
+	LLDSPEC	void gdisp_lld_read_stop(GDisplay *g) {
+		(void) g;
+	}
+#endif
+
+#if GDISP_HARDWARE_DRAWPIXEL
+	LLDSPEC void gdisp_lld_draw_pixel(GDisplay *g) {
+		xPriv *	priv = (xPriv *)g->priv;
+
+		PutPixel(priv, g->p.x, g->p.y, ColorToPixel(g->p.color));
+		AddDamage(priv, g->p.x, g->p.y, 1, 1);
+	}
+#endif
 
 #if GDISP_HARDWARE_FILLS
 	LLDSPEC void gdisp_lld_fill_area(GDisplay *g) {
-		xPriv *	priv = (xPriv *)g->priv;
-		XColor	col;
-
-		col.red = RED_OF(g->p.color) << 8;
-		col.green = GREEN_OF(g->p.color) << 8;
-		col.blue = BLUE_OF(g->p.color) << 8;
-		XAllocColor(dis, cmap, &col);
-		XSetForeground(dis, priv->gc, col.pixel);
-		XFillRectangle(dis, priv->pix, priv->gc, g->p.x, g->p.y, g->p.cx, g->p.cy);
-		XFillRectangle(dis, priv->win, priv->gc, g->p.x, g->p.y, g->p.cx, g->p.cy);
-		XFlush(dis);
+		xPriv *			priv = (xPriv *)g->priv;
+		unsigned long	pixel;
+		uint32_t *		p;
+		coord_t			x, y;
+
+		pixel = ColorToPixel(g->p.color);
+		if (priv->direct) {
+			for(y = g->p.y; y < g->p.y + g->p.cy; y++) {
+				p = XPIXROW(priv, y) + g->p.x;
+				for(x = 0; x < g->p.cx; x++)
+					p[x] = (uint32_t)pixel;
+			}
+		} else {
+			for(y = g->p.y; y < g->p.y + g->p.cy; y++) {
+				for(x = g->p.x; x < g->p.x + g->p.cx; x++)
+					XPutPixel(priv->img, x, y, pixel);
+			}
+		}
+		AddDamage(priv, g->p.x, g->p.y, g->p.cx, g->p.cy);
 	}
 #endif
 
-#if 0 && GDISP_HARDWARE_BITFILLS
+#if GDISP_HARDWARE_BITFILLS
 	LLDSPEC void gdisp_lld_blit_area(GDisplay *g) {
-		// Start of Bitblit code
-
-		//XImage			bitmap;
-		//pixel_t			*bits;
-		//	bits = malloc(vis.depth * GDISP_SCREEN_WIDTH * GDISP_SCREEN_HEIGHT);
-		//	bitmap = XCreateImage(dis, vis, vis.depth, ZPixmap,
-		//				0, bits, GDISP_SCREEN_WIDTH, GDISP_SCREEN_HEIGHT,
-		//				0, 0);
+		xPriv *			priv = (xPriv *)g->priv;
+		const pixel_t *	buffer;
+		color_t			c;
+		unsigned long	pixel;
+		coord_t			x, y;
+
+		// Make everything relative to the start of the area
+		buffer = (const pixel_t *)g->p.ptr + g->p.y1 * g->p.x2 + g->p.x1;
+
+		// Images tend to have runs of the same color so only convert when it changes
+		c = buffer[0];
+		pixel = ColorToPixel(c);
+		for(y = 0; y < g->p.cy; y++, buffer += g->p.x2) {
+			for(x = 0; x < g->p.cx; x++) {
+				if (buffer[x] != c) {
+					c = buffer[x];
+					pixel = ColorToPixel(c);
+				}
+				PutPixel(priv, g->p.x + x, g->p.y + y, pixel);
+			}
+		}
+		AddDamage(priv, g->p.x, g->p.y, g->p.cx, g->p.cy);
 	}
 #endif
 
 #if GDISP_HARDWARE_PIXELREAD
 	LLDSPEC	color_t gdisp_lld_get_pixel_color(GDisplay *g) {
-		xPriv *	priv = (xPriv *)g->priv;
-		XColor	color;
-		XImage *img;
-
-		img = XGetImage (dis, priv->pix, g->p.x, g->p.y, 1, 1, AllPlanes, XYPixmap);
-		color.pixel = XGetPixel (img, 0, 0);
-		XFree(img);
-		XQueryColor(dis, cmap, &color);
-		return RGB2COLOR(color.red>>8, color.green>>8, color.blue>>8);
+		return PixelToColor(GetPixel((xPriv *)g->priv, g->p.x, g->p.y));
 	}
 #endif
 
 #if GDISP_NEED_SCROLL && GDISP_HARDWARE_SCROLL
 	LLDSPEC void gdisp_lld_vertical_scroll(GDisplay *g) {
-		xPriv *	priv = (xPriv *)g->priv;
+		xPriv *		priv = (xPriv *)g->priv;
+		XImage *	img = priv->img;
+		coord_t		lines, y, x, ysrc, ydst;
+		int			dy;
 
 		if (g->p.y1 > 0) {
-			XCopyArea(dis, priv->pix, priv->pix, priv->gc, g->p.x, g->p.y+g->p.y1, g->p.cx, g->p.cy-g->p.y1, g->p.x, g->p.y);
-			XCopyArea(dis, priv->pix, priv->win, priv->gc, g->p.x, g->p.y, g->p.cx, g->p.cy-g->p.y1, g->p.x, g->p.y);
+			// Move lines up - start at the top
+			lines = g->p.cy - g->p.y1;
+			ydst = g->p.y;
+			ysrc = g->p.y + g->p.y1;
+			dy = 1;
+		} else {
+			// Move lines down - start at the bottom
+			lines = g->p.cy + g->p.y1;
+			ydst = g->p.y + g->p.cy - 1;
+			ysrc = ydst + g->p.y1;
+			dy = -1;
+		}
+
+		if (!(img->bits_per_pixel & 7)) {
+			unsigned	bpp = img->bits_per_pixel >> 3;
+
+			for(y = 0; y < lines; y++, ysrc += dy, ydst += dy)
+				memmove(img->data + ydst * img->bytes_per_line + g->p.x * bpp,
+						img->data + ysrc * img->bytes_per_line + g->p.x * bpp,
+						g->p.cx * bpp);
 		} else {
-			XCopyArea(dis, priv->pix, priv->pix, priv->gc, g->p.x, g->p.y, g->p.cx, g->p.cy+g->p.y1, g->p.x, g->p.y-g->p.y1);
-			XCopyArea(dis, priv->pix, priv->win, priv->gc, g->p.x, g->p.y-g->p.y1, g->p.cx, g->p.cy+g->p.y1, g->p.x, g->p.y-g->p.y1);
+			for(y = 0; y < lines; y++, ysrc += dy, ydst += dy) {
+				for(x = g->p.x; x < g->p.x + g->p.cx; x++)
+					XPutPixel(img, x, ydst, XGetPixel(img, x, ysrc));
+			}
 		}
+
+		if (g->p.y1 > 0)
+			AddDamage(priv, g->p.x, g->p.y, g->p.cx, lines);
+		else
+			AddDamage(priv, g->p.x, g->p.y - g->p.y1, g->p.cx, lines);
 	}
 #endif
 
@@ -194,7 +194,8 @@ void _gadcDeinit(void)
 			pe->type = GEVENT_ADC;
 			pe->flags = (hsFlags & (GADC_HSADC_RUNNING|GADC_HSADC_GOTBUFFER|GADC_HSADC_STALL)) | psl->srcflags;
 			psl->srcflags = 0;
-			geventSendEvent(psl);
+			if (!geventSendEvent(psl))
+				psl->srcflags |= GADC_HSADC_LOSTEVENT;
 		}
 	}
 #endif
@@ -146,7 +146,8 @@ void _gaudioDeinit(void)
 					pe->flags |= GAUDIO_PLAY_PLAYING;
 				if (gfxBufferIsAvailable())
 					pe->flags |= GAUDIO_PLAY_FREEBLOCK;
-				geventSendEvent(psl);
+				if (!geventSendEvent(psl))
+					psl->srcflags |= GAUDIO_PLAY_LOSTEVENT;
 			}
 		}
 
@@ -239,7 +240,8 @@ void _gaudioDeinit(void)
 					pe->flags |= GAUDIO_RECORD_STALL;
 				if (!gfxQueueGSyncIsEmpty(&recordList))
 					pe->flags |= GAUDIO_RECORD_GOTBUFFER;
-				geventSendEvent(psl);
+				if (!geventSendEvent(psl))
+					psl->srcflags |= GAUDIO_RECORD_LOSTEVENT;
 			}
 		}
 
@@ -30,6 +30,10 @@
 
 GDisplay	*GDISP;
 
+#if GDISP_NEED_TEXT && GDISP_NEED_TEXT_GLYPHCACHE && GDISP_NEED_MULTITHREAD
+	static gfxMutex	GlyphCacheMutex;
+#endif
+
 #if GDISP_NEED_MULTITHREAD
 	#define MUTEX_INIT(g)		gfxMutexInit(&(g)->mutex)
 	#define MUTEX_ENTER(g)		gfxMutexEnter(&(g)->mutex)
@@ -545,6 +549,10 @@ static void line_clip(GDisplay *g) {
 
 void _gdispInit(void)
 {
+	#if GDISP_NEED_TEXT && GDISP_NEED_TEXT_GLYPHCACHE && GDISP_NEED_MULTITHREAD
+		gfxMutexInit(&GlyphCacheMutex);
+	#endif
+
 	// GDISP_DRIVER_LIST is defined - create each driver instance
 	#if defined(GDISP_DRIVER_LIST)
 		{
@@ -781,7 +789,7 @@ void gdispGFlush(GDisplay *g) {
 	}
 
 	void gdispGStreamColor(GDisplay *g, color_t color) {
-		#if !GDISP_HARDWARE_STREAM_WRITE && GDISP_LINEBUF_SIZE != 0 && GDISP_HARDWARE_BITFILLS
+		#if GDISP_HARDWARE_STREAM_WRITE != TRUE && GDISP_LINEBUF_SIZE != 0 && GDISP_HARDWARE_BITFILLS
 			coord_t	 sx1, sy1;
 		#endif
 
@@ -1085,9 +1093,8 @@ void gdispGFillArea(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, c
 	MUTEX_EXIT(g);
 }
 
-void gdispGBlitArea(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer) {
-	MUTEX_ENTER(g);
-
+// Blit an area (with clipping). The display must already be locked.
+static void blitarea_clip(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer) {
 	#if NEED_CLIPPING
 		#if GDISP_HARDWARE_CLIP == HARDWARE_AUTODETECT
 			if (!gvmt(g)->setclip)
@@ -1095,11 +1102,11 @@ void gdispGBlitArea(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, c
 		{
 			// This is a different clipping to fillarea(g) as it needs to take into account srcx,srcy
 			if (x < g->clipx0) { cx -= g->clipx0 - x; srcx += g->clipx0 - x; x = g->clipx0; }
-			if (y < g->clipy0) { cy -= g->clipy0 - y; srcy += g->clipy0 - x; y = g->clipy0; }
+			if (y < g->clipy0) { cy -= g->clipy0 - y; srcy += g->clipy0 - y; y = g->clipy0; }
 			if (x+cx > g->clipx1)	cx = g->clipx1 - x;
 			if (y+cy > g->clipy1)	cy = g->clipy1 - y;
 			if (srcx+cx > srccx) cx = srccx - srcx;
-			if (cx <= 0 || cy <= 0) { MUTEX_EXIT(g); return; }
+			if (cx <= 0 || cy <= 0) return;
 		}
 	#endif
 
@@ -1119,7 +1126,6 @@ void gdispGBlitArea(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, c
 			g->p.ptr = (void *)buffer;
 			gdisp_lld_blit_area(g);
 			autoflush_stopdone(g);
-			MUTEX_EXIT(g);
 			return;
 		}
 	#endif
@@ -1155,7 +1161,6 @@ void gdispGBlitArea(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, c
 			}
 			gdisp_lld_write_stop(g);
 			autoflush_stopdone(g);
-			MUTEX_EXIT(g);
 			return;
 		}
 	#endif
@@ -1190,7 +1195,6 @@ void gdispGBlitArea(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, c
 				}
 			}
 			autoflush_stopdone(g);
-			MUTEX_EXIT(g);
 			return;
 		}
 	#endif
@@ -1215,12 +1219,17 @@ void gdispGBlitArea(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, c
 				}
 			}
 			autoflush_stopdone(g);
-			MUTEX_EXIT(g);
 			return;
 		}
 	#endif
 }
 
+void gdispGBlitArea(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer) {
+	MUTEX_ENTER(g);
+	blitarea_clip(g, x, y, cx, cy, srcx, srcy, srccx, buffer);
+	MUTEX_EXIT(g);
+}
+
 #if GDISP_NEED_CLIP || GDISP_NEED_VALIDATION
 	void gdispGSetClip(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy) {
 		MUTEX_ENTER(g);
@@ -3246,9 +3255,115 @@ void gdispGDrawBox(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, co
 #if GDISP_NEED_TEXT
 	#include "mcufont/mcufont.h"
 
-	#if GDISP_NEED_ANTIALIAS && GDISP_HARDWARE_PIXELREAD
+	// Can we blend anti-aliased text with what is already on the display
+	#define DRAWCHAR_BLEND		(GDISP_NEED_ANTIALIAS && (GDISP_HARDWARE_PIXELREAD || GDISP_HARDWARE_STREAM_READ))
+
+	#if DRAWCHAR_BLEND
+		/**
+		 * Partially covered pixels are collected a row at a time. The row is then read from the display,
+		 * blended in RAM and written back with a single blit rather than reading and writing each pixel.
+		 */
+		typedef struct charspan {
+			coord_t		x, y;								// The position of the first pixel
+			coord_t		cx;									// The number of pixels (0 = empty)
+			uint8_t		alpha[GDISP_TEXT_AA_SPAN_SIZE];
+			color_t		buf[GDISP_TEXT_AA_SPAN_SIZE];
+		} charspan;
+
+		static bool_t readcharspan(GDisplay *g, coord_t x0, coord_t x1) {
+			charspan	*ps;
+			coord_t		i;
+
+			ps = g->t.span;
+
+			// Best is one stream for the whole row
+			#if GDISP_HARDWARE_STREAM_READ
+				#if GDISP_HARDWARE_STREAM_READ == HARDWARE_AUTODETECT
+					if (gvmt(g)->readcolor)
+				#endif
+				{
+					g->p.x = x0;
+					g->p.y = ps->y;
+					g->p.cx = x1 - x0;
+					g->p.cy = 1;
+					gdisp_lld_read_start(g);
+					for(i = x0 - ps->x; i < x1 - ps->x; i++)
+						ps->buf[i] = gdisp_lld_read_color(g);
+					gdisp_lld_read_stop(g);
+					return TRUE;
+				}
+			#endif
+
+			// Next best is single pixel reads
+			#if GDISP_HARDWARE_STREAM_READ != TRUE && GDISP_HARDWARE_PIXELREAD
+				#if GDISP_HARDWARE_PIXELREAD == HARDWARE_AUTODETECT
+					if (gvmt(g)->get)
+				#endif
+				{
+					g->p.y = ps->y;
+					for(i = x0 - ps->x, g->p.x = x0; g->p.x < x1; g->p.x++, i++)
+						ps->buf[i] = gdisp_lld_get_pixel_color(g);
+					return TRUE;
+				}
+			#endif
+
+			// Worst is "not possible"
+			#if GDISP_HARDWARE_STREAM_READ != TRUE && GDISP_HARDWARE_PIXELREAD != TRUE
+				return FALSE;
+			#endif
+		}
+
+		static void drawcharspan(GDisplay *g) {
+			charspan	*ps;
+			coord_t		x0, x1, cx, i;
+
+			ps = g->t.span;
+			if (!(cx = ps->cx))
+				return;
+			ps->cx = 0;
+			x0 = ps->x;
+			x1 = ps->x + cx;
+
+			// Don't read outside the display
+			#if NEED_CLIPPING
+				#if GDISP_HARDWARE_CLIP == HARDWARE_AUTODETECT
+					if (!gvmt(g)->setclip)
+				#endif
+				{
+					if (ps->y < g->clipy0 || ps->y >= g->clipy1)
+						return;
+					if (x0 < g->clipx0)	x0 = g->clipx0;
+					if (x1 > g->clipx1)	x1 = g->clipx1;
+					if (x0 >= x1)
+						return;
+				}
+			#endif
+
+			// Read the existing pixels. If this display can't then draw it as if it wasn't blended.
+			if (!readcharspan(g, x0, x1)) {
+				g->p.y = ps->y;
+				g->p.color = g->t.color;
+				for(i = x0 - ps->x, g->p.x = x0; g->p.x < x1; g->p.x++, i++) {
+					if (ps->alpha[i] > 0x80)
+						drawpixel_clip(g);
+				}
+				return;
+			}
+
+			// Blend and write them back
+			for(i = x0 - ps->x; i < x1 - ps->x; i++) {
+				if (ps->alpha[i] == 255)
+					ps->buf[i] = g->t.color;
+				else if (ps->alpha[i])
+					ps->buf[i] = gdispBlendColor(g->t.color, ps->buf[i], ps->alpha[i]);
+			}
+			blitarea_clip(g, x0, ps->y, x1-x0, 1, x0-ps->x, 0, cx, ps->buf);
+		}
+
 		static void drawcharline(int16_t x, int16_t y, uint8_t count, uint8_t alpha, void *state) {
 			#define GD	((GDisplay *)state)
+			charspan	*ps;
+
 			if (y < GD->t.clipy0 || y >= GD->t.clipy1 || x+count <= GD->t.clipx0 || x >= GD->t.clipx1)
 				return;
 			if (x < GD->t.clipx0) {
@@ -3257,15 +3372,31 @@ void gdispGDrawBox(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, co
 			}
 			if (x+count > GD->t.clipx1)
 				count = GD->t.clipx1 - x;
-			if (alpha == 255) {
+
+			ps = GD->t.span;
+
+			// Solid runs don't need blending. Only add them to a row that is already being blended.
+			if (alpha == 255 && (!ps->cx || ps->y != y)) {
+				drawcharspan(GD);
 				GD->p.x = x; GD->p.y = y; GD->p.x1 = x+count-1; GD->p.color = GD->t.color;
 				hline_clip(GD);
-			} else {
-				for (; count; count--, x++) {
-					GD->p.x = x; GD->p.y = y;
-					GD->p.color = gdispBlendColor(GD->t.color, gdisp_lld_get_pixel_color(GD), alpha);
-					drawpixel_clip(GD);
+				return;
+			}
+
+			while(count) {
+				// Start a new span if this doesn't follow on from the current one
+				if (ps->cx && (ps->y != y || x < ps->x+ps->cx || x >= ps->x+GDISP_TEXT_AA_SPAN_SIZE))
+					drawcharspan(GD);
+				if (!ps->cx) {
+					ps->x = x;
+					ps->y = y;
 				}
+
+				// Skipped pixels are left unchanged
+				for(; ps->cx < x - ps->x; ps->cx++)
+					ps->alpha[ps->cx] = 0;
+				for(; count && ps->cx < GDISP_TEXT_AA_SPAN_SIZE; count--, x++)
+					ps->alpha[ps->cx++] = alpha;
 			}
 			#undef GD
 		}
@@ -3315,13 +3446,216 @@ void gdispGDrawBox(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, co
 	/* Callback to render characters. */
 	static uint8_t drawcharglyph(int16_t x, int16_t y, mf_char ch, void *state) {
 		#define GD	((GDisplay *)state)
+		#if DRAWCHAR_BLEND
+			charspan	span;
+			uint8_t		width;
+
+			span.cx = 0;
+			GD->t.span = &span;
+			width = mf_render_character(GD->t.font, x, y, ch, drawcharline, state);
+			drawcharspan(GD);
+			return width;
+		#else
 			return mf_render_character(GD->t.font, x, y, ch, drawcharline, state);
+		#endif
 		#undef GD
 	}
 
+	#if GDISP_NEED_TEXT_GLYPHCACHE
+		/**
+		 * A rendered glyph for filled text.
+		 * The ink bounding box of the glyph is pre-rendered in the foreground and background colors
+		 * so that drawing it again is a single blit.
+		 */
+		typedef struct glyphcache {
+			struct glyphcache *	next;				// The next entry (the list is in most recently used order)
+			size_t				size;				// The size of this entry including the pixels
+			font_t				font;
+			color_t				color;
+			color_t				bgcolor;
+			uint16_t			ch;
+			uint8_t				width;				// The character width returned by the renderer
+			coord_t				x, y, cx, cy;		// The ink bounding box relative to the character position
+			// The cx * cy pixels follow
+		} glyphcache;
+
+		static glyphcache *	GlyphCache;
+		static size_t		GlyphCacheSize;
+
+		// Forget where the previous character was drawn
+		#define RESET_GLYPH_INK(g)		{ (g)->t.inkx0 = (g)->t.inkx1 = (g)->t.inky0 = (g)->t.inky1 = 0; }
+
+		// Which pixels fillcharline() changes
+		#if GDISP_NEED_ANTIALIAS
+			#define GLYPH_INK(alpha)		((alpha) != 0)
+		#else
+			#define GLYPH_INK(alpha)		((alpha) > 0x80)
+		#endif
+
+		// Find the ink bounding box of a glyph. The state is a coord_t[4] of x0, y0, x1, y1.
+		static void glyphbbox(int16_t x, int16_t y, uint8_t count, uint8_t alpha, void *state) {
+			#define BB	((coord_t *)state)
+			if (!count || !GLYPH_INK(alpha))
+				return;
+			if (x < BB[0])			BB[0] = x;
+			if (y < BB[1])			BB[1] = y;
+			if (x+count > BB[2])	BB[2] = x+count;
+			if (y+1 > BB[3])		BB[3] = y+1;
+			#undef BB
+		}
+
+		// Render a glyph into a cache entry
+		static void glyphrender(int16_t x, int16_t y, uint8_t count, uint8_t alpha, void *state) {
+			#define GC	((glyphcache *)state)
+			pixel_t		*p;
+			color_t		c;
+
+			if (!GLYPH_INK(alpha))
+				return;
+			#if GDISP_NEED_ANTIALIAS
+				c = alpha == 255 ? GC->color : gdispBlendColor(GC->color, GC->bgcolor, alpha);
+			#else
+				c = GC->color;
+			#endif
+			for(p = (pixel_t *)(GC+1) + (y - GC->y) * GC->cx + (x - GC->x); count; count--)
+				*p++ = c;
+			#undef GC
+		}
+
+		// Get the cache entry for a character in the current text colors. It becomes the most recently used entry.
+		// Returns NULL if the glyph can't be cached.
+		static glyphcache *getcachedglyph(GDisplay *g, mf_char ch) {
+			glyphcache	*gc, **pgc, **plast;
+			coord_t		bb[4];
+			pixel_t		*p;
+			size_t		sz;
+			uint8_t		width;
+
+			// Look for it
+			for(pgc = &GlyphCache; (gc = *pgc); pgc = &gc->next) {
+				if (gc->ch == ch && gc->font == g->t.font && gc->color == g->t.color && gc->bgcolor == g->t.bgcolor) {
+					*pgc = gc->next;
+					gc->next = GlyphCache;
+					GlyphCache = gc;
+					return gc;
+				}
+			}
+
+			// Find the ink bounding box
+			bb[0] = bb[1] = 32767;
+			bb[2] = bb[3] = -32768;
+			width = mf_render_character(g->t.font, 0, 0, ch, glyphbbox, bb);
+			if (bb[0] >= bb[2])
+				bb[0] = bb[1] = bb[2] = bb[3] = 0;			// No ink (eg. a space)
+			sz = sizeof(glyphcache) + (size_t)(bb[2]-bb[0]) * (bb[3]-bb[1]) * sizeof(pixel_t);
+			if (sz > GDISP_TEXT_GLYPHCACHE_SIZE)
+				return 0;
+
+			// Make room by throwing away the least recently used entries
+			while (GlyphCache && GlyphCacheSize + sz > GDISP_TEXT_GLYPHCACHE_SIZE) {
+				for(plast = &GlyphCache; (*plast)->next; plast = &(*plast)->next);
+				GlyphCacheSize -= (*plast)->size;
+				gfxFree(*plast);
+				*plast = 0;
+			}
+			if (!(gc = gfxAlloc(sz)))
+				return 0;
+
+			// Render it
+			gc->size = sz;
+			gc->font = g->t.font;
+			gc->color = g->t.color;
+			gc->bgcolor = g->t.bgcolor;
+			gc->ch = ch;
+			gc->width = width;
+			gc->x = bb[0];
+			gc->y = bb[1];
+			gc->cx = bb[2] - bb[0];
+			gc->cy = bb[3] - bb[1];
+			for(p = (pixel_t *)(gc+1), sz = gc->cx * gc->cy; sz; sz--)
+				*p++ = gc->bgcolor;
+			mf_render_character(g->t.font, 0, 0, ch, glyphrender, gc);
+
+			gc->next = GlyphCache;
+			GlyphCache = gc;
+			GlyphCacheSize += gc->size;
+			return gc;
+		}
+
+		void _gdispFlushGlyphCache(font_t font) {
+			glyphcache	*gc, **pgc;
+
+			#if GDISP_NEED_MULTITHREAD
+				gfxMutexEnter(&GlyphCacheMutex);
+			#endif
+			for(pgc = &GlyphCache; (gc = *pgc);) {
+				if (!font || gc->font == font) {
+					*pgc = gc->next;
+					GlyphCacheSize -= gc->size;
+					gfxFree(gc);
+				} else
+					pgc = &gc->next;
+			}
+			#if GDISP_NEED_MULTITHREAD
+				gfxMutexExit(&GlyphCacheMutex);
+			#endif
+		}
+	#else
+		#define RESET_GLYPH_INK(g)
+	#endif
+
 	/* Callback to render characters. */
 	static uint8_t fillcharglyph(int16_t x, int16_t y, mf_char ch, void *state) {
 		#define GD	((GDisplay *)state)
+		#if GDISP_NEED_TEXT_GLYPHCACHE
+			glyphcache	*gc;
+			coord_t		x0, y0, x1, y1;
+			uint8_t		width;
+
+			#if GDISP_NEED_MULTITHREAD
+				gfxMutexEnter(&GlyphCacheMutex);
+			#endif
+			if ((gc = getcachedglyph(GD, ch))) {
+				width = gc->width;
+				if (gc->cx) {
+					x0 = x + gc->x;
+					y0 = y + gc->y;
+					x1 = x0 + gc->cx;
+					y1 = y0 + gc->cy;
+
+					// The blit also draws the background around the ink. If that would overwrite the ink of the
+					// previous (eg. kerned) character render the character normally instead.
+					if (x0 < GD->t.inkx1 && x1 > GD->t.inkx0 && y0 < GD->t.inky1 && y1 > GD->t.inky0) {
+						mf_render_character(GD->t.font, x, y, ch, fillcharline, state);
+					} else {
+						// Clip to the text area
+						if (x0 < GD->t.clipx0)	x0 = GD->t.clipx0;
+						if (y0 < GD->t.clipy0)	y0 = GD->t.clipy0;
+						if (x1 > GD->t.clipx1)	x1 = GD->t.clipx1;
+						if (y1 > GD->t.clipy1)	y1 = GD->t.clipy1;
+						if (x0 < x1 && y0 < y1)
+							blitarea_clip(GD, x0, y0, x1-x0, y1-y0, x0-(x+gc->x), y0-(y+gc->y), gc->cx, (pixel_t *)(gc+1));
+					}
+					GD->t.inkx0 = x + gc->x;
+					GD->t.inky0 = y + gc->y;
+					GD->t.inkx1 = GD->t.inkx0 + gc->cx;
+					GD->t.inky1 = GD->t.inky0 + gc->cy;
+				}
+				#if GDISP_NEED_MULTITHREAD
+					gfxMutexExit(&GlyphCacheMutex);
+				#endif
+				return width;
+			}
+			#if GDISP_NEED_MULTITHREAD
+				gfxMutexExit(&GlyphCacheMutex);
+			#endif
+
+			// We don't know where the ink is - assume the whole character cell
+			GD->t.inkx0 = x;
+			GD->t.inky0 = y;
+			GD->t.inkx1 = x + GD->t.font->width;
+			GD->t.inky1 = y + GD->t.font->height;
+		#endif
 			return mf_render_character(GD->t.font, x, y, ch, fillcharline, state);
 		#undef GD
 	}
@@ -3361,7 +3695,7 @@ void gdispGDrawBox(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, co
 		g->t.clipx1 = x + mf_character_width(font, c) + font->baseline_x;
 		g->t.clipy1 = y + font->height;
 		g->t.color = color;
-		mf_render_character(font, x, y, c, drawcharline, g);
+		drawcharglyph(x, y, c, g);
 		autoflush(g);
 		MUTEX_EXIT(g);
 	}
@@ -3382,7 +3716,8 @@ void gdispGDrawBox(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, co
 
 		TEST_CLIP_AREA(g) {
 			fillarea(g);
-			mf_render_character(font, x, y, c, fillcharline, g);
+			RESET_GLYPH_INK(g);
+			fillcharglyph(x, y, c, g);
 		}
 		autoflush(g);
 		MUTEX_EXIT(g);
@@ -3420,6 +3755,7 @@ void gdispGDrawBox(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, co
 
 		TEST_CLIP_AREA(g) {
 			fillarea(g);
+			RESET_GLYPH_INK(g);
 			mf_render_aligned(font, x+font->baseline_x, y, MF_ALIGN_LEFT, str, 0, fillcharglyph, g);
 		}
 
@@ -3580,6 +3916,7 @@ void gdispGDrawBox(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, co
 			g->t.font = font;
 			g->t.color = color;
 			g->t.bgcolor = bgcolor;
+			RESET_GLYPH_INK(g);
 			#if GDISP_NEED_TEXT_WORDWRAP
 				if (!(justify & justifyNoWordWrap)) {
 					g->t.lrj = (justify & JUSTIFYMASK_LEFTRIGHT);
@@ -1235,6 +1235,9 @@ void gdispGDrawBox(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, co
 #if GDISP_NEED_PIXMAP || defined(__DOXYGEN__)
 	#include "gdisp_pixmap.h"
 #endif
+#if GDISP_NEED_REGIONS || defined(__DOXYGEN__)
+	#include "gdisp_region.h"
+#endif
 
 
 #endif /* GFX_USE_GDISP */
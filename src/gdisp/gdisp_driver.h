@@ -224,7 +224,7 @@
 //------------------------------------------------------------------------------------------------------------
 
 // For pixmaps certain routines MUST not be FALSE as they are needed for pixmap drawing
-//	Similarly some routines MUST not be TRUE as pixmap's don't provide them.
+//	(or because the pixmap accelerates them). Similarly some routines MUST not be TRUE as pixmap's don't provide them.
 #if GDISP_NEED_PIXMAP && !IN_DRIVER
 	#if !GDISP_HARDWARE_DEINIT
 		#undef GDISP_HARDWARE_DEINIT
@@ -242,34 +242,34 @@
 		#undef GDISP_HARDWARE_CONTROL
 		#define GDISP_HARDWARE_CONTROL		HARDWARE_AUTODETECT
 	#endif
-	#if GDISP_HARDWARE_FLUSH == TRUE
-		#undef GDISP_HARDWARE_FLUSH
-		#define GDISP_HARDWARE_FLUSH		HARDWARE_AUTODETECT
-	#endif
-	#if GDISP_HARDWARE_STREAM_WRITE == TRUE
+	#if !GDISP_HARDWARE_STREAM_WRITE
 		#undef GDISP_HARDWARE_STREAM_WRITE
 		#define GDISP_HARDWARE_STREAM_WRITE	HARDWARE_AUTODETECT
 	#endif
-	#if GDISP_HARDWARE_STREAM_READ == TRUE
+	#if !GDISP_HARDWARE_STREAM_READ
 		#undef GDISP_HARDWARE_STREAM_READ
 		#define GDISP_HARDWARE_STREAM_READ	HARDWARE_AUTODETECT
 	#endif
-	#if GDISP_HARDWARE_CLEARS == TRUE
-		#undef GDISP_HARDWARE_CLEARS
-		#define GDISP_HARDWARE_CLEARS		HARDWARE_AUTODETECT
-	#endif
-	#if GDISP_HARDWARE_FILLS == TRUE
+	#if !GDISP_HARDWARE_FILLS
 		#undef GDISP_HARDWARE_FILLS
 		#define GDISP_HARDWARE_FILLS		HARDWARE_AUTODETECT
 	#endif
-	#if GDISP_HARDWARE_BITFILLS == TRUE
+	#if !GDISP_HARDWARE_BITFILLS
 		#undef GDISP_HARDWARE_BITFILLS
 		#define GDISP_HARDWARE_BITFILLS		HARDWARE_AUTODETECT
 	#endif
-	#if GDISP_HARDWARE_SCROLL == TRUE
+	#if !GDISP_HARDWARE_SCROLL
 		#undef GDISP_HARDWARE_SCROLL
 		#define GDISP_HARDWARE_SCROLL		HARDWARE_AUTODETECT
 	#endif
+	#if GDISP_HARDWARE_FLUSH == TRUE
+		#undef GDISP_HARDWARE_FLUSH
+		#define GDISP_HARDWARE_FLUSH		HARDWARE_AUTODETECT
+	#endif
+	#if GDISP_HARDWARE_CLEARS == TRUE
+		#undef GDISP_HARDWARE_CLEARS
+		#define GDISP_HARDWARE_CLEARS		HARDWARE_AUTODETECT
+	#endif
 	#if GDISP_HARDWARE_QUERY == TRUE
 		#undef GDISP_HARDWARE_QUERY
 		#define GDISP_HARDWARE_QUERY		HARDWARE_AUTODETECT
@@ -371,9 +371,16 @@ struct GDisplay {
 				coord_t		wrapx, wrapy;
 				justify_t	lrj;
 			#endif
+			#if GDISP_NEED_ANTIALIAS
+				struct charspan	*span;			// The pixels waiting to be blended
+			#endif
+			#if GDISP_NEED_TEXT_GLYPHCACHE
+				coord_t		inkx0, inky0;		// Where the previous character was drawn
+				coord_t		inkx1, inky1;
+			#endif
 		} t;
 	#endif
-	#if GDISP_LINEBUF_SIZE != 0 && ((GDISP_NEED_SCROLL && !GDISP_HARDWARE_SCROLL) || (!GDISP_HARDWARE_STREAM_WRITE && GDISP_HARDWARE_BITFILLS))
+	#if GDISP_LINEBUF_SIZE != 0 && ((GDISP_NEED_SCROLL && GDISP_HARDWARE_SCROLL != TRUE) || (GDISP_HARDWARE_STREAM_WRITE != TRUE && GDISP_HARDWARE_BITFILLS))
 		// A pixel line buffer
 		color_t		linebuf[GDISP_LINEBUF_SIZE];
 	#endif
@@ -16,6 +16,10 @@
 
 static const struct mf_font_list_s *fontList;
 
+#if GDISP_NEED_TEXT_GLYPHCACHE
+	extern void _gdispFlushGlyphCache(font_t font);
+#endif
+
 /**
  * Match a pattern against the font name.
  */
@@ -68,6 +72,11 @@ void gdispCloseFont(font_t font) {
 	if ((font->flags & (FONT_FLAG_DYNAMIC|FONT_FLAG_UNLISTED)) == (FONT_FLAG_DYNAMIC|FONT_FLAG_UNLISTED)) {
 		/* Make sure that no-one can successfully use font after closing */
 		((struct mf_font_s *)font)->render_character = 0;
+
+		/* The memory may be reused for another font so forget any cached characters */
+		#if GDISP_NEED_TEXT_GLYPHCACHE
+			_gdispFlushGlyphCache(font);
+		#endif
 		
 		/* Release the allocated memory */
 		gfxFree((void *)font);
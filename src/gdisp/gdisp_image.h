@@ -283,7 +283,25 @@ extern "C" {
 	 * @note	This function will return @p FALSE if the index is out of bounds or if the image doesn't use a color palette.
 	 */
 	bool_t gdispImageAdjustPalette(gdispImage *img, uint16_t index, color_t newColor);
-	
+
+	#if GDISP_NEED_IMAGE_JPG || defined(__DOXYGEN__)
+		/**
+		 * @brief	Set the scale a JPG image is decoded at.
+		 * @return	GDISP_IMAGE_ERR_OK (0) on success or an error code.
+		 *
+		 * @param[in] img		The image structure
+		 * @param[in] scale		The divisor for the image size. Must be 1, 2, 4 or 8.
+		 *
+		 * @pre		gdispImageOpen() must have returned successfully.
+		 * @note	Scaled decoding uses a reduced size inverse DCT so it is much faster
+		 * 			than decoding at full size and needs less RAM.
+		 * @note	The image width and height are updated to the scaled size. All drawing
+		 * 			coordinates are then relative to the scaled image.
+		 * @note	This returns GDISP_IMAGE_ERR_BADFORMAT if the image is not a JPG image.
+		 */
+		gdispImageError gdispImageSetJPGScale(gdispImage *img, uint8_t scale);
+	#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,6 +11,20 @@
 
 #include "gdisp_image_support.h"
 
+#if (GDISP_NEED_IMAGE_BMP_4_RLE || GDISP_NEED_IMAGE_BMP_8_RLE) && GDISP_IMAGE_BMP_RLE_INDEX_ROWS > 0
+	#define BMP_RLE_INDEX		TRUE
+
+	// The RLE decoder state at the start of a bitmap row
+	typedef struct BMPRowIndex {
+		size_t		pos;
+		uint16_t	rlerun;
+		uint8_t		rlecode;
+		uint8_t		rleflags;
+		} BMPRowIndex;
+#else
+	#define BMP_RLE_INDEX		FALSE
+#endif
+
 typedef struct gdispImagePrivate_BMP {
 	uint8_t		bmpflags;
 		#define BMP_V2				0x01		// Version 2 (old) header format
@@ -30,6 +44,10 @@ typedef struct gdispImagePrivate_BMP {
 	uint16_t	rlerun;
 	uint8_t		rlecode;
 #endif
+#if BMP_RLE_INDEX
+	BMPRowIndex	*rowindex;				// One entry every GDISP_IMAGE_BMP_RLE_INDEX_ROWS bitmap rows
+	coord_t		rowindexcnt;			// The number of valid entries
+#endif
 #if GDISP_NEED_IMAGE_BMP_16 || GDISP_NEED_IMAGE_BMP_32
 	int8_t		shiftred;
 	int8_t		shiftgreen;
@@ -56,6 +74,10 @@ void gdispImageClose_BMP(gdispImage *img) {
 #endif
 		if (priv->frame0cache)
 			gdispImageFree(img, (void *)priv->frame0cache, img->width*img->height*sizeof(pixel_t));
+#if BMP_RLE_INDEX
+		if (priv->rowindex)
+			gdispImageFree(img, (void *)priv->rowindex, ((img->height+GDISP_IMAGE_BMP_RLE_INDEX_ROWS-1)/GDISP_IMAGE_BMP_RLE_INDEX_ROWS)*sizeof(BMPRowIndex));
+#endif
 		gdispImageFree(img, (void *)priv, sizeof(gdispImagePrivate_BMP));
 		img->priv = 0;
 	}
@@ -92,6 +114,10 @@ gdispImageError gdispImageOpen_BMP(gdispImage *img) {
 	priv = (gdispImagePrivate_BMP *)img->priv;
 	priv->frame0cache = 0;
 	priv->bmpflags = 0;
+#if BMP_RLE_INDEX
+	priv->rowindex = 0;
+	priv->rowindexcnt = 0;
+#endif
 #if GDISP_NEED_IMAGE_BMP_1 || GDISP_NEED_IMAGE_BMP_4 || GDISP_NEED_IMAGE_BMP_4_RLE || GDISP_NEED_IMAGE_BMP_8 || GDISP_NEED_IMAGE_BMP_8_RLE
 	priv->palette = 0;
 #endif
@@ -101,9 +127,10 @@ gdispImageError gdispImageOpen_BMP(gdispImage *img) {
 		goto baddatacleanup;
 
 	/* Get the offset to the bitmap data */
-	if (gfileRead(img->f, &priv->frame0pos, 4) != 4)
+	if (gfileRead(img->f, &adword, 4) != 4)
 		goto baddatacleanup;
-	gdispImageMakeLE32(priv->frame0pos);
+	gdispImageMakeLE32(adword);
+	priv->frame0pos = adword;
 
 	/* Process the BITMAPCOREHEADER structure */
 
@@ -714,6 +741,7 @@ gdispImageError gdispImageCache_BMP(gdispImage *img) {
 #if GDISP_NEED_IMAGE_BMP_4_RLE || GDISP_NEED_IMAGE_BMP_8_RLE
 	priv->rlerun = 0;
 	priv->rlecode = 0;
+	priv->bmpflags &= ~(BMP_RLE_ENC|BMP_RLE_ABS);
 #endif
 
 	pcs = priv->buf;				// This line is just to prevent a compiler warning.
@@ -749,11 +777,34 @@ gdispImageError gdispImageCache_BMP(gdispImage *img) {
 	return GDISP_IMAGE_ERR_OK;
 }
 
-gdispImageError gdispGImageDraw_BMP(GDisplay *g, gdispImage *img, coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t sx, coord_t sy) {
+/* Decode a bitmap row from pixel mx up to mxend and draw the part within sx to sx+cx at display row y (if g is not NULL) */
+static bool_t drawRow(GDisplay *g, gdispImage *img, coord_t x, coord_t y, coord_t sx, coord_t cx, coord_t mx, coord_t mxend) {
 	gdispImagePrivate_BMP *	priv;
-	coord_t				mx, my;
 	coord_t				pos, len, st;
 
+	priv = (gdispImagePrivate_BMP *)img->priv;
+	while(mx < mxend) {
+		if (!(pos = getPixels(img, mx)))
+			return FALSE;
+		if (g && mx < sx+cx && mx+pos > sx) {
+			st = mx < sx ? sx - mx : 0;
+			len = pos-st;
+			if (mx+st+len > sx+cx) len = sx+cx-mx-st;
+			if (len == 1)
+				gdispGDrawPixel(g, x+mx+st-sx, y, priv->buf[st]);
+			else
+				gdispGBlitArea(g, x+mx+st-sx, y, len, 1, st, 0, pos, priv->buf);
+		}
+		mx += pos;
+	}
+	return TRUE;
+}
+
+gdispImageError gdispGImageDraw_BMP(GDisplay *g, gdispImage *img, coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t sx, coord_t sy) {
+	gdispImagePrivate_BMP *	priv;
+	coord_t				my, mx, fr;
+	size_t				stride;
+
 	priv = (gdispImagePrivate_BMP *)img->priv;
 
 	/* Check some reasonableness */
@@ -767,49 +818,81 @@ gdispImageError gdispGImageDraw_BMP(GDisplay *g, gdispImage *img, coord_t x, coo
 		return GDISP_IMAGE_ERR_OK;
 	}
 
-	/* Start decoding from the beginning */
-	gfileSetPos(img->f, priv->frame0pos);
 #if GDISP_NEED_IMAGE_BMP_4_RLE || GDISP_NEED_IMAGE_BMP_8_RLE
-	priv->rlerun = 0;
-	priv->rlecode = 0;
-#endif
+	/* RLE rows have no fixed position - decode from the start (or the nearest indexed row) to the last row we need */
+	if (priv->bmpflags & BMP_COMP_RLE) {
+		coord_t		fr0, fr1;
+
+		/* The range of bitmap rows (in file order) that we need */
+		if (priv->bmpflags & BMP_TOP_TO_BOTTOM) {
+			fr0 = sy;
+			fr1 = sy+cy-1;
+		} else {
+			fr0 = img->height-sy-cy;
+			fr1 = img->height-1-sy;
+		}
 
-	if (priv->bmpflags & BMP_TOP_TO_BOTTOM) {
-		for(my = 0; my < img->height; my++) {
-			mx = 0;
-			while(mx < img->width) {
-				if (!(pos = getPixels(img, mx)))
-					return GDISP_IMAGE_ERR_BADDATA;
-				if (my >= sy && my < sy+cy && mx < sx+cx && mx+pos >= sx) {
-					st = mx < sx ? sx - mx : 0;
-					len = pos-st;
-					if (mx+st+len > sx+cx) len = sx+cx-mx-st;
-					if (len == 1)
-						gdispGDrawPixel(g, x+mx+st-sx, y+my-sy, priv->buf[st]);
-					else
-						gdispGBlitArea(g, x+mx+st-sx, y+my-sy, len, 1, st, 0, pos, priv->buf);
-				}
-				mx += pos;
+		fr = 0;
+		gfileSetPos(img->f, priv->frame0pos);
+		priv->rlerun = 0;
+		priv->rlecode = 0;
+		priv->bmpflags &= ~(BMP_RLE_ENC|BMP_RLE_ABS);
+
+		#if BMP_RLE_INDEX
+			if (!priv->rowindex) {
+				priv->rowindex = (BMPRowIndex *)gdispImageAlloc(img, ((img->height+GDISP_IMAGE_BMP_RLE_INDEX_ROWS-1)/GDISP_IMAGE_BMP_RLE_INDEX_ROWS)*sizeof(BMPRowIndex));
+				priv->rowindexcnt = 0;
 			}
-		}
-	} else {
-		for(my = img->height-1; my >= 0; my--) {
-			mx = 0;
-			while(mx < img->width) {
-				if (!(pos = getPixels(img, mx)))
-					return GDISP_IMAGE_ERR_BADDATA;
-				if (my >= sy && my < sy+cy && mx < sx+cx && mx+pos >= sx) {
-					st = mx < sx ? sx - mx : 0;
-					len = pos-st;
-					if (mx+st+len > sx+cx) len = sx+cx-mx-st;
-					if (len == 1)
-						gdispGDrawPixel(g, x+mx+st-sx, y+my-sy, priv->buf[st]);
-					else
-						gdispGBlitArea(g, x+mx+st-sx, y+my-sy, len, 1, st, 0, pos, priv->buf);
-				}
-				mx += pos;
+			if (priv->rowindex && priv->rowindexcnt) {
+				BMPRowIndex	*pi;
+
+				/* Resume from the nearest indexed row at or before the first row we need */
+				my = fr0 / GDISP_IMAGE_BMP_RLE_INDEX_ROWS;
+				if (my >= priv->rowindexcnt)
+					my = priv->rowindexcnt-1;
+				pi = priv->rowindex + my;
+				fr = my * GDISP_IMAGE_BMP_RLE_INDEX_ROWS;
+				gfileSetPos(img->f, pi->pos);
+				priv->rlerun = pi->rlerun;
+				priv->rlecode = pi->rlecode;
+				priv->bmpflags |= pi->rleflags;
 			}
+		#endif
+
+		for(; fr <= fr1; fr++) {
+			#if BMP_RLE_INDEX
+				/* Remember the decoder state as we pass an index row for the first time */
+				if (priv->rowindex && fr == priv->rowindexcnt * GDISP_IMAGE_BMP_RLE_INDEX_ROWS) {
+					BMPRowIndex	*pi;
+
+					pi = priv->rowindex + priv->rowindexcnt++;
+					pi->pos = gfileGetPos(img->f);
+					pi->rlerun = priv->rlerun;
+					pi->rlecode = priv->rlecode;
+					pi->rleflags = priv->bmpflags & (BMP_RLE_ENC|BMP_RLE_ABS);
+				}
+			#endif
+			my = (priv->bmpflags & BMP_TOP_TO_BOTTOM) ? fr : img->height-1-fr;
+			if (!drawRow(fr >= fr0 ? g : 0, img, x, y+my-sy, sx, cx, 0, img->width))
+				return GDISP_IMAGE_ERR_BADDATA;
 		}
+		return GDISP_IMAGE_ERR_OK;
+	}
+#endif
+
+	/* Uncompressed rows are a fixed number of 32 bit words so we can seek straight to the pixels we need */
+	stride = (((size_t)img->width * priv->bitsperpixel + 31) >> 5) << 2;
+
+	/* getPixels() reads less than 24 bits per pixel in whole 32 bit words */
+	mx = sx;
+	if (priv->bitsperpixel < 24)
+		mx -= sx % (32 / priv->bitsperpixel);
+
+	for(my = sy; my < sy+cy; my++) {
+		fr = (priv->bmpflags & BMP_TOP_TO_BOTTOM) ? my : img->height-1-my;
+		gfileSetPos(img->f, priv->frame0pos + fr*stride + ((size_t)mx * priv->bitsperpixel >> 3));
+		if (!drawRow(g, img, x, y+my-sy, sx, cx, mx, sx+cx))
+			return GDISP_IMAGE_ERR_BADDATA;
 	}
 
 	return GDISP_IMAGE_ERR_OK;
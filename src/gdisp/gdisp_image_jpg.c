@@ -11,6 +11,1247 @@
 
 #include "gdisp_image_support.h"
 
-#error "JPG support not implemented yet"
+#include <string.h>
+
+/*-----------------------------------------------------------------
+ * Structure definitions
+ *---------------------------------------------------------------*/
+
+#define JPG_MAX_COMPONENTS		3			// We support grayscale and YCbCr images
+#define JPG_MAX_BLOCKS			10			// The maximum number of blocks in an MCU
+#define JPG_MAX_TABLES			4			// The maximum number of huffman tables (of each type) and quantization tables
+#define JPG_HUFF_FAST_BITS		8			// The number of bits decoded by the huffman lookup table
+
+// JPG markers
+#define JPG_MARKER_SOF0			0xC0		// Baseline
+#define JPG_MARKER_SOF1			0xC1		// Extended sequential
+#define JPG_MARKER_SOF2			0xC2		// Progressive
+#define JPG_MARKER_DHT			0xC4		// Define huffman tables
+#define JPG_MARKER_RST0			0xD0		// Restart markers RST0 to RST7
+#define JPG_MARKER_RST7			0xD7
+#define JPG_MARKER_SOI			0xD8		// Start of image
+#define JPG_MARKER_EOI			0xD9		// End of image
+#define JPG_MARKER_SOS			0xDA		// Start of scan
+#define JPG_MARKER_DQT			0xDB		// Define quantization tables
+#define JPG_MARKER_DRI			0xDD		// Define restart interval
+#define JPG_MARKER_TEM			0x01		// Temporary (no length)
+
+// A frame component (comes from the JPG frame header)
+typedef struct JPG_component {
+	uint8_t		id;							// The component identifier
+	uint8_t		h, v;						// The horizontal and vertical sampling factors
+	uint8_t		tq;							// The quantization table to use
+	} JPG_component;
+
+// JPG info (comes from the JPG frame header)
+typedef struct JPG_info {
+	uint8_t		flags;						// Flags (global)
+		#define JPG_FLG_PROGRESSIVE		0x01	// Progressive image
+		#define JPG_FLG_MULTISCAN		0x02	// The components are spread over multiple scans (needs a coefficient buffer)
+	uint8_t		ncomp;						// The number of components (1 or 3)
+	uint8_t		hmax, vmax;					// The maximum sampling factors
+	uint8_t		scale;						// The log2 of the scale divisor (0 = full size)
+	coord_t		width, height;				// The real (unscaled) image size
+	JPG_component	comp[JPG_MAX_COMPONENTS];
+
+	uint8_t		*cache;						// The image cache
+	unsigned	cachesz;					// The image cache size
+	} JPG_info;
+
+// Handle the JPG file stream
+typedef struct JPG_input {
+	GFILE *		f;							// The gfile to retrieve data from (0 if cached)
+	unsigned	buflen;						// The number of bytes left in the buffer
+	const uint8_t *pbuf;					// The pointer to the next byte
+	uint8_t		buf[GDISP_IMAGE_JPG_FILE_BUFFER_SIZE];
+	} JPG_input;
+
+// A huffman decoding table
+typedef struct JPG_huff {
+	uint16_t	fast[1<<JPG_HUFF_FAST_BITS];	// Lookup on the next input bits: (code length << 8) | symbol. 0 = use the slow decode
+	int32_t		maxcode[17];				// The largest code of each length
+	int32_t		delta[17];					// The symbol index offset for codes of each length
+	uint8_t		vals[256];					// The symbols in code order
+	} JPG_huff;
+
+// Put all the decoding structures together.
+// Note this is immediately followed by the MCU pixel buffer and the MCU component sample buffers (dynamic size).
+typedef struct JPG_decode {
+	gdispImage		*img;
+	JPG_info		*pinfo;
+	JPG_input		i;
+
+	// The entropy decoder
+	uint32_t		acc;					// The bit accumulator (MSB is the next bit)
+	uint8_t			bits;					// The number of bits in the accumulator
+	uint8_t			marker;					// A marker found in the entropy coded data (0 = none yet)
+	uint16_t		restartint;				// The restart interval in MCU's (0 = none)
+	uint16_t		restartcnt;				// The number of MCU's before the next restart
+	uint16_t		eobrun;					// The progressive end of band run
+	int16_t			dcpred[JPG_MAX_COMPONENTS];	// The DC predictors
+
+	// The current scan
+	uint8_t			ns;						// The number of components in the scan
+	uint8_t			scomp[JPG_MAX_COMPONENTS];	// The frame component index of each scan component
+	uint8_t			td[JPG_MAX_COMPONENTS];	// The DC table of each frame component
+	uint8_t			ta[JPG_MAX_COMPONENTS];	// The AC table of each frame component
+	uint8_t			ss, se, ah, al;			// The spectral selection and successive approximation
+
+	// The tables
+	uint16_t		qt[JPG_MAX_TABLES][64];	// The quantization tables (zig-zag order)
+	JPG_huff		dc[JPG_MAX_TABLES];
+	JPG_huff		ac[JPG_MAX_TABLES];
+
+	// The output
+	GDisplay		*g;
+	coord_t			x, y;
+	coord_t			cx, cy;
+	coord_t			sx, sy;
+	int16_t			blk[64];				// The current block (natural order)
+	pixel_t			*pixels;				// The pixel buffer for one MCU
+	uint8_t			*samples[JPG_MAX_COMPONENTS];	// The sample buffers for one MCU
+	#if GDISP_NEED_IMAGE_JPG_PROGRESSIVE
+		int16_t		*coefs[JPG_MAX_COMPONENTS];		// The coefficients of the whole image (multi-scan images only)
+		unsigned	bw[JPG_MAX_COMPONENTS];			// The number of blocks per line in each coefficient buffer
+	#endif
+	} JPG_decode;
+
+// The natural order of zig-zag coefficients
+static const uint8_t JPG_zigzag[64] = {
+	 0,  1,  8, 16,  9,  2,  3, 10,
+	17, 24, 32, 25, 18, 11,  4,  5,
+	12, 19, 26, 33, 40, 48, 41, 34,
+	27, 20, 13,  6,  7, 14, 21, 28,
+	35, 42, 49, 56, 57, 50, 43, 36,
+	29, 22, 15, 23, 30, 37, 44, 51,
+	58, 59, 52, 45, 38, 31, 39, 46,
+	53, 60, 61, 54, 47, 55, 62, 63
+	};
+
+/*-----------------------------------------------------------------
+ * JPG input data stream functions
+ *---------------------------------------------------------------*/
+
+// Input initialization
+static void JPG_iInit(JPG_decode *d) {
+	if (d->pinfo->cache) {
+		d->i.pbuf = d->pinfo->cache;
+		d->i.buflen = d->pinfo->cachesz;
+		d->i.f = 0;
+	} else {
+		d->i.buflen = 0;
+		d->i.f = d->img->f;
+		gfileSetPos(d->i.f, 0);
+	}
+}
+
+// Get a byte from the JPG file. Returns -1 at the end of the file.
+static int JPG_iGetByte(JPG_decode *d) {
+	if (!d->i.buflen) {
+		if (!d->i.f || !(d->i.buflen = gfileRead(d->i.f, d->i.buf, sizeof(d->i.buf))))
+			return -1;
+		d->i.pbuf = d->i.buf;
+	}
+	d->i.buflen--;
+	return *d->i.pbuf++;
+}
+
+// Get a big endian word from the JPG file. Returns -1 at the end of the file.
+static int JPG_iGetWord(JPG_decode *d) {
+	int		hi, lo;
+
+	if ((hi = JPG_iGetByte(d)) < 0 || (lo = JPG_iGetByte(d)) < 0)
+		return -1;
+	return (hi << 8) | lo;
+}
+
+// Skip over some bytes in the JPG file
+static void JPG_iSkip(JPG_decode *d, unsigned len) {
+	if (len <= d->i.buflen) {
+		d->i.pbuf += len;
+		d->i.buflen -= len;
+		return;
+	}
+	len -= d->i.buflen;
+	d->i.buflen = 0;
+	if (d->i.f)
+		gfileSetPos(d->i.f, gfileGetPos(d->i.f) + len);
+}
+
+// Find the next marker in the JPG file. Returns -1 at the end of the file.
+static int JPG_iGetMarker(JPG_decode *d) {
+	int		c;
+
+	// A marker may have been found by the entropy decoder
+	if (d->marker) {
+		c = d->marker;
+		d->marker = 0;
+		return c;
+	}
+
+	// Skip anything that isn't a marker (including fill bytes)
+	do {
+		while ((c = JPG_iGetByte(d)) != 0xFF) {
+			if (c < 0)
+				return -1;
+		}
+		while ((c = JPG_iGetByte(d)) == 0xFF);
+	} while (!c);
+	return c;
+}
+
+/*-----------------------------------------------------------------
+ * Entropy decoding functions
+ *---------------------------------------------------------------*/
+
+// Reset the bit accumulator (at the start of a scan or after a restart)
+static void JPG_bReset(JPG_decode *d) {
+	unsigned	i;
+
+	d->acc = 0;
+	d->bits = 0;
+	d->eobrun = 0;
+	d->restartcnt = d->restartint;
+	for(i = 0; i < JPG_MAX_COMPONENTS; i++)
+		d->dcpred[i] = 0;
+}
+
+// Fill the bit accumulator with at least 25 bits.
+//	Byte stuffing is removed. When a marker is found it is saved and zero bits are supplied instead.
+static void JPG_bFill(JPG_decode *d) {
+	int		c;
+
+	while(d->bits <= 24) {
+		c = 0;
+		if (!d->marker) {
+			if ((c = JPG_iGetByte(d)) < 0) {
+				d->marker = JPG_MARKER_EOI;
+				c = 0;
+			} else if (c == 0xFF) {
+				while ((c = JPG_iGetByte(d)) == 0xFF);
+				if (c) {
+					d->marker = c < 0 ? JPG_MARKER_EOI : c;
+					c = 0;
+				} else
+					c = 0xFF;
+			}
+		}
+		d->acc |= (uint32_t)c << (24 - d->bits);
+		d->bits += 8;
+	}
+}
+
+// Get a number of bits (1 to 16) from the entropy coded data
+static unsigned JPG_bGetBits(JPG_decode *d, unsigned num) {
+	unsigned	val;
+
+	if (d->bits < num)
+		JPG_bFill(d);
+	val = d->acc >> (32 - num);
+	d->acc <<= num;
+	d->bits -= num;
+	return val;
+}
+#define JPG_bGetBit(d)		JPG_bGetBits(d, 1)
+
+// Get a signed value of a number of bits (0 to 15) from the entropy coded data
+static int JPG_bGetValue(JPG_decode *d, unsigned num) {
+	int		val;
+
+	if (!num)
+		return 0;
+	val = JPG_bGetBits(d, num);
+	return val < (1 << (num-1)) ? val - (1 << num) + 1 : val;
+}
+
+// Build a huffman table from the code length counts and symbols (already in h->vals)
+static bool_t JPG_hBuild(JPG_huff *h, const uint8_t *counts) {
+	unsigned	len, i, k, code, fill;
+
+	memset(h->fast, 0, sizeof(h->fast));
+	for(code = k = 0, len = 1; len <= 16; len++) {
+		h->delta[len] = k - code;
+		for(i = 0; i < counts[len-1]; i++, code++, k++) {
+			// Reject an over-subscribed table before the code can overrun the lookup table
+			if (code >= (1U << len))
+				return FALSE;
+			if (len <= JPG_HUFF_FAST_BITS) {
+				for(fill = 0; fill < (1U << (JPG_HUFF_FAST_BITS-len)); fill++)
+					h->fast[(code << (JPG_HUFF_FAST_BITS-len)) | fill] = (len << 8) | h->vals[k];
+			}
+		}
+		h->maxcode[len] = (int32_t)code - 1;
+		code <<= 1;
+	}
+	return TRUE;
+}
+
+// Decode a huffman symbol. Returns -1 on a bad code.
+static int JPG_hDecode(JPG_decode *d, const JPG_huff *h) {
+	unsigned	e, len, peek;
+
+	if (d->bits < 16)
+		JPG_bFill(d);
+
+	// Most codes are short enough to use the lookup table
+	if ((e = h->fast[d->acc >> (32 - JPG_HUFF_FAST_BITS)])) {
+		d->acc <<= e >> 8;
+		d->bits -= e >> 8;
+		return e & 0xFF;
+	}
+
+	// Find the length of a longer code
+	peek = d->acc >> 16;
+	for(len = JPG_HUFF_FAST_BITS+1; len <= 16; len++) {
+		if ((int32_t)(peek >> (16 - len)) <= h->maxcode[len]) {
+			e = h->vals[(peek >> (16 - len)) + h->delta[len]];
+			d->acc <<= len;
+			d->bits -= len;
+			return e;
+		}
+	}
+	return -1;
+}
+
+// Process a restart marker if one is due
+static bool_t JPG_Restart(JPG_decode *d) {
+	int		c;
+
+	if (!d->restartint)
+		return TRUE;
+	if (d->restartcnt) {
+		d->restartcnt--;
+		return TRUE;
+	}
+
+	// Any bits left are just padding. Find the marker if the entropy decoder hasn't already.
+	if (!d->marker) {
+		if ((c = JPG_iGetMarker(d)) < 0)
+			return FALSE;
+		d->marker = c;
+	}
+	if (d->marker < JPG_MARKER_RST0 || d->marker > JPG_MARKER_RST7)
+		return FALSE;
+	d->marker = 0;
+	JPG_bReset(d);
+	d->restartcnt--;
+	return TRUE;
+}
+
+// Decode a sequential block into natural order.
+//	If q is set the coefficients are dequantized. If blk is NULL the block is decoded and then thrown away.
+static bool_t JPG_DecodeBlock(JPG_decode *d, unsigned ci, int16_t *blk, const uint16_t *q) {
+	const JPG_huff	*h;
+	int				rs;
+	unsigned		k;
+
+	// The DC coefficient
+	if ((rs = JPG_hDecode(d, &d->dc[d->td[ci]])) < 0 || rs > 15)
+		return FALSE;
+	d->dcpred[ci] += JPG_bGetValue(d, rs);
+	if (blk)
+		blk[0] = q ? d->dcpred[ci] * q[0] : d->dcpred[ci];
+
+	// The AC coefficients
+	h = &d->ac[d->ta[ci]];
+	for(k = 1; k < 64; k++) {
+		if ((rs = JPG_hDecode(d, h)) < 0)
+			return FALSE;
+		if (!(rs & 0x0F)) {
+			if (rs != 0xF0)
+				break;						// End of block
+			k += 15;						// 16 zeros
+			continue;
+		}
+		k += rs >> 4;
+		if (k > 63)
+			return FALSE;
+		rs = JPG_bGetValue(d, rs & 0x0F);
+		if (blk)
+			blk[JPG_zigzag[k]] = q ? rs * q[k] : rs;
+	}
+	return TRUE;
+}
+
+#if GDISP_NEED_IMAGE_JPG_PROGRESSIVE
+	// Decode the first DC scan of a progressive block
+	static bool_t JPG_DecodeDCFirst(JPG_decode *d, unsigned ci, int16_t *blk) {
+		int		s;
+
+		if ((s = JPG_hDecode(d, &d->dc[d->td[ci]])) < 0 || s > 15)
+			return FALSE;
+		d->dcpred[ci] += JPG_bGetValue(d, s);
+		blk[0] = d->dcpred[ci] * (1 << d->al);
+		return TRUE;
+	}
+
+	// Decode a DC refinement scan of a progressive block
+	static bool_t JPG_DecodeDCRefine(JPG_decode *d, int16_t *blk) {
+		if (JPG_bGetBit(d))
+			blk[0] |= 1 << d->al;
+		return TRUE;
+	}
+
+	// Decode the first AC scan of a progressive block
+	static bool_t JPG_DecodeACFirst(JPG_decode *d, unsigned ci, int16_t *blk) {
+		const JPG_huff	*h;
+		int				rs;
+		unsigned		k, r;
+
+		if (d->eobrun) {
+			d->eobrun--;
+			return TRUE;
+		}
+		h = &d->ac[d->ta[ci]];
+		for(k = d->ss; k <= d->se; k++) {
+			if ((rs = JPG_hDecode(d, h)) < 0)
+				return FALSE;
+			r = rs >> 4;
+			if (!(rs & 0x0F)) {
+				if (r < 15) {
+					// End of band run
+					d->eobrun = (1 << r) - 1;
+					if (r)
+						d->eobrun += JPG_bGetBits(d, r);
+					break;
+				}
+				k += 15;
+				continue;
+			}
+			k += r;
+			if (k > 63)
+				return FALSE;
+			blk[JPG_zigzag[k]] = JPG_bGetValue(d, rs & 0x0F) * (1 << d->al);
+		}
+		return TRUE;
+	}
+
+	// Decode an AC refinement scan of a progressive block
+	static bool_t JPG_DecodeACRefine(JPG_decode *d, unsigned ci, int16_t *blk) {
+		const JPG_huff	*h;
+		int16_t			*pc;
+		int				rs, r, p1, m1, s;
+		unsigned		k;
+
+		p1 = 1 << d->al;
+		m1 = -1 * p1;
+		k = d->ss;
+		if (!d->eobrun) {
+			h = &d->ac[d->ta[ci]];
+			for(; k <= d->se; k++) {
+				if ((rs = JPG_hDecode(d, h)) < 0)
+					return FALSE;
+				r = rs >> 4;
+				s = 0;
+				if ((rs & 0x0F)) {
+					// The new coefficient can only be +/-1 at this bit position
+					s = JPG_bGetBit(d) ? p1 : m1;
+				} else if (r < 15) {
+					// End of band run
+					d->eobrun = 1 << r;
+					if (r)
+						d->eobrun += JPG_bGetBits(d, r);
+					break;
+				}
+
+				// Skip r zero coefficients (refining any non-zero ones on the way)
+				for(; k <= d->se; k++) {
+					pc = blk + JPG_zigzag[k];
+					if (*pc) {
+						if (JPG_bGetBit(d) && !(*pc & p1))
+							*pc += *pc >= 0 ? p1 : m1;
+					} else if (--r < 0)
+						break;
+				}
+				if (s) {
+					if (k > 63)
+						return FALSE;
+					blk[JPG_zigzag[k]] = s;
+				}
+			}
+		}
+
+		// Refine the rest of the band
+		if (d->eobrun) {
+			for(; k <= d->se; k++) {
+				pc = blk + JPG_zigzag[k];
+				if (*pc && JPG_bGetBit(d) && !(*pc & p1))
+					*pc += *pc >= 0 ? p1 : m1;
+			}
+			d->eobrun--;
+		}
+		return TRUE;
+	}
+
+	// Decode a block of a multi-scan image into the coefficient buffer
+	static bool_t JPG_DecodeBufferedBlock(JPG_decode *d, unsigned ci, int16_t *blk) {
+		if (!(d->pinfo->flags & JPG_FLG_PROGRESSIVE))
+			return JPG_DecodeBlock(d, ci, blk, 0);
+		if (!d->ss)
+			return d->ah ? JPG_DecodeDCRefine(d, blk) : JPG_DecodeDCFirst(d, ci, blk);
+		return d->ah ? JPG_DecodeACRefine(d, ci, blk) : JPG_DecodeACFirst(d, ci, blk);
+	}
+#endif
+
+/*-----------------------------------------------------------------
+ * Inverse DCT functions
+ *---------------------------------------------------------------*/
+
+#define JPG_CLAMP(v)		((uint8_t)((v) < 0 ? 0 : ((v) > 255 ? 255 : (v))))
+
+// 12 bit fixed point constants for the IDCT
+#define JPG_FIX(f)			((int32_t)((f) * 4096 + 0.5))
+
+// One dimension of the integer IDCT (the LLM algorithm as used by the IJG).
+//	The even part goes to e[] and the odd part to o[]. The outputs are then e[i]+o[3-i] and e[3-i]-o[i].
+static void JPG_Idct1D(int32_t *e, int32_t *o, int32_t s0, int32_t s1, int32_t s2, int32_t s3, int32_t s4, int32_t s5, int32_t s6, int32_t s7) {
+	int32_t		t0, t1, t2, t3, p1, p2, p3, p4, p5;
+
+	// Even part
+	p1 = (s2 + s6) * JPG_FIX(0.541196100);
+	t2 = p1 + s6 * -JPG_FIX(1.847759065);
+	t3 = p1 + s2 * JPG_FIX(0.765366865);
+	t0 = (s0 + s4) * 4096;
+	t1 = (s0 - s4) * 4096;
+	e[0] = t0 + t3;
+	e[3] = t0 - t3;
+	e[1] = t1 + t2;
+	e[2] = t1 - t2;
+
+	// Odd part
+	p3 = s7 + s3;
+	p4 = s5 + s1;
+	p1 = s7 + s1;
+	p2 = s5 + s3;
+	p5 = (p3 + p4) * JPG_FIX(1.175875602);
+	t0 = s7 * JPG_FIX(0.298631336);
+	t1 = s5 * JPG_FIX(2.053119869);
+	t2 = s3 * JPG_FIX(3.072711026);
+	t3 = s1 * JPG_FIX(1.501321110);
+	p1 = p5 + p1 * -JPG_FIX(0.899976223);
+	p2 = p5 + p2 * -JPG_FIX(2.562915447);
+	p3 = p3 * -JPG_FIX(1.961570560);
+	p4 = p4 * -JPG_FIX(0.390180644);
+	o[3] = t3 + p1 + p4;
+	o[2] = t2 + p2 + p3;
+	o[1] = t1 + p2 + p4;
+	o[0] = t0 + p1 + p3;
+}
+
+// Full size 8x8 IDCT
+static void JPG_Idct8(const int16_t *blk, uint8_t *out, unsigned stride) {
+	int32_t		ws[64];
+	int32_t		e[4], o[4];
+	int32_t		*w;
+	unsigned	i;
+
+	// Columns - keeping 2 extra bits of precision
+	for(i = 0, w = ws; i < 8; i++, blk++, w++) {
+		if (!blk[8] && !blk[16] && !blk[24] && !blk[32] && !blk[40] && !blk[48] && !blk[56]) {
+			// Only a DC term - very common
+			w[0] = w[8] = w[16] = w[24] = w[32] = w[40] = w[48] = w[56] = blk[0] * 4;
+			continue;
+		}
+		JPG_Idct1D(e, o, blk[0], blk[8], blk[16], blk[24], blk[32], blk[40], blk[48], blk[56]);
+		w[0]  = (e[0] + o[3] + 512) >> 10;
+		w[56] = (e[0] - o[3] + 512) >> 10;
+		w[8]  = (e[1] + o[2] + 512) >> 10;
+		w[48] = (e[1] - o[2] + 512) >> 10;
+		w[16] = (e[2] + o[1] + 512) >> 10;
+		w[40] = (e[2] - o[1] + 512) >> 10;
+		w[24] = (e[3] + o[0] + 512) >> 10;
+		w[32] = (e[3] - o[0] + 512) >> 10;
+	}
+
+	// Rows - removing the precision, the 1/8 scale and the level shift
+	#define JPG_DESCALE(v)	(((v) + 65536 + (128 << 17)) >> 17)
+	for(i = 0, w = ws; i < 8; i++, w += 8, out += stride) {
+		JPG_Idct1D(e, o, w[0], w[1], w[2], w[3], w[4], w[5], w[6], w[7]);
+		out[0] = JPG_CLAMP(JPG_DESCALE(e[0] + o[3]));
+		out[7] = JPG_CLAMP(JPG_DESCALE(e[0] - o[3]));
+		out[1] = JPG_CLAMP(JPG_DESCALE(e[1] + o[2]));
+		out[6] = JPG_CLAMP(JPG_DESCALE(e[1] - o[2]));
+		out[2] = JPG_CLAMP(JPG_DESCALE(e[2] + o[1]));
+		out[5] = JPG_CLAMP(JPG_DESCALE(e[2] - o[1]));
+		out[3] = JPG_CLAMP(JPG_DESCALE(e[3] + o[0]));
+		out[4] = JPG_CLAMP(JPG_DESCALE(e[3] - o[0]));
+	}
+	#undef JPG_DESCALE
+}
+
+// Reduced size IDCT's for scaled decoding. They only use the lowest n x n coefficients.
+//	The tables are C(u)/2 * cos((2x+1)u.pi/2n) in 12 bit fixed point.
+static const int16_t JPG_idct4[4*4] = {
+	1448,  1892,  1448,   784,
+	1448,   784, -1448, -1892,
+	1448,  -784, -1448,  1892,
+	1448, -1892,  1448,  -784
+	};
+static const int16_t JPG_idct2[2*2] = {
+	1448,  1448,
+	1448, -1448
+	};
+
+static void JPG_IdctReduced(const int16_t *blk, uint8_t *out, unsigned stride, unsigned n, const int16_t *t) {
+	int32_t		ws[4*4];
+	int32_t		v;
+	unsigned	r, c, k;
+
+	// Columns
+	for(r = 0; r < n; r++) {
+		for(c = 0; c < n; c++) {
+			for(v = 0, k = 0; k < n; k++)
+				v += t[r*n+k] * blk[k*8+c];
+			ws[r*n+c] = (v + 2048) >> 12;
+		}
+	}
+
+	// Rows
+	for(r = 0; r < n; r++, out += stride) {
+		for(c = 0; c < n; c++) {
+			for(v = 0, k = 0; k < n; k++)
+				v += t[c*n+k] * ws[r*n+k];
+			v = ((v + 2048) >> 12) + 128;
+			out[c] = JPG_CLAMP(v);
+		}
+	}
+}
+
+// Convert a dequantized block to samples at the current scale
+static void JPG_Idct(JPG_decode *d, const int16_t *blk, uint8_t *out, unsigned stride) {
+	int32_t		v;
+
+	switch(d->pinfo->scale) {
+	case 0:		JPG_Idct8(blk, out, stride);					break;
+	case 1:		JPG_IdctReduced(blk, out, stride, 4, JPG_idct4);	break;
+	case 2:		JPG_IdctReduced(blk, out, stride, 2, JPG_idct2);	break;
+	default:
+		v = ((blk[0] + 4) >> 3) + 128;
+		out[0] = JPG_CLAMP(v);
+		break;
+	}
+}
+
+/*-----------------------------------------------------------------
+ * Display output functions
+ *---------------------------------------------------------------*/
+
+// Convert the samples of an MCU to pixels and blit the part of it in the drawing window
+static void JPG_OutputMCU(JPG_decode *d, unsigned mx, unsigned my) {
+	JPG_info		*pinfo;
+	const JPG_component	*pc;
+	const uint8_t	*ps;
+	pixel_t			*pp;
+	coord_t			mw, mh, px, py, x0, y0, x1, y1, i, j;
+	int				Y, cb, cr, r, g, b;
+
+	pinfo = d->pinfo;
+	mw = pinfo->hmax * (8 >> pinfo->scale);
+	mh = pinfo->vmax * (8 >> pinfo->scale);
+	px = mx * mw;
+	py = my * mh;
+
+	// Clip to the drawing window
+	x0 = px < d->sx ? d->sx : px;
+	y0 = py < d->sy ? d->sy : py;
+	x1 = px+mw > d->sx+d->cx ? d->sx+d->cx : px+mw;
+	y1 = py+mh > d->sy+d->cy ? d->sy+d->cy : py+mh;
+	if (x0 >= x1 || y0 >= y1)
+		return;
+
+	// Color convert the visible pixels
+	for(j = y0-py; j < y1-py; j++) {
+		pp = d->pixels + j*mw;
+		if (pinfo->ncomp == 1) {
+			ps = d->samples[0] + j*mw;
+			for(i = x0-px; i < x1-px; i++)
+				pp[i] = LUMA2COLOR(ps[i]);
+			continue;
+		}
+		for(i = x0-px; i < x1-px; i++) {
+			pc = pinfo->comp;
+			Y  = d->samples[0][(j*pc[0].v/pinfo->vmax) * (pc[0].h * (8 >> pinfo->scale)) + i*pc[0].h/pinfo->hmax];
+			cb = d->samples[1][(j*pc[1].v/pinfo->vmax) * (pc[1].h * (8 >> pinfo->scale)) + i*pc[1].h/pinfo->hmax] - 128;
+			cr = d->samples[2][(j*pc[2].v/pinfo->vmax) * (pc[2].h * (8 >> pinfo->scale)) + i*pc[2].h/pinfo->hmax] - 128;
+			r = Y + ((91881 * cr + 32768) >> 16);
+			g = Y - ((22554 * cb + 46802 * cr + 32768) >> 16);
+			b = Y + ((116130 * cb + 32768) >> 16);
+			pp[i] = RGB2COLOR(JPG_CLAMP(r), JPG_CLAMP(g), JPG_CLAMP(b));
+		}
+	}
+
+	gdispGBlitArea(d->g, d->x+x0-d->sx, d->y+y0-d->sy, x1-x0, y1-y0, x0-px, y0-py, mw, d->pixels);
+}
+
+/*-----------------------------------------------------------------
+ * Scan decoding functions
+ *---------------------------------------------------------------*/
+
+// Decode a single scan image drawing each MCU as it is decoded
+static bool_t JPG_DecodeStreamed(JPG_decode *d) {
+	JPG_info		*pinfo;
+	const JPG_component	*pc;
+	unsigned		mx, my, mcux, mcuy, si, ci, bx, by, S;
+	coord_t			mw, mh;
+	bool_t			visrow, vis;
+
+	pinfo = d->pinfo;
+	S = 8 >> pinfo->scale;
+	mw = pinfo->hmax * S;
+	mh = pinfo->vmax * S;
+	mcux = (pinfo->width + 8*pinfo->hmax - 1) / (8*pinfo->hmax);
+	mcuy = (pinfo->height + 8*pinfo->vmax - 1) / (8*pinfo->vmax);
+
+	for(my = 0; my < mcuy; my++) {
+		// We can stop once we are past the drawing window
+		if ((coord_t)(my*mh) >= d->sy+d->cy)
+			break;
+		visrow = (coord_t)(my*mh+mh) > d->sy;
+
+		for(mx = 0; mx < mcux; mx++) {
+			if (!JPG_Restart(d))
+				return FALSE;
+
+			// MCU's outside the drawing window are decoded but not converted
+			vis = visrow && (coord_t)(mx*mw) < d->sx+d->cx && (coord_t)(mx*mw+mw) > d->sx;
+
+			for(si = 0; si < d->ns; si++) {
+				ci = d->scomp[si];
+				pc = &pinfo->comp[ci];
+				for(by = 0; by < pc->v; by++) {
+					for(bx = 0; bx < pc->h; bx++) {
+						if (vis)
+							memset(d->blk, 0, sizeof(d->blk));
+						if (!JPG_DecodeBlock(d, ci, vis ? d->blk : 0, d->qt[pc->tq]))
+							return FALSE;
+						if (vis)
+							JPG_Idct(d, d->blk, d->samples[ci] + by*S*pc->h*S + bx*S, pc->h*S);
+					}
+				}
+			}
+			if (vis)
+				JPG_OutputMCU(d, mx, my);
+		}
+	}
+	return TRUE;
+}
+
+#if GDISP_NEED_IMAGE_JPG_PROGRESSIVE
+	// Decode a scan of a multi-scan image into the coefficient buffers
+	static bool_t JPG_DecodeBuffered(JPG_decode *d) {
+		JPG_info		*pinfo;
+		const JPG_component	*pc;
+		unsigned		mx, my, mcux, mcuy, si, ci, bx, by;
+
+		pinfo = d->pinfo;
+
+		// A single component scan is not interleaved - it is a block at a time over the component area
+		if (d->ns == 1) {
+			ci = d->scomp[0];
+			pc = &pinfo->comp[ci];
+			mcux = ((pinfo->width * pc->h + pinfo->hmax - 1) / pinfo->hmax + 7) / 8;
+			mcuy = ((pinfo->height * pc->v + pinfo->vmax - 1) / pinfo->vmax + 7) / 8;
+			for(by = 0; by < mcuy; by++) {
+				for(bx = 0; bx < mcux; bx++) {
+					if (!JPG_Restart(d) || !JPG_DecodeBufferedBlock(d, ci, d->coefs[ci] + (by*d->bw[ci] + bx)*64))
+						return FALSE;
+				}
+			}
+			return TRUE;
+		}
+
+		// An interleaved scan
+		mcux = (pinfo->width + 8*pinfo->hmax - 1) / (8*pinfo->hmax);
+		mcuy = (pinfo->height + 8*pinfo->vmax - 1) / (8*pinfo->vmax);
+		for(my = 0; my < mcuy; my++) {
+			for(mx = 0; mx < mcux; mx++) {
+				if (!JPG_Restart(d))
+					return FALSE;
+				for(si = 0; si < d->ns; si++) {
+					ci = d->scomp[si];
+					pc = &pinfo->comp[ci];
+					for(by = 0; by < pc->v; by++) {
+						for(bx = 0; bx < pc->h; bx++) {
+							if (!JPG_DecodeBufferedBlock(d, ci, d->coefs[ci] + ((my*pc->v+by)*d->bw[ci] + mx*pc->h+bx)*64))
+								return FALSE;
+						}
+					}
+				}
+			}
+		}
+		return TRUE;
+	}
+
+	// Draw a multi-scan image from the coefficient buffers
+	static void JPG_OutputBuffered(JPG_decode *d) {
+		JPG_info		*pinfo;
+		const JPG_component	*pc;
+		const int16_t	*src;
+		const uint16_t	*q;
+		unsigned		mx, my, mcux, mcuy, ci, bx, by, k, S;
+		coord_t			mw, mh;
+
+		pinfo = d->pinfo;
+		S = 8 >> pinfo->scale;
+		mw = pinfo->hmax * S;
+		mh = pinfo->vmax * S;
+		mcux = (pinfo->width + 8*pinfo->hmax - 1) / (8*pinfo->hmax);
+		mcuy = (pinfo->height + 8*pinfo->vmax - 1) / (8*pinfo->vmax);
+
+		for(my = 0; my < mcuy && (coord_t)(my*mh) < d->sy+d->cy; my++) {
+			if ((coord_t)(my*mh+mh) <= d->sy)
+				continue;
+			for(mx = 0; mx < mcux && (coord_t)(mx*mw) < d->sx+d->cx; mx++) {
+				if ((coord_t)(mx*mw+mw) <= d->sx)
+					continue;
+				for(ci = 0; ci < pinfo->ncomp; ci++) {
+					pc = &pinfo->comp[ci];
+					q = d->qt[pc->tq];
+					for(by = 0; by < pc->v; by++) {
+						for(bx = 0; bx < pc->h; bx++) {
+							src = d->coefs[ci] + ((my*pc->v+by)*d->bw[ci] + mx*pc->h+bx)*64;
+							for(k = 0; k < 64; k++)
+								d->blk[JPG_zigzag[k]] = src[JPG_zigzag[k]] * q[k];
+							JPG_Idct(d, d->blk, d->samples[ci] + by*S*pc->h*S + bx*S, pc->h*S);
+						}
+					}
+				}
+				JPG_OutputMCU(d, mx, my);
+			}
+		}
+	}
+#endif
+
+/*-----------------------------------------------------------------
+ * Marker segment processing
+ *---------------------------------------------------------------*/
+
+// Define huffman tables
+static bool_t JPG_ReadDHT(JPG_decode *d) {
+	JPG_huff	*h;
+	int			len, c;
+	unsigned	i, total;
+	uint8_t		counts[16];
+
+	if ((len = JPG_iGetWord(d)) < 2)
+		return FALSE;
+	for(len -= 2; len > 0; len -= 17 + total) {
+		if ((c = JPG_iGetByte(d)) < 0 || (c & 0x0F) >= JPG_MAX_TABLES || (c >> 4) > 1)
+			return FALSE;
+		h = (c >> 4) ? &d->ac[c & 0x0F] : &d->dc[c & 0x0F];
+		for(total = i = 0; i < 16; i++) {
+			if ((c = JPG_iGetByte(d)) < 0)
+				return FALSE;
+			counts[i] = c;
+			total += c;
+		}
+		if (total > 256)
+			return FALSE;
+		for(i = 0; i < total; i++) {
+			if ((c = JPG_iGetByte(d)) < 0)
+				return FALSE;
+			h->vals[i] = c;
+		}
+		if (!JPG_hBuild(h, counts))
+			return FALSE;
+	}
+	return len == 0;
+}
+
+// Define quantization tables
+static bool_t JPG_ReadDQT(JPG_decode *d) {
+	uint16_t	*q;
+	int			len, pq;
+	unsigned	k;
+
+	if ((len = JPG_iGetWord(d)) < 2)
+		return FALSE;
+	for(len -= 2; len > 0; len -= (pq >> 4) ? 129 : 65) {
+		if ((pq = JPG_iGetByte(d)) < 0 || (pq & 0x0F) >= JPG_MAX_TABLES)
+			return FALSE;
+		q = d->qt[pq & 0x0F];
+		for(k = 0; k < 64; k++)
+			q[k] = (pq >> 4) ? JPG_iGetWord(d) : JPG_iGetByte(d);
+	}
+	return len == 0;
+}
+
+// Start of scan
+static bool_t JPG_ReadSOS(JPG_decode *d) {
+	JPG_info	*pinfo;
+	int			len, c;
+	unsigned	i, ci;
+
+	pinfo = d->pinfo;
+	len = JPG_iGetWord(d);
+	d->ns = JPG_iGetByte(d);
+	if (d->ns < 1 || d->ns > pinfo->ncomp || len != 6 + 2*d->ns)
+		return FALSE;
+	for(i = 0; i < d->ns; i++) {
+		c = JPG_iGetByte(d);
+		for(ci = 0; ci < pinfo->ncomp && pinfo->comp[ci].id != c; ci++);
+		if (ci >= pinfo->ncomp)
+			return FALSE;
+		d->scomp[i] = ci;
+		if ((c = JPG_iGetByte(d)) < 0 || (c >> 4) >= JPG_MAX_TABLES || (c & 0x0F) >= JPG_MAX_TABLES)
+			return FALSE;
+		d->td[ci] = c >> 4;
+		d->ta[ci] = c & 0x0F;
+	}
+	d->ss = JPG_iGetByte(d);
+	d->se = JPG_iGetByte(d);
+	if ((c = JPG_iGetByte(d)) < 0 || d->ss > 63 || d->se > 63)
+		return FALSE;
+	d->ah = c >> 4;
+	d->al = c & 0x0F;
+
+	// Get ready to decode
+	d->marker = 0;
+	JPG_bReset(d);
+	return TRUE;
+}
+
+// Decode and draw the image
+static gdispImageError JPG_Decode(JPG_decode *d) {
+	int		m;
+
+	JPG_iInit(d);
+	if (JPG_iGetWord(d) != 0xFF00+JPG_MARKER_SOI)
+		return GDISP_IMAGE_ERR_BADDATA;
+
+	while(1) {
+		switch((m = JPG_iGetMarker(d))) {
+		case JPG_MARKER_DHT:
+			if (!JPG_ReadDHT(d))
+				return GDISP_IMAGE_ERR_BADDATA;
+			break;
+
+		case JPG_MARKER_DQT:
+			if (!JPG_ReadDQT(d))
+				return GDISP_IMAGE_ERR_BADDATA;
+			break;
+
+		case JPG_MARKER_DRI:
+			if (JPG_iGetWord(d) != 4)
+				return GDISP_IMAGE_ERR_BADDATA;
+			d->restartint = JPG_iGetWord(d);
+			break;
+
+		case JPG_MARKER_SOS:
+			if (!JPG_ReadSOS(d))
+				return GDISP_IMAGE_ERR_BADDATA;
+			#if GDISP_NEED_IMAGE_JPG_PROGRESSIVE
+				if ((d->pinfo->flags & JPG_FLG_MULTISCAN)) {
+					// Decode this scan and move on to the next one
+					if (!JPG_DecodeBuffered(d))
+						return GDISP_IMAGE_ERR_BADDATA;
+					break;
+				}
+			#endif
+			// A single scan image - we are done
+			return JPG_DecodeStreamed(d) ? GDISP_IMAGE_ERR_OK : GDISP_IMAGE_ERR_BADDATA;
+
+		case JPG_MARKER_EOI:
+		case -1:
+			#if GDISP_NEED_IMAGE_JPG_PROGRESSIVE
+				if ((d->pinfo->flags & JPG_FLG_MULTISCAN)) {
+					// Draw whatever we have
+					JPG_OutputBuffered(d);
+					return m == JPG_MARKER_EOI ? GDISP_IMAGE_ERR_OK : GDISP_IMAGE_ERR_BADDATA;
+				}
+			#endif
+			return GDISP_IMAGE_ERR_BADDATA;
+
+		case JPG_MARKER_TEM:
+			break;
+
+		default:
+			// Stray restart markers have no length. Skip any other segment.
+			if (m >= JPG_MARKER_RST0 && m <= JPG_MARKER_RST7)
+				break;
+			if ((m = JPG_iGetWord(d)) < 2)
+				return GDISP_IMAGE_ERR_BADDATA;
+			JPG_iSkip(d, m - 2);
+			break;
+		}
+	}
+}
+
+/*-----------------------------------------------------------------
+ * Public JPG functions
+ *---------------------------------------------------------------*/
+
+void gdispImageClose_JPG(gdispImage *img) {
+	JPG_info *pinfo;
+
+	pinfo = (JPG_info *)img->priv;
+	if (pinfo) {
+		if (pinfo->cache)
+			gdispImageFree(img, (void *)pinfo->cache, pinfo->cachesz);
+		gdispImageFree(img, (void *)pinfo, sizeof(JPG_info));
+		img->priv = 0;
+	}
+}
+
+gdispImageError gdispImageOpen_JPG(gdispImage *img) {
+	JPG_info	*pinfo;
+	unsigned	i, blocks;
+	uint16_t	len;
+	uint8_t		buf[6+3*JPG_MAX_COMPONENTS];
+
+	/* Read the file identifier */
+	if (gfileRead(img->f, buf, 3) != 3)
+		return GDISP_IMAGE_ERR_BADFORMAT;		// It can't be us
+
+	// Check the JPG start of image marker (and the start of the next marker)
+	if (buf[0] != 0xFF || buf[1] != JPG_MARKER_SOI || buf[2] != 0xFF)
+		return GDISP_IMAGE_ERR_BADFORMAT;		// It can't be us
+
+	/* We know we are a JPG format image */
+	img->flags = 0;
+	img->priv = 0;
+	img->type = GDISP_IMAGE_TYPE_JPG;
+
+	/* Allocate our private area */
+	if (!(img->priv = gdispImageAlloc(img, sizeof(JPG_info))))
+		return GDISP_IMAGE_ERR_NOMEMORY;
+
+	/* Initialise the essential bits in the private area */
+	pinfo = (JPG_info *)img->priv;
+	pinfo->flags = 0;
+	pinfo->ncomp = 0;
+	pinfo->scale = 0;
+	pinfo->cache = 0;
+	gfileSetPos(img->f, 2);
+
+	// Read the marker segments until we get to the first scan
+	while(1) {
+		// Find the marker
+		do {
+			if (gfileRead(img->f, buf, 1) != 1)
+				goto exit_baddata;
+		} while (buf[0] != 0xFF);
+		do {
+			if (gfileRead(img->f, buf, 1) != 1)
+				goto exit_baddata;
+		} while (buf[0] == 0xFF);
+
+		switch(buf[0]) {
+		case 0x00:
+		case JPG_MARKER_TEM:
+		case JPG_MARKER_RST0: case JPG_MARKER_RST0+1: case JPG_MARKER_RST0+2: case JPG_MARKER_RST0+3:
+		case JPG_MARKER_RST0+4: case JPG_MARKER_RST0+5: case JPG_MARKER_RST0+6: case JPG_MARKER_RST7:
+			// No segment data
+			continue;
+
+		case JPG_MARKER_SOF2:
+			#if !GDISP_NEED_IMAGE_JPG_PROGRESSIVE
+				goto exit_unsupported;
+			#endif
+			pinfo->flags |= JPG_FLG_PROGRESSIVE|JPG_FLG_MULTISCAN;
+			// Fall through
+		case JPG_MARKER_SOF0:
+		case JPG_MARKER_SOF1:
+			// The frame header. We only support 8 bit precision grayscale or YCbCr images.
+			if (pinfo->ncomp || gfileRead(img->f, buf, 8) != 8)
+				goto exit_baddata;
+			pinfo->height = gdispImageGetBE16(buf, 3);
+			pinfo->width = gdispImageGetBE16(buf, 5);
+			pinfo->ncomp = buf[7];
+			if (buf[2] != 8 || (pinfo->ncomp != 1 && pinfo->ncomp != 3) || !pinfo->height)
+				goto exit_unsupported;
+			if (gdispImageGetBE16(buf, 0) != 8+3*pinfo->ncomp || !pinfo->width)
+				goto exit_baddata;
+			if (gfileRead(img->f, buf, 3*pinfo->ncomp) != 3*pinfo->ncomp)
+				goto exit_baddata;
+			pinfo->hmax = pinfo->vmax = 1;
+			for(blocks = i = 0; i < pinfo->ncomp; i++) {
+				pinfo->comp[i].id = buf[3*i];
+				pinfo->comp[i].h = pinfo->ncomp == 1 ? 1 : buf[3*i+1] >> 4;
+				pinfo->comp[i].v = pinfo->ncomp == 1 ? 1 : buf[3*i+1] & 0x0F;
+				pinfo->comp[i].tq = buf[3*i+2];
+				if (pinfo->comp[i].h < 1 || pinfo->comp[i].h > 4 || pinfo->comp[i].v < 1 || pinfo->comp[i].v > 4 || pinfo->comp[i].tq >= JPG_MAX_TABLES)
+					goto exit_baddata;
+				if (pinfo->comp[i].h > pinfo->hmax)		pinfo->hmax = pinfo->comp[i].h;
+				if (pinfo->comp[i].v > pinfo->vmax)		pinfo->vmax = pinfo->comp[i].v;
+				blocks += pinfo->comp[i].h * pinfo->comp[i].v;
+			}
+			if (blocks > JPG_MAX_BLOCKS)
+				goto exit_baddata;
+			break;
+
+		case JPG_MARKER_SOS:
+			// The first scan. If it doesn't contain all the components we need to buffer the image.
+			if (!pinfo->ncomp || gfileRead(img->f, buf, 3) != 3)
+				goto exit_baddata;
+			if (buf[2] != pinfo->ncomp) {
+				#if !GDISP_NEED_IMAGE_JPG_PROGRESSIVE
+					goto exit_unsupported;
+				#endif
+				pinfo->flags |= JPG_FLG_MULTISCAN;
+			}
+			img->width = pinfo->width;
+			img->height = pinfo->height;
+			return GDISP_IMAGE_ERR_OK;
+
+		case JPG_MARKER_EOI:
+			goto exit_baddata;
+
+		default:
+			// Lossless, hierarchical and arithmetic coded frames are not supported
+			if (buf[0] > JPG_MARKER_SOF2 && buf[0] <= 0xCF && buf[0] != JPG_MARKER_DHT && buf[0] != 0xC8 && buf[0] != 0xCC)
+				goto exit_unsupported;
+
+			// Skip anything else
+			if (gfileRead(img->f, buf, 2) != 2)
+				goto exit_baddata;
+			len = gdispImageGetBE16(buf, 0);
+			if (len < 2)
+				goto exit_baddata;
+			gfileSetPos(img->f, gfileGetPos(img->f) + len - 2);
+			break;
+		}
+	}
+
+exit_baddata:
+	gdispImageClose_JPG(img);
+	return GDISP_IMAGE_ERR_BADDATA;
+exit_unsupported:
+	gdispImageClose_JPG(img);
+	return GDISP_IMAGE_ERR_UNSUPPORTED;
+}
+
+gdispImageError gdispGImageDraw_JPG(GDisplay *g, gdispImage *img, coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t sx, coord_t sy) {
+	JPG_info 		*pinfo;
+	JPG_decode		*d;
+	gdispImageError	err;
+	size_t			dsz;
+	unsigned		i, S;
+	#if GDISP_NEED_IMAGE_JPG_PROGRESSIVE
+		size_t		sz;
+	#endif
+	uint8_t			*p;
+
+	// Allocate the space to decode with including space for the MCU pixels and samples.
+	pinfo = (JPG_info *)img->priv;
+	S = 8 >> pinfo->scale;
+	dsz = sizeof(JPG_decode) + pinfo->hmax*pinfo->vmax*S*S*sizeof(pixel_t);
+	for(i = 0; i < pinfo->ncomp; i++)
+		dsz += pinfo->comp[i].h*pinfo->comp[i].v*S*S;
+	if (!(d = gdispImageAlloc(img, dsz)))
+		return GDISP_IMAGE_ERR_NOMEMORY;
+
+	// Initialise the decoder
+	d->img = img;
+	d->pinfo = pinfo;
+	d->marker = 0;
+	d->restartint = 0;
+	d->g = g;
+	d->x = x;
+	d->y = y;
+	d->cx = cx;
+	d->cy = cy;
+	d->sx = sx;
+	d->sy = sy;
+	for(i = 0; i < JPG_MAX_TABLES; i++) {
+		// Undefined tables don't decode anything
+		memset(d->dc[i].fast, 0, sizeof(d->dc[i].fast));
+		memset(d->ac[i].fast, 0, sizeof(d->ac[i].fast));
+		memset(d->dc[i].maxcode, 0xFF, sizeof(d->dc[i].maxcode));
+		memset(d->ac[i].maxcode, 0xFF, sizeof(d->ac[i].maxcode));
+	}
+	d->pixels = (pixel_t *)(d+1);
+	p = (uint8_t *)(d->pixels + pinfo->hmax*pinfo->vmax*S*S);
+	for(i = 0; i < pinfo->ncomp; i++) {
+		d->samples[i] = p;
+		p += pinfo->comp[i].h*pinfo->comp[i].v*S*S;
+	}
+
+	#if GDISP_NEED_IMAGE_JPG_PROGRESSIVE
+		// Multi-scan images need the coefficients for the whole image
+		for(i = 0; i < JPG_MAX_COMPONENTS; i++)
+			d->coefs[i] = 0;
+		if ((pinfo->flags & JPG_FLG_MULTISCAN)) {
+			for(i = 0; i < pinfo->ncomp; i++) {
+				d->bw[i] = (pinfo->width + 8*pinfo->hmax - 1) / (8*pinfo->hmax) * pinfo->comp[i].h;
+				sz = d->bw[i] * ((pinfo->height + 8*pinfo->vmax - 1) / (8*pinfo->vmax) * pinfo->comp[i].v) * 64 * sizeof(int16_t);
+				if (!(d->coefs[i] = gdispImageAlloc(img, sz))) {
+					err = GDISP_IMAGE_ERR_NOMEMORY;
+					goto exit_free;
+				}
+				memset(d->coefs[i], 0, sz);
+			}
+		}
+	#endif
+
+	// Decode and draw
+	err = JPG_Decode(d);
+
+	// Clean up
+	#if GDISP_NEED_IMAGE_JPG_PROGRESSIVE
+exit_free:
+		for(i = 0; i < pinfo->ncomp; i++) {
+			if (d->coefs[i])
+				gdispImageFree(img, d->coefs[i], d->bw[i] * ((pinfo->height + 8*pinfo->vmax - 1) / (8*pinfo->vmax) * pinfo->comp[i].v) * 64 * sizeof(int16_t));
+		}
+	#endif
+	gdispImageFree(img, d, dsz);
+	return err;
+}
+
+gdispImageError gdispImageCache_JPG(gdispImage *img) {
+	JPG_info 	*pinfo;
+	uint8_t		*pcache;
+	long int	sz;
+
+	// If we are already cached - just return OK
+	pinfo = (JPG_info *)img->priv;
+	if (pinfo->cache)
+		return GDISP_IMAGE_ERR_OK;
+
+	// The compressed data is small so we cache the whole file
+	if ((sz = gfileGetSize(img->f)) <= 0)
+		return GDISP_IMAGE_ERR_BADDATA;
+	if (!(pcache = gdispImageAlloc(img, sz)))
+		return GDISP_IMAGE_ERR_NOMEMORY;
+	gfileSetPos(img->f, 0);
+	if (gfileRead(img->f, pcache, sz) != (size_t)sz) {
+		gdispImageFree(img, pcache, sz);
+		return GDISP_IMAGE_ERR_BADDATA;
+	}
+	pinfo->cache = pcache;
+	pinfo->cachesz = sz;
+	return GDISP_IMAGE_ERR_OK;
+}
+
+delaytime_t gdispImageNext_JPG(gdispImage *img) {
+	(void) img;
+
+	/* No more frames/pages */
+	return TIME_INFINITE;
+}
+
+gdispImageError gdispImageSetJPGScale(gdispImage *img, uint8_t scale) {
+	JPG_info	*pinfo;
+	uint8_t		shift;
+
+	if (img->type != GDISP_IMAGE_TYPE_JPG || !img->priv)
+		return GDISP_IMAGE_ERR_BADFORMAT;
+
+	switch(scale) {
+	case 1:		shift = 0;		break;
+	case 2:		shift = 1;		break;
+	case 4:		shift = 2;		break;
+	case 8:		shift = 3;		break;
+	default:	return GDISP_IMAGE_ERR_UNSUPPORTED;
+	}
+
+	// The image now appears to be the scaled size
+	pinfo = (JPG_info *)img->priv;
+	pinfo->scale = shift;
+	img->width = (pinfo->width + (1 << shift) - 1) >> shift;
+	img->height = (pinfo->height + (1 << shift) - 1) >> shift;
+	return GDISP_IMAGE_ERR_OK;
+}
 
 #endif /* GFX_USE_GDISP && GDISP_NEED_IMAGE && GDISP_NEED_IMAGE_JPG */
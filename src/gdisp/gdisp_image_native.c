@@ -96,6 +96,7 @@ gdispImageError gdispImageCache_NATIVE(gdispImage *img) {
 gdispImageError gdispGImageDraw_NATIVE(GDisplay *g, gdispImage *img, coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t sx, coord_t sy) {
 	coord_t		mx, mcx;
 	size_t		pos, len;
+	const void	*direct;
 	gdispImagePrivate_NATIVE *	priv;
 
 	priv = (gdispImagePrivate_NATIVE *)img->priv;
@@ -111,6 +112,15 @@ gdispImageError gdispGImageDraw_NATIVE(GDisplay *g, gdispImage *img, coord_t x,
 		return GDISP_IMAGE_ERR_OK;
 	}
 
+	/* Memory based files (eg ROMFS) can be drawn straight from the file data */
+	gfileSetPos(img->f, FRAME0POS_NATIVE);
+	len = img->width * img->height * sizeof(pixel_t);
+	direct = gfileReadDirect(img->f, &len);
+	if (direct && len == img->width * img->height * sizeof(pixel_t) && !((size_t)direct & (sizeof(pixel_t)-1))) {
+		gdispGBlitArea(g, x, y, cx, cy, sx, sy, img->width, (const pixel_t *)direct);
+		return GDISP_IMAGE_ERR_OK;
+	}
+
 	/* For this image decoder we cheat and just seek straight to the region we want to display */
 	pos = FRAME0POS_NATIVE + (img->width * sy + sx) * sizeof(pixel_t);
 
@@ -82,14 +82,25 @@ typedef struct PNG_filter {
 	} PNG_filter;
 
 // Handle the PNG inflate decompression
+#if GDISP_IMAGE_PNG_FAST_INFLATE
+	#define PNG_ZFAST_BITS		9		// The number of bits decoded by the first level lookup table
+#endif
+
 typedef struct PNG_zTree {
 	uint16_t table[16];			// Table of code length counts
 	uint16_t trans[288];		// Code to symbol translation table
+	#if GDISP_IMAGE_PNG_FAST_INFLATE
+		uint16_t fast[1<<PNG_ZFAST_BITS];	// Lookup on the next input bits: (symbol << 4) | code length. 0 = use the slow decode
+	#endif
 	} PNG_zTree;
 
 typedef struct PNG_zinflate {
-	uint8_t		data;					// The current input stream data byte
-	uint8_t		bits;					// The number of bits left in the data byte
+	#if GDISP_IMAGE_PNG_FAST_INFLATE
+		uint32_t	data;				// The input bit accumulator (LSB is the next bit)
+	#else
+		uint8_t		data;				// The current input stream data byte
+	#endif
+	uint8_t		bits;					// The number of bits left in the data
 	uint8_t		flags;					// Decompression flags
 	#define PNG_ZFLG_EOF			0x01	// No more input data
 	#define PNG_ZFLG_FINAL			0x02	// This is the final block
@@ -98,6 +109,7 @@ typedef struct PNG_zinflate {
 	#define PNG_ZFLG_RESUME_COPY	0x04	// Resume a byte copy from the input stream (length in tmp)
 	#define PNG_ZFLG_RESUME_INFLATE	0x08	// Resume using the specified symbol (symbol in tmp[0])
 	#define PNG_ZFLG_RESUME_OFFSET	0x0C	// Resume a byte offset copy from the buffer (length and offset in tmp)
+	#define PNG_ZFLG_FIXEDTREES		0x10	// The trees currently hold the fixed huffman trees
 
 	unsigned		bufpos;				// The current buffer output position
 	unsigned		bufend;				// The current buffer end position (wraps)
@@ -273,6 +285,7 @@ static void PNG_oColor(PNG_output *o, color_t c) {
 
 // Initialize the inflate decompressor
 static void PNG_zInit(PNG_zinflate *z) {
+	z->data = 0;
 	z->bits = 0;
 	z->flags = 0;
 	z->bufpos = z->bufend = 0;
@@ -293,6 +306,159 @@ static bool_t PNG_zGetHeader(PNG_decode *d) {
 	return TRUE;
 }
 
+#if GDISP_IMAGE_PNG_FAST_INFLATE
+
+// Top up the bit accumulator with whole bytes from the input
+static void PNG_zFill(PNG_decode *d) {
+	while (d->z.bits <= 24) {
+		if (!PNG_iLoadData(d))
+			return;
+		d->z.data |= (uint32_t)PNG_iGetByte(d) << d->z.bits;
+		d->z.bits += 8;
+	}
+}
+
+// Get multiple bits from the input (treated as a LSB first stream with bit order retained)
+static unsigned PNG_zGetBits(PNG_decode *d, unsigned num) {
+	unsigned val;
+
+	if (d->z.bits < num) {
+		PNG_zFill(d);
+		if (d->z.bits < num) {
+			d->z.flags |= PNG_ZFLG_EOF;
+			return (1 << num) - 1;
+		}
+	}
+	val = d->z.data & ((1 << num) - 1);
+	d->z.data >>= num;
+	d->z.bits -= num;
+	return val;
+}
+
+// Get a bit from the input
+#define PNG_zGetBit(d)		PNG_zGetBits(d, 1)
+
+// Discard any bits left in a partly used input byte
+static void PNG_zAlignByte(PNG_decode *d) {
+	d->z.data >>= d->z.bits & 7;
+	d->z.bits &= ~7;
+}
+
+// Get a whole byte from the input (after PNG_zAlignByte). Returns FALSE on EOF.
+static bool_t PNG_zGetByteInput(PNG_decode *d, uint8_t *pb) {
+	// Bytes already in the accumulator come first
+	if (d->z.bits) {
+		*pb = (uint8_t)d->z.data;
+		d->z.data >>= 8;
+		d->z.bits -= 8;
+		return TRUE;
+	}
+	if (!PNG_iLoadData(d))
+		return FALSE;
+	*pb = PNG_iGetByte(d);
+	return TRUE;
+}
+
+// Build an inflate dynamic tree using a string of byte lengths
+static void PNG_zBuildTree(PNG_zTree *t, const uint8_t *lengths, unsigned num) {
+	unsigned		i, sum, len, code, rev;
+	uint16_t		offs[16];
+	uint16_t		next[16];
+
+	for (i = 0; i < 16; ++i)
+		t->table[i] = 0;
+	for (i = 0; i < num; ++i)
+		t->table[lengths[i]]++;
+
+	t->table[0] = 0;
+
+	for (sum = 0, code = 0, i = 0; i < 16; ++i) {
+		offs[i] = sum;
+		sum += t->table[i];
+		code = (code + (i ? t->table[i-1] : 0)) << 1;
+		next[i] = code;
+	}
+
+	for (i = 0; i < (1<<PNG_ZFAST_BITS); ++i)
+		t->fast[i] = 0;
+
+	for (i = 0; i < num; ++i) {
+		len = lengths[i];
+		if (!len)
+			continue;
+		t->trans[offs[len]++] = i;
+
+		// Codes short enough go in the lookup table indexed by their (bit reversed) input order
+		code = next[len]++;
+		if (len > PNG_ZFAST_BITS)
+			continue;
+		for (rev = 0, sum = 0; sum < len; sum++, code >>= 1)
+			rev = (rev << 1) | (code & 1);
+		for (; rev < (1<<PNG_ZFAST_BITS); rev += 1 << len)
+			t->fast[rev] = (uint16_t)((i << 4) | len);
+	}
+}
+
+// Get an inflate decode symbol
+static uint16_t PNG_zGetSymbol(PNG_decode *d, PNG_zTree *t) {
+	int			sum, cur;
+	unsigned	len;
+	uint16_t	e;
+
+	if (d->z.bits < 15)
+		PNG_zFill(d);
+
+	// Try the lookup table
+	e = t->fast[d->z.data & ((1<<PNG_ZFAST_BITS)-1)];
+	if (e && (e & 0x0F) <= d->z.bits) {
+		d->z.data >>= e & 0x0F;
+		d->z.bits -= e & 0x0F;
+		return e >> 4;
+	}
+
+	// Longer codes - walk the code length counts using the bits in the accumulator
+	sum = cur = 0;
+	len = 0;
+	do {
+		if (len >= d->z.bits || len >= 15) {
+			d->z.flags |= PNG_ZFLG_EOF;
+			return 0;
+		}
+		cur <<= 1;
+		cur += (d->z.data >> len) & 1;
+		len++;
+
+		sum += t->table[len];
+		cur -= t->table[len];
+	} while (cur >= 0);
+
+	d->z.data >>= len;
+	d->z.bits -= len;
+	return t->trans[sum + cur];
+}
+
+// Build inflate fixed length and distance trees
+static void PNG_zBuildFixedTrees(PNG_decode *d) {
+	unsigned	i;
+
+	// They are still there from the last fixed block
+	if ((d->z.flags & PNG_ZFLG_FIXEDTREES))
+		return;
+
+	for (i = 0; i < 144; ++i)	d->z.tmp[i] = 8;
+	for ( ; i < 256; ++i)		d->z.tmp[i] = 9;
+	for ( ; i < 280; ++i)		d->z.tmp[i] = 7;
+	for ( ; i < 288; ++i)		d->z.tmp[i] = 8;
+	PNG_zBuildTree(&d->z.ltree, d->z.tmp, 288);
+
+	for (i = 0; i < 32; ++i)	d->z.tmp[i] = 5;
+	PNG_zBuildTree(&d->z.dtree, d->z.tmp, 32);
+
+	d->z.flags |= PNG_ZFLG_FIXEDTREES;
+}
+
+#else
+
 // Get a bit from the input (treated as a LSB first stream)
 static unsigned PNG_zGetBit(PNG_decode *d) {
 	unsigned	bit;
@@ -333,6 +499,19 @@ static unsigned PNG_zGetBits(PNG_decode *d, unsigned num) {
 	return val;
 }
 
+// Discard any bits left in a partly used input byte
+static void PNG_zAlignByte(PNG_decode *d) {
+	d->z.bits = 0;
+}
+
+// Get a whole byte from the input (after PNG_zAlignByte). Returns FALSE on EOF.
+static bool_t PNG_zGetByteInput(PNG_decode *d, uint8_t *pb) {
+	if (!PNG_iLoadData(d))
+		return FALSE;
+	*pb = PNG_iGetByte(d);
+	return TRUE;
+}
+
 // Build an inflate dynamic tree using a string of byte lengths
 static void PNG_zBuildTree(PNG_zTree *t, const uint8_t *lengths, unsigned num) {
 	unsigned		i, sum;
@@ -395,6 +574,8 @@ static void PNG_zBuildFixedTrees(PNG_decode *d) {
 	for ( ; i < 288; ++i)		d->z.dtree.trans[i] = 0;
 }
 
+#endif
+
 // Build inflate dynamic length and distance trees
 static bool_t PNG_zDecodeTrees(PNG_decode *d) {
 	static const uint8_t IndexLookup[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
@@ -421,6 +602,7 @@ static bool_t PNG_zDecodeTrees(PNG_decode *d) {
 		return FALSE;
 
 	// Build the code length tree
+	d->z.flags &= ~PNG_ZFLG_FIXEDTREES;
 	PNG_zBuildTree(&d->z.ltree, d->z.tmp, 19);
 
 	// Decode code lengths
@@ -450,6 +632,7 @@ static bool_t PNG_zDecodeTrees(PNG_decode *d) {
 	}
 
 	// Build the trees
+	d->z.flags &= ~PNG_ZFLG_FIXEDTREES;
 	PNG_zBuildTree(&d->z.ltree, d->z.tmp, hlit);
 	PNG_zBuildTree(&d->z.dtree, d->z.tmp + hlit, hdist);
 	return TRUE;
@@ -459,11 +642,11 @@ static bool_t PNG_zDecodeTrees(PNG_decode *d) {
 static bool_t PNG_zCopyInput(PNG_decode *d, unsigned length) {
 	// Copy the block
 	while(length--) {
-		if (!PNG_iLoadData(d)) {				// EOF?
+		if (!PNG_zGetByteInput(d, &d->z.buf[d->z.bufend])) {	// EOF?
 			d->z.flags |= PNG_ZFLG_EOF;
 			return FALSE;
 		}
-		d->z.buf[d->z.bufend++] = PNG_iGetByte(d);
+		d->z.bufend++;
 		WRAP_ZBUF(d->z.bufend);
 		if (d->z.bufend == d->z.bufpos) {		// Buffer full?
 			d->z.flags = (d->z.flags & ~PNG_ZFLG_RESUME_MASK) | PNG_ZFLG_RESUME_COPY;
@@ -482,15 +665,14 @@ static bool_t PNG_zUncompressedBlock(PNG_decode *d) {
 	unsigned	length;
 
 	// This block works on byte boundaries
-	d->z.bits = 0;
+	PNG_zAlignByte(d);
 
 	// Get 4 byte header
 	for (length = 0; length < 4; length++) {
-		if (!PNG_iLoadData(d)) {			// EOF?
+		if (!PNG_zGetByteInput(d, &d->z.tmp[length])) {	// EOF?
 			d->z.flags |= PNG_ZFLG_EOF;
 			return FALSE;
 		}
-		d->z.tmp[length] = PNG_iGetByte(d);
 	}
 
 	// Get length
@@ -192,6 +192,13 @@
 	#ifndef GDISP_NEED_PIXMAP
 		#define GDISP_NEED_PIXMAP				FALSE
 	#endif
+	/**
+	 * @brief   Are regions (lists of non-overlapping rectangles) required.
+	 * @details	Defaults to FALSE
+	 */
+	#ifndef GDISP_NEED_REGIONS
+		#define GDISP_NEED_REGIONS				FALSE
+	#endif
 /**
  * @}
  *
@@ -397,6 +404,17 @@
 	#ifndef GDISP_IMAGE_BMP_BLIT_BUFFER_SIZE
 		#define GDISP_IMAGE_BMP_BLIT_BUFFER_SIZE	32
 	#endif
+	/**
+	 * @brief   The number of rows between entries in the RLE BMP row index.
+	 * @details	Defaults to 0 (no row index)
+	 * @note 	When non-zero the decoder state is remembered every this many rows
+	 * 			of a RLE4/RLE8 bitmap as the image is decoded. Drawing part of the image
+	 * 			can then start from the nearest remembered row instead of the start of the bitmap.
+	 * @note 	Smaller values seek more precisely but require more RAM per open image.
+	 */
+	#ifndef GDISP_IMAGE_BMP_RLE_INDEX_ROWS
+		#define GDISP_IMAGE_BMP_RLE_INDEX_ROWS		0
+	#endif
 /**
  * @}
  *
@@ -412,6 +430,32 @@
 	#ifndef GDISP_IMAGE_GIF_BLIT_BUFFER_SIZE
 		#define GDISP_IMAGE_GIF_BLIT_BUFFER_SIZE	32
 	#endif
+/**
+ * @}
+ *
+ * @name    GDISP JPG Image Options
+ * @pre		GDISP_NEED_IMAGE and GDISP_NEED_IMAGE_JPG must be TRUE
+ * @{
+ */
+	/**
+	 * @brief   Is progressive (and other multi-scan) JPG image decoding required.
+	 * @details	Defaults to FALSE
+	 * @note	These images must be fully decoded before anything can be displayed so
+	 * 			they need RAM for the coefficients of the whole image (2 bytes per sample).
+	 * 			Baseline images are drawn an MCU at a time and don't need this.
+	 */
+	#ifndef GDISP_NEED_IMAGE_JPG_PROGRESSIVE
+		#define GDISP_NEED_IMAGE_JPG_PROGRESSIVE		FALSE
+	#endif
+	/**
+	 * @brief   The JPG input buffer size.
+	 * @details	Defaults to 64
+	 * @note 	Bigger is faster but requires more RAM.
+	 * @note	This is only used if the image is not cached.
+	 */
+	#ifndef GDISP_IMAGE_JPG_FILE_BUFFER_SIZE
+		#define GDISP_IMAGE_JPG_FILE_BUFFER_SIZE		64
+	#endif
 /**
  * @}
  *
@@ -560,6 +604,16 @@
 	#ifndef GDISP_IMAGE_PNG_Z_BUFFER_SIZE
 		#define GDISP_IMAGE_PNG_Z_BUFFER_SIZE	32768
 	#endif
+	/**
+	 * @brief   Use a faster table driven inflate decompressor.
+	 * @details	Defaults to FALSE
+	 * @note 	This reads the compressed data through a 32 bit accumulator and
+	 * 			decodes most huffman codes with a single table lookup.
+	 * @note 	It requires about 2K of extra RAM while decoding an image.
+	 */
+	#ifndef GDISP_IMAGE_PNG_FAST_INFLATE
+		#define GDISP_IMAGE_PNG_FAST_INFLATE	FALSE
+	#endif
 /**
  * @}
  *
@@ -613,6 +667,37 @@
 	#ifndef GDISP_NEED_ANTIALIAS
 		#define GDISP_NEED_ANTIALIAS			FALSE
 	#endif
+	/**
+	 * @brief	The maximum number of pixels blended at once when drawing anti-aliased text.
+	 * @details	Defaults to 32
+	 * @details	Partially covered pixels in a row of a character are read from the display in one go,
+	 * 			blended in RAM and written back with a single blit. Wider rows are done in pieces.
+	 * @note	This uses (1 + sizeof(color_t)) bytes of stack for each pixel.
+	 * @note	Only used with @p gdispGDrawChar(), @p gdispGDrawString() and @p gdispGDrawStringBox()
+	 * 			when GDISP_NEED_ANTIALIAS is TRUE and the display can be read.
+	 */
+	#ifndef GDISP_TEXT_AA_SPAN_SIZE
+		#define GDISP_TEXT_AA_SPAN_SIZE			32
+	#endif
+	/**
+	 * @brief	Cache rendered characters for filled text.
+	 * @details	Defaults to FALSE
+	 * @details	Characters drawn by @p gdispGFillChar(), @p gdispGFillString() and @p gdispGFillStringBox()
+	 * 			are kept pre-rendered in their colors so that drawing them again is a single blit.
+	 * 			This helps clocks, counters and lists that redraw the same few characters over and over.
+	 * @note	The least recently used characters are thrown away when the cache is full.
+	 */
+	#ifndef GDISP_NEED_TEXT_GLYPHCACHE
+		#define GDISP_NEED_TEXT_GLYPHCACHE		FALSE
+	#endif
+	/**
+	 * @brief	The maximum amount of RAM used by the character cache (in bytes).
+	 * @details	Defaults to 4096
+	 * @note	Each character uses its ink width * height pixels plus a small header.
+	 */
+	#ifndef GDISP_TEXT_GLYPHCACHE_SIZE
+		#define GDISP_TEXT_GLYPHCACHE_SIZE		4096
+	#endif
 /**
  * @}
  *
@@ -622,6 +707,21 @@
 	#ifndef GDISP_NEED_PIXMAP_IMAGE
 		#define GDISP_NEED_PIXMAP_IMAGE			FALSE
 	#endif
+/**
+ * @}
+ *
+ * @name	GDISP Region Options
+ * @{
+ */
+	/**
+	 * @brief   The maximum number of rectangles in a region.
+	 * @details	Defaults to 16
+	 * @note	Each region uses 8 bytes per rectangle (with 16 bit coordinates). Regions are
+	 * 			often placed on the stack so keep this reasonably small.
+	 */
+	#ifndef GDISP_REGION_MAX_RECTS
+		#define GDISP_REGION_MAX_RECTS			16
+	#endif
 /**
  * @}
  *
@@ -26,23 +26,50 @@
 #undef GDISP_HARDWARE_QUERY
 #undef GDISP_HARDWARE_CLIP
 #define GDISP_HARDWARE_DEINIT			TRUE
+#define GDISP_HARDWARE_STREAM_WRITE		TRUE
+#define GDISP_HARDWARE_STREAM_READ		TRUE
+#define GDISP_HARDWARE_STREAM_POS		TRUE
 #define GDISP_HARDWARE_DRAWPIXEL		TRUE
+#define GDISP_HARDWARE_FILLS			TRUE
+#define GDISP_HARDWARE_BITFILLS			TRUE
+#define GDISP_HARDWARE_SCROLL			TRUE
 #define GDISP_HARDWARE_PIXELREAD		TRUE
 #define GDISP_HARDWARE_CONTROL			TRUE
 #define IN_PIXMAP_DRIVER				TRUE
 #define GDISP_DRIVER_VMT				GDISPVMT_pixmap
 #define GDISP_DRIVER_VMT_FLAGS			(GDISP_VFLG_DYNAMICONLY|GDISP_VFLG_PIXMAP)
 
-// This pseudo driver currently only supports unpacked formats with more than 8 bits per pixel
-//	that is, we only support GRAY_SCALE and PALETTE with 8 bits per pixel or any unpacked TRUE_COLOR format.
-#if (GDISP_LLD_PIXELFORMAT & GDISP_COLORSYSTEM_GRAYSCALE) && (GDISP_LLD_PIXELFORMAT & 0xFF) != 8
-	#error "GDISP Pixmap: Pixmap's do not currently support the specified GDISP_LLD_PIXELFORMAT"
+// This pseudo driver supports any unpacked format plus the 1, 2 and 4 bit GRAYSCALE formats.
+//	The packed formats store each row MSB first (the left-most pixel in the top bits of a byte)
+//	with every row padded out to a whole byte. This is the surface returned by gdispPixmapGetBits().
+#if (GDISP_PIXELFORMAT & GDISP_COLORSYSTEM_MASK) == GDISP_COLORSYSTEM_GRAYSCALE && (GDISP_PIXELFORMAT & 0xFF) < 8
+	#if (GDISP_PIXELFORMAT & 0xFF) != 1 && (GDISP_PIXELFORMAT & 0xFF) != 2 && (GDISP_PIXELFORMAT & 0xFF) != 4
+		#error "GDISP Pixmap: Pixmap's do not currently support the specified GDISP_PIXELFORMAT"
+	#endif
+	#if GDISP_NEED_PIXMAP_IMAGE
+		#error "GDISP Pixmap: GDISP_NEED_PIXMAP_IMAGE is not supported for packed pixel formats"
+	#endif
+	#define PIXMAP_BITS				(GDISP_PIXELFORMAT & 0xFF)
+	#define PIXMAP_PERBYTE			(8/PIXMAP_BITS)
+	#define PIXMAP_MASK				((1<<PIXMAP_BITS)-1)
+	#define PIXMAP_PITCH(p)			(((p)->width + PIXMAP_PERBYTE-1) & ~(PIXMAP_PERBYTE-1))
+#elif (GDISP_PIXELFORMAT & GDISP_COLORSYSTEM_MASK) == GDISP_COLORSYSTEM_GRAYSCALE && (GDISP_PIXELFORMAT & 0xFF) != 8
+	#error "GDISP Pixmap: Pixmap's do not currently support the specified GDISP_PIXELFORMAT"
+#else
+	#define PIXMAP_PITCH(p)			((p)->width)
 #endif
 
 #include "gdisp_driver.h"
 #include "../gdriver/gdriver.h"
 
+#include <string.h>			// For memset, memcpy and memmove
+
 typedef struct pixmap {
+	coord_t			width, height;		// The size of the pixmap surface (unrotated)
+	coord_t			x0, y0, x1, y1;		// The current streaming window
+	coord_t			x, y;				// The current streaming position
+	unsigned		pos;				// The pixel index of the current streaming position
+	int				dx;					// The amount to add to pos for each pixel along a streaming line
 	#if GDISP_NEED_PIXMAP_IMAGE
 		uint8_t		imghdr[8];			// This field must come just before the data member.
 	#endif
@@ -55,9 +82,11 @@ GDisplay *gdispPixmapCreate(coord_t width, coord_t height) {
 	unsigned	i;
 
 	// Calculate the size of the display surface in bytes
-	i = width*height*sizeof(color_t);
-	if (i < 2*sizeof(coord_t))
-		i = 2*sizeof(coord_t);
+	#ifdef PIXMAP_BITS
+		i = ((width + PIXMAP_PERBYTE-1)/PIXMAP_PERBYTE) * height;
+	#else
+		i = width*height*sizeof(color_t);
+	#endif
 
 	// Allocate the pixmap
 	if (!(p = gfxAlloc(i+sizeof(pixmap)-sizeof(p->pixels))))
@@ -76,8 +105,8 @@ GDisplay *gdispPixmapCreate(coord_t width, coord_t height) {
 	#endif
 
 	// Save the width and height so the driver can retrieve it.
-	((coord_t *)p->pixels)[0] = width;
-	((coord_t *)p->pixels)[1] = height;
+	p->width = width;
+	p->height = height;
 
 	// Register the driver
 	g = (GDisplay *)gdriverRegister(&GDISPVMT_pixmap->d, p);
@@ -106,20 +135,186 @@ pixel_t	*gdispPixmapGetBits(GDisplay *g) {
 	}
 #endif
 
+/*===========================================================================*/
+/* Driver local routines.                                                    */
+/*===========================================================================*/
+
+// Set and get a pixel given its index into the pixmap surface
+#ifdef PIXMAP_BITS
+	#define PIXMAP_SHIFT(pos)		((PIXMAP_PERBYTE-1 - ((pos) & (PIXMAP_PERBYTE-1))) * PIXMAP_BITS)
+
+	static GFXINLINE void setpixel(pixmap *p, unsigned pos, color_t color) {
+		uint8_t		*b;
+		unsigned	shift;
+
+		b = (uint8_t *)p->pixels + pos/PIXMAP_PERBYTE;
+		shift = PIXMAP_SHIFT(pos);
+		*b = (uint8_t)((*b & ~(PIXMAP_MASK << shift)) | ((color & PIXMAP_MASK) << shift));
+	}
+	static GFXINLINE color_t getpixel(pixmap *p, unsigned pos) {
+		return (color_t)((((uint8_t *)p->pixels)[pos/PIXMAP_PERBYTE] >> PIXMAP_SHIFT(pos)) & PIXMAP_MASK);
+	}
+#else
+	#define setpixel(p, pos, color)	(p)->pixels[pos] = (color)
+	#define getpixel(p, pos)		((p)->pixels[pos])
+#endif
+
+// Convert a display position into an index into the pixmap surface.
+//	dx and dy are set to the change in that index for a step in x and a step in y.
+static GFXINLINE unsigned pixpos(GDisplay *g, coord_t x, coord_t y, int *dx, int *dy) {
+	int		pitch;
+
+	pitch = PIXMAP_PITCH((pixmap *)g->priv);
+	#if GDISP_NEED_CONTROL
+		switch(g->g.Orientation) {
+		case GDISP_ROTATE_90:
+			*dx = -pitch; *dy = 1;
+			return (g->g.Width-x-1) * pitch + y;
+		case GDISP_ROTATE_180:
+			*dx = -1; *dy = -pitch;
+			return (g->g.Height-y-1) * pitch + g->g.Width-x-1;
+		case GDISP_ROTATE_270:
+			*dx = pitch; *dy = -1;
+			return x * pitch + g->g.Height-y-1;
+		default:
+			break;
+		}
+	#endif
+	*dx = 1; *dy = pitch;
+	return y * pitch + x;
+}
+
+// Convert a display area into the same area on the (unrotated) pixmap surface
+static void pixarea(GDisplay *g, coord_t *x, coord_t *y, coord_t *cx, coord_t *cy) {
+	#if GDISP_NEED_CONTROL
+		coord_t		t;
+
+		switch(g->g.Orientation) {
+		case GDISP_ROTATE_90:
+			t = *x;
+			*x = *y;
+			*y = g->g.Width - t - *cx;
+			t = *cx; *cx = *cy; *cy = t;
+			break;
+		case GDISP_ROTATE_180:
+			*x = g->g.Width - *x - *cx;
+			*y = g->g.Height - *y - *cy;
+			break;
+		case GDISP_ROTATE_270:
+			t = *x;
+			*x = g->g.Height - *y - *cy;
+			*y = t;
+			t = *cx; *cx = *cy; *cy = t;
+			break;
+		default:
+			break;
+		}
+	#else
+		(void) g; (void) x; (void) y; (void) cx; (void) cy;
+	#endif
+}
+
+// Fill len pixels on a single row of the pixmap surface
+static void fillrow(pixmap *p, unsigned pos, unsigned len, color_t color) {
+	#ifdef PIXMAP_BITS
+		// Partial leading byte
+		for(; len && (pos & (PIXMAP_PERBYTE-1)); len--, pos++)
+			setpixel(p, pos, color);
+
+		// Whole bytes
+		if (len >= PIXMAP_PERBYTE) {
+			memset((uint8_t *)p->pixels + pos/PIXMAP_PERBYTE, (color & PIXMAP_MASK) * (0xFF/PIXMAP_MASK), len/PIXMAP_PERBYTE);
+			pos += len & ~(PIXMAP_PERBYTE-1);
+			len &= PIXMAP_PERBYTE-1;
+		}
+
+		// Partial trailing byte
+		for(; len; len--, pos++)
+			setpixel(p, pos, color);
+	#elif COLOR_TYPE_BITS == 8
+		memset(p->pixels + pos, color, len);
+	#else
+		color_t		*d;
+
+		for(d = p->pixels + pos; len; len--)
+			*d++ = color;
+	#endif
+}
+
+#if GDISP_NEED_SCROLL
+	// Copy len pixels along a row of the pixmap surface. The source and destination may overlap.
+	static void moverow(pixmap *p, unsigned src, unsigned dst, unsigned len) {
+		#ifdef PIXMAP_BITS
+			// The rows are different and the pixels share the same alignment - we can copy whole bytes
+			if (src/PIXMAP_PITCH(p) != dst/PIXMAP_PITCH(p) && !((src ^ dst) & (PIXMAP_PERBYTE-1))) {
+				for(; len && (src & (PIXMAP_PERBYTE-1)); len--, src++, dst++)
+					setpixel(p, dst, getpixel(p, src));
+				if (len >= PIXMAP_PERBYTE) {
+					memcpy((uint8_t *)p->pixels + dst/PIXMAP_PERBYTE, (uint8_t *)p->pixels + src/PIXMAP_PERBYTE, len/PIXMAP_PERBYTE);
+					src += len & ~(PIXMAP_PERBYTE-1);
+					dst += len & ~(PIXMAP_PERBYTE-1);
+					len &= PIXMAP_PERBYTE-1;
+				}
+				for(; len; len--, src++, dst++)
+					setpixel(p, dst, getpixel(p, src));
+				return;
+			}
+
+			// Otherwise a pixel at a time in a direction that doesn't overwrite the source
+			if (dst > src) {
+				for(src += len, dst += len; len; len--)
+					setpixel(p, --dst, getpixel(p, --src));
+			} else {
+				for(; len; len--)
+					setpixel(p, dst++, getpixel(p, src++));
+			}
+		#else
+			memmove(p->pixels + dst, p->pixels + src, len * sizeof(color_t));
+		#endif
+	}
+#endif
+
+// Move to the next streaming position wrapping at the edges of the streaming window
+static GFXINLINE void streamnext(GDisplay *g, pixmap *p) {
+	int		dy;
+
+	if (++p->x < p->x1) {
+		p->pos += p->dx;
+		return;
+	}
+	p->x = p->x0;
+	if (++p->y >= p->y1)
+		p->y = p->y0;
+	p->pos = pixpos(g, p->x, p->y, &p->dx, &dy);
+}
+
+static void streamstart(GDisplay *g) {
+	pixmap	*p;
+	int		dy;
+
+	p = (pixmap *)g->priv;
+	p->x0 = p->x = g->p.x;
+	p->y0 = p->y = g->p.y;
+	p->x1 = g->p.x + g->p.cx;
+	p->y1 = g->p.y + g->p.cy;
+	p->pos = pixpos(g, p->x, p->y, &p->dx, &dy);
+}
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
 
 LLDSPEC bool_t gdisp_lld_init(GDisplay *g) {
+	pixmap	*p;
+
 	// The user api function should have already allocated and initialised the pixmap
 	//	structure and put it into the priv member during driver initialisation.
-	if (!g->priv)
+	if (!(p = (pixmap *)g->priv))
 		return FALSE;
 
 	// Initialize the GDISP structure
-	//	Width and height were saved into the start of the framebuffer.
-	g->g.Width = ((coord_t *)((pixmap *)g->priv)->pixels)[0];
-	g->g.Height = ((coord_t *)((pixmap *)g->priv)->pixels)[1];
+	g->g.Width = p->width;
+	g->g.Height = p->height;
 	g->g.Backlight = 100;
 	g->g.Contrast = 50;
 	g->g.Orientation = GDISP_ROTATE_0;
@@ -134,57 +329,148 @@ LLDSPEC	void gdisp_lld_deinit(GDisplay *g) {
 }
 
 LLDSPEC void gdisp_lld_draw_pixel(GDisplay *g) {
-	unsigned	pos;
+	int		dx, dy;
 
-	#if GDISP_NEED_CONTROL
-		switch(g->g.Orientation) {
-		case GDISP_ROTATE_0:
-		default:
-			pos = g->p.y * g->g.Width + g->p.x;
-			break;
-		case GDISP_ROTATE_90:
-			pos = (g->g.Width-g->p.x-1) * g->g.Height + g->p.y;
-			break;
-		case GDISP_ROTATE_180:
-			pos = (g->g.Height-g->p.y-1) * g->g.Width + g->g.Width-g->p.x-1;
-			break;
-		case GDISP_ROTATE_270:
-			pos = g->p.x * g->g.Height + g->g.Height-g->p.y-1;
-			break;
-		}
-	#else
-		pos = g->p.y * g->g.Width + g->p.x;
-	#endif
-
-	((pixmap *)(g)->priv)->pixels[pos] = g->p.color;
+	setpixel((pixmap *)g->priv, pixpos(g, g->p.x, g->p.y, &dx, &dy), g->p.color);
 }
 
 LLDSPEC	color_t gdisp_lld_get_pixel_color(GDisplay *g) {
-	unsigned		pos;
+	int		dx, dy;
 
-	#if GDISP_NEED_CONTROL
-		switch(g->g.Orientation) {
-		case GDISP_ROTATE_0:
-		default:
-			pos = g->p.y * g->g.Width + g->p.x;
-			break;
-		case GDISP_ROTATE_90:
-			pos = (g->g.Width-g->p.x-1) * g->g.Height + g->p.y;
-			break;
-		case GDISP_ROTATE_180:
-			pos = (g->g.Height-g->p.y-1) * g->g.Width + g->g.Width-g->p.x-1;
-			break;
-		case GDISP_ROTATE_270:
-			pos = g->p.x * g->g.Height + g->g.Height-g->p.y-1;
-			break;
-		}
-	#else
-		pos = g->p.y * g->g.Width + g->p.x;
-	#endif
+	return getpixel((pixmap *)g->priv, pixpos(g, g->p.x, g->p.y, &dx, &dy));
+}
+
+LLDSPEC	void gdisp_lld_write_start(GDisplay *g) {
+	streamstart(g);
+}
+
+LLDSPEC	void gdisp_lld_write_pos(GDisplay *g) {
+	pixmap	*p;
+	int		dy;
 
-	return ((pixmap *)(g)->priv)->pixels[pos];
+	p = (pixmap *)g->priv;
+	p->x = g->p.x;
+	p->y = g->p.y;
+	p->pos = pixpos(g, p->x, p->y, &p->dx, &dy);
 }
 
+LLDSPEC	void gdisp_lld_write_color(GDisplay *g) {
+	pixmap	*p;
+
+	p = (pixmap *)g->priv;
+	setpixel(p, p->pos, g->p.color);
+	streamnext(g, p);
+}
+
+LLDSPEC	void gdisp_lld_write_stop(GDisplay *g) {
+	(void) g;
+}
+
+LLDSPEC	void gdisp_lld_read_start(GDisplay *g) {
+	streamstart(g);
+}
+
+LLDSPEC	color_t gdisp_lld_read_color(GDisplay *g) {
+	pixmap	*p;
+	color_t	color;
+
+	p = (pixmap *)g->priv;
+	color = getpixel(p, p->pos);
+	streamnext(g, p);
+	return color;
+}
+
+LLDSPEC	void gdisp_lld_read_stop(GDisplay *g) {
+	(void) g;
+}
+
+LLDSPEC void gdisp_lld_fill_area(GDisplay *g) {
+	pixmap		*p;
+	coord_t		x, y, cx, cy;
+	unsigned	pos, pitch, len;
+
+	p = (pixmap *)g->priv;
+	x = g->p.x; y = g->p.y;
+	cx = g->p.cx; cy = g->p.cy;
+	pixarea(g, &x, &y, &cx, &cy);
+	pitch = PIXMAP_PITCH(p);
+	pos = y * pitch + x;
+
+	// A full width fill is just one long row
+	len = cx;
+	if (len == pitch) {
+		len *= cy;
+		cy = 1;
+	}
+	for(; cy; cy--, pos += pitch)
+		fillrow(p, pos, len, g->p.color);
+}
+
+LLDSPEC void gdisp_lld_blit_area(GDisplay *g) {
+	pixmap			*p;
+	const pixel_t	*src;
+	unsigned		pos, ipos;
+	int				dx, dy;
+	coord_t			i, j;
+
+	p = (pixmap *)g->priv;
+	src = (const pixel_t *)g->p.ptr + g->p.y1 * g->p.x2 + g->p.x1;
+	pos = pixpos(g, g->p.x, g->p.y, &dx, &dy);
+	for(j = 0; j < g->p.cy; j++, src += g->p.x2, pos += dy) {
+		#ifndef PIXMAP_BITS
+			if (dx == 1) {
+				memcpy(p->pixels + pos, src, g->p.cx * sizeof(pixel_t));
+				continue;
+			}
+		#endif
+		for(i = 0, ipos = pos; i < g->p.cx; i++, ipos += dx)
+			setpixel(p, ipos, src[i]);
+	}
+}
+
+#if GDISP_NEED_SCROLL
+	LLDSPEC void gdisp_lld_vertical_scroll(GDisplay *g) {
+		pixmap		*p;
+		coord_t		sx, sy, dx, dy, scx, scy, cx, cy;
+		unsigned	src, dst, pitch;
+		int			step;
+
+		p = (pixmap *)g->priv;
+
+		// Work out the display area that is moved
+		sx = dx = g->p.x;
+		cx = g->p.cx;
+		if (g->p.y1 > 0) {
+			sy = g->p.y + g->p.y1;
+			dy = g->p.y;
+			cy = g->p.cy - g->p.y1;
+		} else {
+			sy = g->p.y;
+			dy = g->p.y - g->p.y1;
+			cy = g->p.cy + g->p.y1;
+		}
+
+		// Convert it to the pixmap surface. When rotated by 90 or 270 degrees this becomes a horizontal move.
+		scx = cx; scy = cy;
+		pixarea(g, &sx, &sy, &scx, &scy);
+		pixarea(g, &dx, &dy, &cx, &cy);
+
+		// Move the rows in an order that won't overwrite source rows before they are copied
+		pitch = PIXMAP_PITCH(p);
+		if (dy > sy) {
+			src = (sy+cy-1) * pitch + sx;
+			dst = (dy+cy-1) * pitch + dx;
+			step = -(int)pitch;
+		} else {
+			src = sy * pitch + sx;
+			dst = dy * pitch + dx;
+			step = pitch;
+		}
+		for(; cy; cy--, src += step, dst += step)
+			moverow(p, src, dst, cx);
+	}
+#endif
+
 #if GDISP_NEED_CONTROL
 	LLDSPEC void gdisp_lld_control(GDisplay *g) {
 		switch(g->p.x) {
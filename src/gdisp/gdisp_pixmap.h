@@ -62,6 +62,9 @@ extern "C" {
 	 * 			by the application code. For any one particular pixmap the pointer will not change over the life of the pixmap
 	 * 			(although different pixmaps will have different pixel pointers). Once a pixmap is deleted, the pixel pointer
 	 * 			should not be used by the application.
+	 * @note	For the packed 1, 2 and 4 bit grayscale pixel formats the surface is not an array of pixel_t.
+	 * 			Each row is packed MSB first (the left-most pixel in the top bits of the byte) and padded
+	 * 			to a whole byte. The pointer is then not suitable for passing to @p gdispGBlitArea().
 	 */
 	pixel_t	*gdispPixmapGetBits(GDisplay *g);
 
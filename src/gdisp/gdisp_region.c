@@ -0,0 +1,163 @@
+/*
+ * This file is subject to the terms of the GFX License. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://ugfx.org/license.html
+ */
+
+#include "../../gfx.h"
+
+#if GFX_USE_GDISP && GDISP_NEED_REGIONS
+
+#include <string.h>
+
+// Do two rectangles overlap
+#define RectsOverlap(a, x0, y0, x1, y1)		((a)->x < (x1) && (a)->x+(a)->cx > (x0) && (a)->y < (y1) && (a)->y+(a)->cy > (y0))
+
+// Add a rectangle to a list if it is not empty. Returns FALSE if the list is full.
+static bool_t AppendRect(gdispRect *pr, unsigned *pcnt, coord_t x0, coord_t y0, coord_t x1, coord_t y1) {
+	if (x1 <= x0 || y1 <= y0)
+		return TRUE;
+	if (*pcnt >= GDISP_REGION_MAX_RECTS)
+		return FALSE;
+	pr += (*pcnt)++;
+	pr->x = x0;
+	pr->y = y0;
+	pr->cx = x1 - x0;
+	pr->cy = y1 - y0;
+	return TRUE;
+}
+
+// Append the parts of rectangle a that are outside (x0,y0)-(x1,y1). Returns FALSE if the list is full.
+static bool_t AppendDifference(gdispRect *pr, unsigned *pcnt, const gdispRect *a, coord_t x0, coord_t y0, coord_t x1, coord_t y1) {
+	coord_t		ax1, ay1, my0, my1;
+
+	ax1 = a->x + a->cx;
+	ay1 = a->y + a->cy;
+
+	// No overlap - keep the lot
+	if (!RectsOverlap(a, x0, y0, x1, y1))
+		return AppendRect(pr, pcnt, a->x, a->y, ax1, ay1);
+
+	// The band above, the band below, then what is left and right in the middle
+	my0 = a->y > y0 ? a->y : y0;
+	my1 = ay1 < y1 ? ay1 : y1;
+	return AppendRect(pr, pcnt, a->x, a->y, ax1, my0)
+		&& AppendRect(pr, pcnt, a->x, my1, ax1, ay1)
+		&& AppendRect(pr, pcnt, a->x, my0, a->x > x0 ? a->x : x0, my1)
+		&& AppendRect(pr, pcnt, x1 < ax1 ? x1 : ax1, my0, ax1, my1);
+}
+
+void gdispRegionSetRect(gdispRegion *prgn, coord_t x, coord_t y, coord_t cx, coord_t cy) {
+	prgn->cnt = 0;
+	AppendRect(prgn->rects, &prgn->cnt, x, y, x+cx, y+cy);
+}
+
+bool_t gdispRegionAddRect(gdispRegion *prgn, coord_t x, coord_t y, coord_t cx, coord_t cy) {
+	gdispRect	pieces[GDISP_REGION_MAX_RECTS];
+	gdispRect	tmp[GDISP_REGION_MAX_RECTS];
+	unsigned	i, j, npieces, ntmp;
+	coord_t		x1, y1;
+	gdispRect	*pr;
+
+	if (cx <= 0 || cy <= 0)
+		return TRUE;
+	x1 = x + cx;
+	y1 = y + cy;
+
+	// Drop any existing rectangles that the new one covers and check if it is already covered
+	for(i = j = 0; i < prgn->cnt; i++) {
+		pr = &prgn->rects[i];
+		if (pr->x >= x && pr->y >= y && pr->x+pr->cx <= x1 && pr->y+pr->cy <= y1)
+			continue;
+		if (pr->x <= x && pr->y <= y && pr->x+pr->cx >= x1 && pr->y+pr->cy >= y1)
+			return TRUE;
+		prgn->rects[j++] = *pr;
+	}
+	prgn->cnt = j;
+
+	// Cut the new rectangle into the pieces not already in the region
+	npieces = 0;
+	AppendRect(pieces, &npieces, x, y, x1, y1);
+	for(i = 0; i < prgn->cnt && npieces; i++) {
+		pr = &prgn->rects[i];
+		for(ntmp = 0, j = 0; j < npieces; j++) {
+			if (!AppendDifference(tmp, &ntmp, &pieces[j], pr->x, pr->y, pr->x+pr->cx, pr->y+pr->cy))
+				goto toocomplex;
+		}
+		memcpy(pieces, tmp, ntmp*sizeof(gdispRect));
+		npieces = ntmp;
+	}
+
+	// Add the pieces
+	if (prgn->cnt + npieces > GDISP_REGION_MAX_RECTS)
+		goto toocomplex;
+	memcpy(prgn->rects+prgn->cnt, pieces, npieces*sizeof(gdispRect));
+	prgn->cnt += npieces;
+	return TRUE;
+
+toocomplex:
+	// Replace the region with its bounding box
+	for(i = 0; i < prgn->cnt; i++) {
+		pr = &prgn->rects[i];
+		if (pr->x < x)				x = pr->x;
+		if (pr->y < y)				y = pr->y;
+		if (pr->x+pr->cx > x1)		x1 = pr->x+pr->cx;
+		if (pr->y+pr->cy > y1)		y1 = pr->y+pr->cy;
+	}
+	gdispRegionSetRect(prgn, x, y, x1-x, y1-y);
+	return FALSE;
+}
+
+bool_t gdispRegionSubtractRect(gdispRegion *prgn, coord_t x, coord_t y, coord_t cx, coord_t cy) {
+	gdispRect	tmp[GDISP_REGION_MAX_RECTS];
+	unsigned	i, ntmp;
+
+	if (cx <= 0 || cy <= 0 || !gdispRegionOverlapsRect(prgn, x, y, cx, cy))
+		return TRUE;
+
+	for(ntmp = 0, i = 0; i < prgn->cnt; i++) {
+		if (!AppendDifference(tmp, &ntmp, &prgn->rects[i], x, y, x+cx, y+cy))
+			return FALSE;
+	}
+	memcpy(prgn->rects, tmp, ntmp*sizeof(gdispRect));
+	prgn->cnt = ntmp;
+	return TRUE;
+}
+
+void gdispRegionIntersectRect(gdispRegion *prgn, coord_t x, coord_t y, coord_t cx, coord_t cy) {
+	unsigned	i, j;
+	coord_t		x0, y0, x1, y1;
+	gdispRect	*pr;
+
+	for(i = j = 0; i < prgn->cnt; i++) {
+		pr = &prgn->rects[i];
+		x0 = pr->x > x ? pr->x : x;
+		y0 = pr->y > y ? pr->y : y;
+		x1 = pr->x+pr->cx < x+cx ? pr->x+pr->cx : x+cx;
+		y1 = pr->y+pr->cy < y+cy ? pr->y+pr->cy : y+cy;
+
+		// Can't overflow as we never produce more rectangles than we had
+		AppendRect(prgn->rects, &j, x0, y0, x1, y1);
+	}
+	prgn->cnt = j;
+}
+
+bool_t gdispRegionOverlapsRect(const gdispRegion *prgn, coord_t x, coord_t y, coord_t cx, coord_t cy) {
+	unsigned	i;
+
+	for(i = 0; i < prgn->cnt; i++) {
+		if (RectsOverlap(&prgn->rects[i], x, y, x+cx, y+cy))
+			return TRUE;
+	}
+	return FALSE;
+}
+
+void gdispGFillRegion(GDisplay *g, const gdispRegion *prgn, color_t color) {
+	unsigned	i;
+
+	for(i = 0; i < prgn->cnt; i++)
+		gdispGFillArea(g, prgn->rects[i].x, prgn->rects[i].y, prgn->rects[i].cx, prgn->rects[i].cy, color);
+}
+
+#endif /* GFX_USE_GDISP && GDISP_NEED_REGIONS */
@@ -0,0 +1,135 @@
+/*
+ * This file is subject to the terms of the GFX License. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://ugfx.org/license.html
+ */
+
+/**
+ * @file    src/gdisp/gdisp_region.h
+ *
+ * @defgroup Region Region
+ * @ingroup GDISP
+ *
+ * @brief   Sub-Module for regions made up of multiple rectangles.
+ *
+ * @note	A region is a list of non-overlapping rectangles. It can describe areas such as the
+ * 			visible part of a partly covered window or the parts of a display that need redrawing.
+ * @note	Regions have a fixed maximum number of rectangles (GDISP_REGION_MAX_RECTS) so that
+ * 			no dynamic memory is required. Operations that would exceed this report it to the caller.
+ * @pre		GDISP_NEED_REGIONS must be TRUE in your gfxconf.h
+ * @{
+ */
+
+#ifndef _GDISP_REGION_H
+#define _GDISP_REGION_H
+
+#if (GFX_USE_GDISP && GDISP_NEED_REGIONS) || defined(__DOXYGEN__)
+
+/**
+ * @brief	A rectangle within a region
+ */
+typedef struct gdispRect {
+	coord_t		x, y;				/**< The top left corner */
+	coord_t		cx, cy;				/**< The width and height */
+	} gdispRect;
+
+/**
+ * @brief	A region - a list of non-overlapping rectangles
+ */
+typedef struct gdispRegion {
+	unsigned	cnt;								/**< The number of rectangles used */
+	gdispRect	rects[GDISP_REGION_MAX_RECTS];		/**< The rectangles */
+	} gdispRegion;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	/**
+	 * @brief	Make a region empty
+	 *
+	 * @param[in] prgn		The region
+	 */
+	#define gdispRegionClear(prgn)		{ (prgn)->cnt = 0; }
+
+	/**
+	 * @brief	Is a region empty
+	 *
+	 * @param[in] prgn		The region
+	 */
+	#define gdispRegionIsEmpty(prgn)	((prgn)->cnt == 0)
+
+	/**
+	 * @brief	Set a region to a single rectangle
+	 *
+	 * @param[in] prgn		The region
+	 * @param[in] x,y		The top left corner of the rectangle
+	 * @param[in] cx,cy		The size of the rectangle
+	 */
+	void gdispRegionSetRect(gdispRegion *prgn, coord_t x, coord_t y, coord_t cx, coord_t cy);
+
+	/**
+	 * @brief	Add a rectangle to a region
+	 * @return	TRUE if the result is exact. FALSE if there were too many rectangles
+	 * 			and the region has been enlarged to the bounding box of the result.
+	 *
+	 * @param[in] prgn		The region
+	 * @param[in] x,y		The top left corner of the rectangle
+	 * @param[in] cx,cy		The size of the rectangle
+	 *
+	 * @note	When this returns FALSE the region still contains the entire area requested
+	 * 			(plus some extra) so it remains suitable for tracking areas that need redrawing.
+	 */
+	bool_t gdispRegionAddRect(gdispRegion *prgn, coord_t x, coord_t y, coord_t cx, coord_t cy);
+
+	/**
+	 * @brief	Remove a rectangle from a region
+	 * @return	TRUE if successful. FALSE if the result needs too many rectangles
+	 * 			in which case the region is left unchanged.
+	 *
+	 * @param[in] prgn		The region
+	 * @param[in] x,y		The top left corner of the rectangle
+	 * @param[in] cx,cy		The size of the rectangle
+	 */
+	bool_t gdispRegionSubtractRect(gdispRegion *prgn, coord_t x, coord_t y, coord_t cx, coord_t cy);
+
+	/**
+	 * @brief	Limit a region to the area of a rectangle
+	 *
+	 * @param[in] prgn		The region
+	 * @param[in] x,y		The top left corner of the rectangle
+	 * @param[in] cx,cy		The size of the rectangle
+	 */
+	void gdispRegionIntersectRect(gdispRegion *prgn, coord_t x, coord_t y, coord_t cx, coord_t cy);
+
+	/**
+	 * @brief	Does any part of a region overlap a rectangle
+	 * @return	TRUE if they overlap
+	 *
+	 * @param[in] prgn		The region
+	 * @param[in] x,y		The top left corner of the rectangle
+	 * @param[in] cx,cy		The size of the rectangle
+	 */
+	bool_t gdispRegionOverlapsRect(const gdispRegion *prgn, coord_t x, coord_t y, coord_t cx, coord_t cy);
+
+	/**
+	 * @brief	Fill a region with a color
+	 *
+	 * @param[in] g			The display to use
+	 * @param[in] prgn		The region
+	 * @param[in] color		The color to use
+	 *
+	 * @api
+	 */
+	void gdispGFillRegion(GDisplay *g, const gdispRegion *prgn, color_t color);
+	#define gdispFillRegion(prgn, color)		gdispGFillRegion(GDISP, prgn, color)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GFX_USE_GDISP && GDISP_NEED_REGIONS */
+#endif /* _GDISP_REGION_H */
+/** @} */
+
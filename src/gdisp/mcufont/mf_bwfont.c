@@ -11,13 +11,24 @@
 
 #include <stdbool.h>
 
+#if MF_RANGE_CACHE_SIZE
+/* Cache of the range index where recent characters were found.
+ * See mf_rlefont.c for the details. */
+static uint16_t range_cache[MF_RANGE_CACHE_SIZE];
+#define RANGE_CACHE_SLOT(font, character) \
+    ((((size_t)(font) >> 4) ^ (character)) & (MF_RANGE_CACHE_SIZE - 1))
+#endif
+
 /* Find the character range and index that contains a given glyph.. */
 static const struct mf_bwfont_char_range_s *find_char_range(
     const struct mf_bwfont_s *font, uint16_t character, uint16_t *index_ret)
 {
-    unsigned i, index;
+    unsigned lo, hi, i, index;
     const struct mf_bwfont_char_range_s *range;
-    for (i = 0; i < font->char_range_count; i++)
+
+#if MF_RANGE_CACHE_SIZE
+    i = range_cache[RANGE_CACHE_SLOT(font, character)];
+    if (i < font->char_range_count)
     {
         range = &font->char_ranges[i];
         index = character - range->first_char;
@@ -27,6 +38,33 @@ static const struct mf_bwfont_char_range_s *find_char_range(
             return range;
         }
     }
+#endif
+
+    /* The font encoder sorts the ranges by character */
+    lo = 0;
+    hi = font->char_range_count;
+    while (lo < hi)
+    {
+        i = (lo + hi) / 2;
+        range = &font->char_ranges[i];
+        index = character - range->first_char;
+        if (character < range->first_char)
+        {
+            hi = i;
+        }
+        else if (index >= range->char_count)
+        {
+            lo = i + 1;
+        }
+        else
+        {
+#if MF_RANGE_CACHE_SIZE
+            range_cache[RANGE_CACHE_SLOT(font, character)] = i;
+#endif
+            *index_ret = index;
+            return range;
+        }
+    }
     
     return 0;
 }
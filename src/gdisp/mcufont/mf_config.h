@@ -158,6 +158,15 @@
 #define MF_KERNING_ZONES 16
 #endif
 
+/* Number of entries in the cache used to find the character range of a
+ * glyph. Each entry remembers the range where a recent character was found,
+ * so that fonts with many character ranges don't have to be searched again
+ * for every character. Must be a power of 2, or 0 to disable the cache.
+ */
+#ifndef MF_RANGE_CACHE_SIZE
+#define MF_RANGE_CACHE_SIZE 32
+#endif
+
 
 
 /* Add extern "C" when used from C++. */
@@ -31,23 +31,60 @@
 #define DICT_START3BIT  244
 #define DICT_START2BIT  252
 
+#if MF_RANGE_CACHE_SIZE
+/* Cache of the range index where recent characters were found. The font
+ * structures are constant, so the cache is shared by all fonts and indexed
+ * by both the font and the character. Entries are only hints and are checked
+ * before they are used, so collisions between fonts do no harm.
+ */
+static uint16_t range_cache[MF_RANGE_CACHE_SIZE];
+#define RANGE_CACHE_SLOT(font, character) \
+    ((((size_t)(font) >> 4) ^ (character)) & (MF_RANGE_CACHE_SIZE - 1))
+#endif
+
 /* Find a pointer to the glyph matching a given character by searching
  * through the character ranges. If the character is not found, return
- * pointer to the default glyph.
+ * a null pointer.
  */
 static const uint8_t *find_glyph(const struct mf_rlefont_s *font,
                                  uint16_t character)
 {
-   unsigned i, index;
+   unsigned lo, hi, i, index;
    const struct mf_rlefont_char_range_s *range;
-   for (i = 0; i < font->char_range_count; i++)
+
+#if MF_RANGE_CACHE_SIZE
+   i = range_cache[RANGE_CACHE_SLOT(font, character)];
+   if (i < font->char_range_count)
    {
        range = &font->char_ranges[i];
        index = character - range->first_char;
        if (character >= range->first_char && index < range->char_count)
+           return &range->glyph_data[range->glyph_offsets[index]];
+   }
+#endif
+
+   /* The font encoder sorts the ranges by character */
+   lo = 0;
+   hi = font->char_range_count;
+   while (lo < hi)
+   {
+       i = (lo + hi) / 2;
+       range = &font->char_ranges[i];
+       index = character - range->first_char;
+       if (character < range->first_char)
+       {
+           hi = i;
+       }
+       else if (index >= range->char_count)
+       {
+           lo = i + 1;
+       }
+       else
        {
-           unsigned offset = range->glyph_offsets[index];
-           return &range->glyph_data[offset];
+#if MF_RANGE_CACHE_SIZE
+           range_cache[RANGE_CACHE_SLOT(font, character)] = i;
+#endif
+           return &range->glyph_data[range->glyph_offsets[index]];
        }
    }
 
@@ -19,41 +19,144 @@
 #define GLISTENER_WITHLISTENER		0x0001			// The listener is current using the buffer
 #define GLISTENER_WITHSOURCE		0x0002			// The source is currently using the buffer
 
+/* The number of hash chains for finding the listeners of a source (must be a power of 2) */
+#if GEVENT_MAX_SOURCE_LISTENERS <= 8
+	#define GEVENT_SOURCE_HASH_SIZE		4
+#elif GEVENT_MAX_SOURCE_LISTENERS <= 32
+	#define GEVENT_SOURCE_HASH_SIZE		16
+#else
+	#define GEVENT_SOURCE_HASH_SIZE		64
+#endif
+
+/* Sources are pointers to objects so the bottom bits carry little information */
+#define hashSource(gsh)		((((size_t)(gsh) >> 4) ^ ((size_t)(gsh) >> 10)) & (GEVENT_SOURCE_HASH_SIZE-1))
+
 /* This mutex protects access to our tables */
 static gfxMutex	geventMutex;
 
 /* Our table of listener/source pairs */
 static GSourceListener		Assignments[GEVENT_MAX_SOURCE_LISTENERS];
 
+/* The listener/source pairs for each source hash and the unused table entries */
+static GSourceListener		*SourceHash[GEVENT_SOURCE_HASH_SIZE];
+static GSourceListener		*FreeAssignments;
+
+#if GEVENT_LISTENER_QUEUE_SIZE
+	/* The results of queueEvent() */
+	#define QUEUE_DROPPED		0			// There was no room for the event
+	#define QUEUE_MERGED		1			// The event was merged with one already queued
+	#define QUEUE_ADDED			2			// The event was queued and the listener needs to be woken
+
+	/* Add an event to the listener queue (or merge it with the last event queued). */
+	/* We already have the geventMutex */
+	static unsigned queueEvent(GListener *pl, const GEvent *pe) {
+		GEvent		*plast;
+		unsigned	held;
+
+		// One exit event is enough
+		if (pe->type == GEVENT_EXIT && pl->qcount && pl->queue[(pl->qhead + pl->qcount - 1) % GEVENT_LISTENER_QUEUE_SIZE].type == GEVENT_EXIT)
+			return QUEUE_MERGED;
+
+		// The oldest event can't be touched while the listener is processing it
+		held = (pl->flags & GLISTENER_WITHLISTENER) ? 1 : 0;
+		plast = pl->qcount > held ? &pl->queue[(pl->qhead + pl->qcount - 1) % GEVENT_LISTENER_QUEUE_SIZE] : 0;
+
+		// Can we merge it with the last event
+		if (plast && pl->coalesce && pe->type != GEVENT_EXIT && plast->type == pe->type && pl->coalesce(plast, pe))
+			return QUEUE_MERGED;
+
+		// Is there space
+		if (pl->qcount >= GEVENT_LISTENER_QUEUE_SIZE) {
+			// The exit event is too important to lose
+			if (plast && pe->type == GEVENT_EXIT) {
+				*plast = *pe;
+				return QUEUE_MERGED;
+			}
+			return QUEUE_DROPPED;
+		}
+
+		pl->queue[(pl->qhead + pl->qcount) % GEVENT_LISTENER_QUEUE_SIZE] = *pe;
+		pl->qcount++;
+		return QUEUE_ADDED;
+	}
+
+	/* The listener has finished with the oldest event */
+	/* We already have the geventMutex */
+	static void dequeueEvent(GListener *pl) {
+		if ((pl->flags & GLISTENER_WITHLISTENER)) {
+			pl->flags &= ~GLISTENER_WITHLISTENER;
+			if (++pl->qhead >= GEVENT_LISTENER_QUEUE_SIZE)
+				pl->qhead = 0;
+			pl->qcount--;
+		}
+	}
+#endif
+
 /* Send an exit event if possible. */
 /* We already have the geventMutex */
 static void doExitEvent(GListener *pl) {
-	// Don't do the exit if someone else currently is using the buffer
-	if (!(pl->flags & GLISTENER_WITHLISTENER)) {
-		pl->event.type = GEVENT_EXIT;								// Set up the EXIT event
-		pl->flags = GLISTENER_WITHLISTENER;							// Event buffer is now in use by the listener
-		gfxSemSignal(&pl->waitqueue);
-	}
+	#if GEVENT_LISTENER_QUEUE_SIZE
+		GEvent	ev;
+
+		ev.type = GEVENT_EXIT;
+		if (queueEvent(pl, &ev) == QUEUE_ADDED)
+			gfxSemSignal(&pl->waitqueue);
+	#else
+		// Don't do the exit if someone else currently is using the buffer
+		if (!(pl->flags & GLISTENER_WITHLISTENER)) {
+			pl->event.type = GEVENT_EXIT;								// Set up the EXIT event
+			pl->flags = GLISTENER_WITHLISTENER;							// Event buffer is now in use by the listener
+			gfxSemSignal(&pl->waitqueue);
+		}
+	#endif
 }
 
-/* Loop through the assignment table deleting this listener/source pair. */
+/* Delete the matching listener/source pairs from one hash chain. */
 /*	Null is treated as a wildcard. */
 /* We already have the geventMutex */
-static void deleteAssignments(GListener *pl, GSourceHandle gsh) {
+static void deleteChainAssignments(GSourceListener **ppsl, GListener *pl, GSourceHandle gsh) {
 	GSourceListener *psl;
 
-	for(psl = Assignments; psl < Assignments+GEVENT_MAX_SOURCE_LISTENERS; psl++) {
+	while((psl = *ppsl)) {
 		if ((!pl || psl->pListener == pl) && (!gsh || psl->pSource == gsh)) {
 			doExitEvent(psl->pListener);
+			*ppsl = psl->next;							// Unlink it
 			psl->pListener = 0;
 			psl->pSource = 0;
-		}
+			psl->next = FreeAssignments;				// Still a valid chain for a source holding it as its last listener
+			FreeAssignments = psl;
+		} else
+			ppsl = &psl->next;
+	}
+}
+
+/* Loop through the assignments deleting this listener/source pair. */
+/*	Null is treated as a wildcard. */
+/* We already have the geventMutex */
+static void deleteAssignments(GListener *pl, GSourceHandle gsh) {
+	unsigned	i;
+
+	// A source only has one chain to look at
+	if (gsh) {
+		deleteChainAssignments(&SourceHash[hashSource(gsh)], pl, gsh);
+		return;
 	}
+	for(i = 0; i < GEVENT_SOURCE_HASH_SIZE; i++)
+		deleteChainAssignments(&SourceHash[i], pl, gsh);
 }
 
 void _geventInit(void)
 {
+	GSourceListener *psl;
+
 	gfxMutexInit(&geventMutex);
+
+	// All the table entries are free
+	FreeAssignments = 0;
+	for(psl = Assignments+GEVENT_MAX_SOURCE_LISTENERS-1; psl >= Assignments; psl--) {
+		psl->next = FreeAssignments;
+		FreeAssignments = psl;
+	}
 }
 
 void _geventDeinit(void)
@@ -66,10 +169,15 @@ void geventListenerInit(GListener *pl) {
 	pl->callback = 0;										// No callback active
 	pl->event.type = GEVENT_NULL;							// Always safety
 	pl->flags = 0;
+	#if GEVENT_LISTENER_QUEUE_SIZE
+		pl->coalesce = 0;									// Queue every event
+		pl->qhead = 0;
+		pl->qcount = 0;
+	#endif
 }
 
 bool_t geventAttachSource(GListener *pl, GSourceHandle gsh, uint32_t flags) {
-	GSourceListener *psl, *pslfree;
+	GSourceListener *psl, *pslfree, **ppsl;
 
 	// Safety first
 	if (!pl || !gsh) {
@@ -79,26 +187,25 @@ bool_t geventAttachSource(GListener *pl, GSourceHandle gsh, uint32_t flags) {
 
 	gfxMutexEnter(&geventMutex);
 
-	// Check if this pair is already in the table (scan for a free slot at the same time)
-	pslfree = 0;
-	for(psl = Assignments; psl < Assignments+GEVENT_MAX_SOURCE_LISTENERS; psl++) {
-		
+	// Check if this pair is already in the source's chain (finding the end of the chain at the same time)
+	for(ppsl = &SourceHash[hashSource(gsh)]; (psl = *ppsl); ppsl = &psl->next) {
 		if (pl == psl->pListener && gsh == psl->pSource) {
 			// Just update the flags
 			psl->listenflags = flags;
 			gfxMutexExit(&geventMutex);
 			return TRUE;
 		}
-		if (!pslfree && !psl->pListener)
-			pslfree = psl;
 	}
 	
-	// A free slot was found - allocate it
-	if (pslfree) {
+	// Allocate a free slot and add it to the end of the chain so listeners get events in the order they attached
+	if ((pslfree = FreeAssignments)) {
+		FreeAssignments = pslfree->next;
 		pslfree->pListener = pl;
 		pslfree->pSource = gsh;
 		pslfree->listenflags = flags;
 		pslfree->srcflags = 0;
+		pslfree->next = 0;
+		*ppsl = pslfree;
 	}
 	gfxMutexExit(&geventMutex);
 	GEVENT_ASSERT(pslfree != 0);
@@ -133,19 +240,42 @@ GEvent *geventEventWait(GListener *pl, delaytime_t timeout) {
 	if (pl->callback)
 		return 0;
 		
-	// Event buffer is not in use by the listener - this is an implicit geventEventComplete() call
-	pl->flags &= ~GLISTENER_WITHLISTENER;
+	#if GEVENT_LISTENER_QUEUE_SIZE
+		// The oldest event is no longer in use by the listener - this is an implicit geventEventComplete() call
+		gfxMutexEnter(&geventMutex);
+		dequeueEvent(pl);
+		gfxMutexExit(&geventMutex);
+
+		// Wait for an event
+		if (!gfxSemWait(&pl->waitqueue, timeout))
+			return 0;				// Timeout
+
+		// The oldest event is now in use by the listener
+		gfxMutexEnter(&geventMutex);
+		pl->flags |= GLISTENER_WITHLISTENER;
+		gfxMutexExit(&geventMutex);
+		return &pl->queue[pl->qhead];
+	#else
+		// Event buffer is not in use by the listener - this is an implicit geventEventComplete() call
+		pl->flags &= ~GLISTENER_WITHLISTENER;
 
-	// Wait for an event
-	if (!gfxSemWait(&pl->waitqueue, timeout))
-		return 0;				// Timeout
+		// Wait for an event
+		if (!gfxSemWait(&pl->waitqueue, timeout))
+			return 0;				// Timeout
 
-	return &pl->event;
+		return &pl->event;
+	#endif
 }
 
 void geventEventComplete(GListener *pl) {
 	// The listener is done with the buffer
-	pl->flags &= ~GLISTENER_WITHLISTENER;
+	#if GEVENT_LISTENER_QUEUE_SIZE
+		gfxMutexEnter(&geventMutex);
+		dequeueEvent(pl);
+		gfxMutexExit(&geventMutex);
+	#else
+		pl->flags &= ~GLISTENER_WITHLISTENER;
+	#endif
 }
 
 void geventRegisterCallback(GListener *pl, GEventCallbackFn fn, void *param) {
@@ -154,14 +284,30 @@ void geventRegisterCallback(GListener *pl, GEventCallbackFn fn, void *param) {
 		doExitEvent(pl);
 		pl->param = param;						// Set the param
 		pl->callback = fn;						// Set the callback function
-		if (fn)
-			pl->flags &= ~GLISTENER_WITHLISTENER;	// The event buffer is immediately available
+		if (fn) {
+			#if GEVENT_LISTENER_QUEUE_SIZE
+				dequeueEvent(pl);					// The oldest queued event is finished with
+			#else
+				pl->flags &= ~GLISTENER_WITHLISTENER;	// The event buffer is immediately available
+			#endif
+		}
 		gfxMutexExit(&geventMutex);
 	}
 }
 
+#if GEVENT_LISTENER_QUEUE_SIZE
+	void geventRegisterCoalesce(GListener *pl, GEventCoalesceFn fn) {
+		if (pl) {
+			gfxMutexEnter(&geventMutex);
+			pl->coalesce = fn;
+			gfxMutexExit(&geventMutex);
+		}
+	}
+#endif
+
 GSourceListener *geventGetSourceListener(GSourceHandle gsh, GSourceListener *lastlr) {
 	GSourceListener *psl;
+	GListener		*pl;
 
 	// Safety first
 	if (!gsh)
@@ -170,34 +316,53 @@ GSourceListener *geventGetSourceListener(GSourceHandle gsh, GSourceListener *las
 	gfxMutexEnter(&geventMutex);
 
 	// Unlock the last listener event buffer if it wasn't used.
-	if (lastlr && lastlr->pListener && (lastlr->pListener->flags & GLISTENER_WITHSOURCE))
-		lastlr->pListener->flags &= ~GLISTENER_WITHSOURCE;
-		
-	// Loop through the table looking for attachments to this source
-	for(psl = lastlr ? (lastlr+1) : Assignments; psl < Assignments+GEVENT_MAX_SOURCE_LISTENERS; psl++) {
-		if (gsh == psl->pSource) {
-			gfxMutexExit(&geventMutex);
-			return psl;
-		}
+	if (lastlr && (pl = lastlr->pListener) && (pl->flags & GLISTENER_WITHSOURCE))
+		pl->flags &= ~GLISTENER_WITHSOURCE;
+
+	// Walk the source's hash chain looking for attachments to this source
+	for(psl = lastlr ? lastlr->next : SourceHash[hashSource(gsh)]; psl; psl = psl->next) {
+		if (gsh == psl->pSource)
+			break;
 	}
+
 	gfxMutexExit(&geventMutex);
-	return 0;
+	return psl;
 }
 
 GEvent *geventGetEventBuffer(GSourceListener *psl) {
 	gfxMutexEnter(&geventMutex);
-	if ((psl->pListener->flags & (GLISTENER_WITHLISTENER|GLISTENER_WITHSOURCE))) {
+
+	// The listener may have detached since the source found it
+	if (!psl->pListener) {
 		gfxMutexExit(&geventMutex);
 		return 0;
 	}
 
+	#if GEVENT_LISTENER_QUEUE_SIZE
+		// The buffer is only a staging area for the queue. Unless the event might be merged we need space in the queue.
+		if ((psl->pListener->flags & GLISTENER_WITHSOURCE)
+				|| (!psl->pListener->callback && !psl->pListener->coalesce && psl->pListener->qcount >= GEVENT_LISTENER_QUEUE_SIZE)) {
+			gfxMutexExit(&geventMutex);
+			return 0;
+		}
+	#else
+		if ((psl->pListener->flags & (GLISTENER_WITHLISTENER|GLISTENER_WITHSOURCE))) {
+			gfxMutexExit(&geventMutex);
+			return 0;
+		}
+	#endif
+
 	// Allocate the event buffer to the source
 	psl->pListener->flags |= GLISTENER_WITHSOURCE;
 	gfxMutexExit(&geventMutex);
 	return &psl->pListener->event;
 }
 
-void geventSendEvent(GSourceListener *psl) {
+bool_t geventSendEvent(GSourceListener *psl) {
+	#if GEVENT_LISTENER_QUEUE_SIZE
+		unsigned	res;
+	#endif
+
 	gfxMutexEnter(&geventMutex);
 	if (psl->pListener->callback) {
 
@@ -210,11 +375,24 @@ void geventSendEvent(GSourceListener *psl) {
 		psl->pListener->callback(psl->pListener->param, &psl->pListener->event);
 
 	} else {
-		// Wake up the listener
-		psl->pListener->flags = GLISTENER_WITHLISTENER;
-		gfxSemSignal(&psl->pListener->waitqueue);
-		gfxMutexExit(&geventMutex);
+		#if GEVENT_LISTENER_QUEUE_SIZE
+			// Queue the event and release the buffer. Wake up the listener if there is a new event.
+			psl->pListener->flags &= ~GLISTENER_WITHSOURCE;
+			res = queueEvent(psl->pListener, &psl->pListener->event);
+			if (res == QUEUE_ADDED)
+				gfxSemSignal(&psl->pListener->waitqueue);
+			gfxMutexExit(&geventMutex);
+
+			// A full queue that couldn't merge the event has lost it
+			return res != QUEUE_DROPPED;
+		#else
+			// Wake up the listener
+			psl->pListener->flags = GLISTENER_WITHLISTENER;
+			gfxSemSignal(&psl->pListener->waitqueue);
+			gfxMutexExit(&geventMutex);
+		#endif
 	}
+	return TRUE;
 }
 
 void geventDetachSourceListeners(GSourceHandle gsh) {
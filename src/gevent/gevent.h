@@ -53,6 +53,10 @@ typedef union GEvent_u {
 // A special callback function
 typedef void (*GEventCallbackFn)(void *param, GEvent *pe);
 
+// A function to merge a new event into the last queued event of the same type.
+//	It returns TRUE if the queued event now represents both (eg by copying the new event over it).
+typedef bool_t (*GEventCoalesceFn)(GEvent *pqueued, const GEvent *pe);
+
 // The Listener Object
 typedef struct GListener {
 	gfxSem				waitqueue;			// Private: Semaphore for the listener to wait on.
@@ -60,6 +64,12 @@ typedef struct GListener {
 	GEventCallbackFn	callback;			// Private: Call back Function
 	void				*param;				// Private: Parameter for the callback function.
 	GEvent				event;				// Public:  The event object into which the event information is stored.
+	#if GEVENT_LISTENER_QUEUE_SIZE
+		GEventCoalesceFn	coalesce;		// Private: Merges consecutive events (or NULL)
+		uint16_t			qhead;			// Private: The oldest queued event
+		uint16_t			qcount;			// Private: The number of queued events
+		GEvent				queue[GEVENT_LISTENER_QUEUE_SIZE];	// Private: The queued events
+	#endif
 	} GListener;
 
 // The Source Object
@@ -71,6 +81,7 @@ typedef struct GSourceListener_t {
 	GSource			*pSource;			// The source
 	uint32_t		listenflags;		// The flags the listener passed when the source was assigned to it.
 	uint32_t		srcflags;			// For the source's exclusive use. Initialised as 0 for a new listener source assignment.
+	struct GSourceListener_t	*next;	// Private: The next assignment with the same source hash
 	} GSourceListener;
 
 /*===========================================================================*/
@@ -100,6 +111,8 @@ extern "C" {
 								- Note: geventGetEventBuffer() may return FALSE to indicate the listener is currently not listening and
 									therefore no event should be sent. This situation enables the source to (optionally) flag
 									to the listener on its next wait that there have been missed events.
+								- Note: geventSendEvent() returns FALSE if the event was lost after all. The source should treat
+									this the same as geventGetEventBuffer() returning NULL.
 								- Note: The GSourceListener pointer (and the GEvent buffer) are only valid between
 									the geventGetSourceListener() call and either the geventSendEvent call or the next
 									geventGetSourceListener() call.
@@ -155,6 +168,7 @@ void geventDetachSource(GListener *pl, GSourceHandle gsh);
  * 			event) or after geventEventComplete() is called.
  *			The one listener object should not be waited on using more than one thread simultanously
  *			because of the implicit geventEventComplete() that occurs when this function is called.
+ * @note	When GEVENT_LISTENER_QUEUE_SIZE is non-zero events are queued and are returned oldest first.
  *
  * @param[in] pl		The listener
  * @param[in] timeout	The timeout in milliseconds
@@ -195,6 +209,23 @@ void geventEventComplete(GListener *pl);
  */
 void geventRegisterCallback(GListener *pl, GEventCallbackFn fn, void *param);
 
+#if GEVENT_LISTENER_QUEUE_SIZE || defined(__DOXYGEN__)
+	/**
+	 * @brief	Register a function to merge consecutive events of the same type on a listener.
+	 * @details	When a new event arrives and the most recently queued event (that is not currently being
+	 * 			processed by the listener) has the same type, the function is called to try to merge the new
+	 * 			event into it. For example, mouse movements can be merged so only the latest position is kept.
+	 * @note	Only available when GEVENT_LISTENER_QUEUE_SIZE is non-zero
+	 * @note	The function is called with the GEVENT mutex locked. It must not call any GEVENT functions.
+	 *
+	 * @param[in] pl		The Listener
+	 * @param[in] fn		The function to merge events or NULL to queue every event
+	 *
+	 * @api
+	 */
+	void geventRegisterCoalesce(GListener *pl, GEventCoalesceFn fn);
+#endif
+
 /*---------- Source Functions --------------------------------------------*/
 
 /**
@@ -218,16 +249,24 @@ GSourceListener *geventGetSourceListener(GSourceHandle gsh, GSourceListener *las
  * @param[in] psl	The source listener
  *
  * @return	NULL if the event buffer for this listener is currently in use.
+ * @note	When GEVENT_LISTENER_QUEUE_SIZE is non-zero the buffer is only unavailable while another
+ * 			source is filling it or when the listener's queue is full and the listener has no
+ * 			coalesce function. If the listener has a coalesce function the buffer is returned as the
+ * 			event may still be merged and @p geventSendEvent() reports whether it was lost.
  */
 GEvent *geventGetEventBuffer(GSourceListener *psl);
 
 /** 
  * @brief	Called by a source to indicate the listener's event buffer has been filled.
- * @details	After calling this function the source must not reference in fields in the @p GSourceListener or the event buffer.
+ * @details	After calling this function the source must not reference in fields in the @p GSourceListener or the event buffer
+ * 			except that on a FALSE return it may record the missed event in the @p srcflags field.
  *
  * @param[in] psl	The source listener
+ *
+ * @return	FALSE if the event was lost. This can only happen when GEVENT_LISTENER_QUEUE_SIZE is non-zero and the
+ * 			listener's queue is full and the event could not be merged by the listener's coalesce function.
  */
-void geventSendEvent(GSourceListener *psl);
+bool_t geventSendEvent(GSourceListener *psl);
 
 /**
  * @brief	Detach any listener that has this source attached
@@ -45,10 +45,25 @@
 	/**
 	 * @brief   Defines the maximum Source/Listener pairs in the system.
 	 * @details	Defaults to 32
+	 * @note	Pairs are hashed by source so increasing this costs memory but does not slow
+	 * 			down sending events.
 	 */
 	#ifndef GEVENT_MAX_SOURCE_LISTENERS
 		#define GEVENT_MAX_SOURCE_LISTENERS		32
 	#endif
+	/**
+	 * @brief   Defines the number of events that can be queued on each listener.
+	 * @details	Defaults to 0
+	 * @note	When 0 each listener has a single event buffer and a source must drop
+	 * 			an event if the listener has not finished with the previous one.
+	 * @note	When non-zero each listener has a queue of this many events (each of
+	 * 			GEVENT_MAXIMUM_SIZE bytes). Events are only dropped when the queue is full
+	 * 			and consecutive events can be merged by the listener's coalesce function.
+	 * 			See @p geventRegisterCoalesce().
+	 */
+	#ifndef GEVENT_LISTENER_QUEUE_SIZE
+		#define GEVENT_LISTENER_QUEUE_SIZE		0
+	#endif
 /** @} */
 
 #endif /* _GEVENT_OPTIONS_H */
@@ -11,6 +11,10 @@
 
 #include "gfile_fs.h"
 
+#if GFILE_NEED_READAHEAD
+	#include <string.h>				// For memcpy
+#endif
+
 /**
  * Define the VMT's for the file-systems we want to search for files.
  * Virtual file-systems that have special open() calls do not need to
@@ -125,6 +129,7 @@ GFILE *_gfileFindSlot(const char *mode) {
 			default:
 				return 0;
 			}
+			_gfileInitReadAhead(f);
 			return f;
 		}
 	}
@@ -246,6 +251,12 @@ static bool_t testopen(const GFILEVMT *p, GFILE *f, const char *fname) {
 	f->flags |= GFILEFLG_OPEN;
 	if (p->flags & GFSFLG_SEEKABLE)
 		f->flags |= GFILEFLG_CANSEEK;
+
+	#if GFILE_NEED_READAHEAD
+		// Read-only files on slow file-systems get a read-ahead buffer
+		if ((f->flags & (GFILEFLG_READ|GFILEFLG_WRITE)) == GFILEFLG_READ && !(p->flags & GFSFLG_FAST) && !p->direct)
+			f->rabuf = gfxAlloc(GFILE_READAHEAD_SIZE);
+	#endif
 	return TRUE;
 }
 
@@ -283,9 +294,48 @@ void gfileClose(GFILE *f) {
 		return;
 	if (f->vmt->close)
 		f->vmt->close(f);
+	#if GFILE_NEED_READAHEAD
+		if (f->rabuf) {
+			gfxFree(f->rabuf);
+			f->rabuf = 0;
+		}
+	#endif
 	f->flags = 0;
 }
 
+#if GFILE_NEED_READAHEAD
+	static size_t readahead(GFILE *f, void *buf, size_t len) {
+		size_t	done, cnt;
+		int		res;
+
+		for(done = 0; ; done += cnt, len -= cnt, buf = (char *)buf + cnt) {
+			// Use whatever is already in the buffer
+			cnt = f->ralen - f->rapos;
+			if (cnt > len)
+				cnt = len;
+			memcpy(buf, f->rabuf + f->rapos, cnt);
+			f->rapos += cnt;
+			if (cnt == len)
+				return done + cnt;
+			f->rapos = f->ralen = 0;
+
+			// Big reads go straight to the file-system
+			if (len - cnt >= GFILE_READAHEAD_SIZE) {
+				if ((res = f->vmt->read(f, (char *)buf + cnt, len - cnt)) <= 0)
+					return done + cnt;
+				f->pos += res;
+				return done + cnt + res;
+			}
+
+			// Refill the buffer
+			if ((res = f->vmt->read(f, f->rabuf, GFILE_READAHEAD_SIZE)) <= 0)
+				return done + cnt;
+			f->pos += res;
+			f->ralen = res;
+		}
+	}
+#endif
+
 size_t gfileRead(GFILE *f, void *buf, size_t len) {
 	size_t	res;
 
@@ -293,12 +343,34 @@ size_t gfileRead(GFILE *f, void *buf, size_t len) {
 		return 0;
 	if (!f->vmt->read)
 		return 0;
+	#if GFILE_NEED_READAHEAD
+		if (f->rabuf)
+			return readahead(f, buf, len);
+	#endif
 	if ((res = f->vmt->read(f, buf, len)) <= 0)
 		return 0;
 	f->pos += res;
 	return res;
 }
 
+const void *gfileReadDirect(GFILE *f, size_t *len) {
+	const void	*p;
+	long int	cnt;
+
+	if (!f || (f->flags & (GFILEFLG_OPEN|GFILEFLG_READ)) != (GFILEFLG_OPEN|GFILEFLG_READ))
+		return 0;
+	if (!f->vmt->direct)
+		return 0;
+	cnt = *len;
+	if (!(p = f->vmt->direct(f, &cnt)))
+		return 0;
+	if (cnt < 0)
+		cnt = 0;
+	f->pos += cnt;
+	*len = cnt;
+	return p;
+}
+
 size_t gfileWrite(GFILE *f, const void *buf, size_t len) {
 	size_t	res;
 
@@ -315,15 +387,29 @@ size_t gfileWrite(GFILE *f, const void *buf, size_t len) {
 long int gfileGetPos(GFILE *f) {
 	if (!f || !(f->flags & GFILEFLG_OPEN))
 		return 0;
-	return f->pos;
+	#if GFILE_NEED_READAHEAD
+		return f->pos - (f->ralen - f->rapos);
+	#else
+		return f->pos;
+	#endif
 }
 
 bool_t gfileSetPos(GFILE *f, long int pos) {
 	if (!f || !(f->flags & GFILEFLG_OPEN))
 		return FALSE;
+	#if GFILE_NEED_READAHEAD
+		// Seeking within the read-ahead buffer doesn't need the file-system
+		if (f->rabuf && pos <= f->pos && pos >= f->pos - f->ralen) {
+			f->rapos = f->ralen - (f->pos - pos);
+			return TRUE;
+		}
+	#endif
 	if (!f->vmt->setpos || !f->vmt->setpos(f, pos))
 		return FALSE;
 	f->pos = pos;
+	#if GFILE_NEED_READAHEAD
+		f->rapos = f->ralen = 0;
+	#endif
 	return TRUE;
 }
 
@@ -338,6 +424,10 @@ long int gfileGetSize(GFILE *f) {
 bool_t gfileEOF(GFILE *f) {
 	if (!f || !(f->flags & GFILEFLG_OPEN))
 		return TRUE;
+	#if GFILE_NEED_READAHEAD
+		if (f->rapos < f->ralen)
+			return FALSE;
+	#endif
 	if (!f->vmt->eof)
 		return FALSE;
 	return f->vmt->eof(f);
@@ -151,6 +151,26 @@ extern "C" {
 	 */
 	size_t		gfileRead(GFILE *f, void *buf, size_t len);
 
+	/**
+	 * @brief					Read from file without copying the data
+	 * @details					Returns a pointer straight to the file data at the read/write cursor
+	 * 							and moves the cursor past the bytes returned.
+	 *
+	 * @param[in] f				The file
+	 * @param[in,out] len		On entry the amount of bytes wanted. On return the amount of bytes
+	 * 							that can be read from the returned pointer.
+	 *
+	 * @return					A pointer to the data or NULL if the file system can't provide one
+	 *
+	 * @note					Only memory based file systems (ROMFS, RAMFS and @p gfileOpenMemory()) support this.
+	 * 							RAMFS returns at most the rest of one block.
+	 * 							If NULL is returned the cursor is unchanged and @p gfileRead() should be used instead.
+	 * @note					The data is read-only and has no particular alignment.
+	 *
+	 * @api
+	 */
+	const void *gfileReadDirect(GFILE *f, size_t *len);
+
 	/**
 	 * @brief					Write to file
 	 * @details					Write a given amount of bytes to the file
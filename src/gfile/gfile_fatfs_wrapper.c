@@ -11,10 +11,144 @@
 
 #include "gfile_fatfs_wrapper.h"
 
+#if GFILE_FATFS_CACHE_SECTORS
+	#if _MIN_SS != _MAX_SS
+		#error "GFILE: GFILE_FATFS_CACHE_SECTORS requires a fixed sector size (_MIN_SS == _MAX_SS)"
+	#endif
+
+	#include <string.h>				// For memcpy
+
+	// Route the FATFS sector access through our cache
+	static DSTATUS fatfs_cache_status(BYTE pdrv);
+	static DSTATUS fatfs_cache_initialize(BYTE pdrv);
+	static DRESULT fatfs_cache_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count);
+	#define disk_status		fatfs_cache_status
+	#define disk_initialize	fatfs_cache_initialize
+	#define disk_read		fatfs_cache_read
+	#if !_FS_READONLY
+		static DRESULT fatfs_cache_write(BYTE pdrv, const BYTE* buff, DWORD sector, UINT count);
+		#define disk_write		fatfs_cache_write
+	#endif
+#endif
+
 // Include the source we want
 #include "../../3rdparty/fatfs-0.10b/src/ff.c"
 #include "../../3rdparty/fatfs-0.10b/src/option/unicode.c"
 
+#if GFILE_FATFS_CACHE_SECTORS
+	#undef disk_status
+	#undef disk_initialize
+	#undef disk_read
+	#undef disk_write
+
+	/*------------------------------------------------------------------------*/
+	/* A small least recently used sector cache shared by all volumes.        */
+	/* Only single sector reads are cached - they are the FAT and directory   */
+	/* accesses. Writes go straight through and update any cached copy.       */
+	/* A drive's entries are thrown away whenever it is (re)initialised or    */
+	/* reports that it needs to be - eg. after the media has been changed.    */
+	/*------------------------------------------------------------------------*/
+	typedef struct fatfsCacheEntry {
+		DWORD		sector;
+		uint32_t	used;					// When this entry was last used (0 = empty)
+		BYTE		pdrv;
+		BYTE		data[_MAX_SS];
+	} fatfsCacheEntry;
+
+	static fatfsCacheEntry	fatfs_cache[GFILE_FATFS_CACHE_SECTORS];
+	static uint32_t			fatfs_cache_clock;
+
+	static fatfsCacheEntry *fatfs_cache_find(BYTE pdrv, DWORD sector)
+	{
+		fatfsCacheEntry	*pc;
+
+		for(pc = fatfs_cache; pc < &fatfs_cache[GFILE_FATFS_CACHE_SECTORS]; pc++) {
+			if (pc->used && pc->sector == sector && pc->pdrv == pdrv)
+				return pc;
+		}
+		return 0;
+	}
+
+	void _gfileFatfsCacheInvalidate(BYTE pdrv)
+	{
+		fatfsCacheEntry	*pc;
+
+		for(pc = fatfs_cache; pc < &fatfs_cache[GFILE_FATFS_CACHE_SECTORS]; pc++) {
+			if (pc->pdrv == pdrv)
+				pc->used = 0;
+		}
+	}
+
+	static DSTATUS fatfs_cache_status(BYTE pdrv)
+	{
+		DSTATUS			stat;
+
+		// A drive that needs initialising may have had its media changed
+		if ((stat = disk_status(pdrv)) & STA_NOINIT)
+			_gfileFatfsCacheInvalidate(pdrv);
+		return stat;
+	}
+
+	static DSTATUS fatfs_cache_initialize(BYTE pdrv)
+	{
+		// FATFS initialises the drive each time it mounts the volume
+		_gfileFatfsCacheInvalidate(pdrv);
+		return disk_initialize(pdrv);
+	}
+
+	static DRESULT fatfs_cache_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count)
+	{
+		fatfsCacheEntry	*pc, *pv;
+		DRESULT			res;
+
+		// Multiple sector reads are file data - the disk is always up to date so just read it
+		if (count != 1)
+			return disk_read(pdrv, buff, sector, count);
+
+		if ((pc = fatfs_cache_find(pdrv, sector))) {
+			memcpy(buff, pc->data, _MAX_SS);
+			pc->used = ++fatfs_cache_clock;
+			return RES_OK;
+		}
+
+		if ((res = disk_read(pdrv, buff, sector, 1)) != RES_OK)
+			return res;
+
+		// Replace an empty or the least recently used entry
+		for(pv = pc = fatfs_cache; pc < &fatfs_cache[GFILE_FATFS_CACHE_SECTORS]; pc++) {
+			if (pc->used < pv->used)
+				pv = pc;
+		}
+		memcpy(pv->data, buff, _MAX_SS);
+		pv->sector = sector;
+		pv->pdrv = pdrv;
+		pv->used = ++fatfs_cache_clock;
+		return RES_OK;
+	}
+
+	#if !_FS_READONLY
+		static DRESULT fatfs_cache_write(BYTE pdrv, const BYTE* buff, DWORD sector, UINT count)
+		{
+			fatfsCacheEntry	*pc;
+			DRESULT			res;
+			UINT			i;
+
+			res = disk_write(pdrv, buff, sector, count);
+
+			// Keep any cached copies the same as the disk
+			for(i = 0; i < count; i++) {
+				if ((pc = fatfs_cache_find(pdrv, sector+i))) {
+					if (res == RES_OK)
+						memcpy(pc->data, buff + i * _MAX_SS, _MAX_SS);
+					else
+						pc->used = 0;
+				}
+			}
+			return res;
+		}
+	#endif
+#endif
+
 // Extra operating system support
 #if _FS_REENTRANT
 	/*------------------------------------------------------------------------*/
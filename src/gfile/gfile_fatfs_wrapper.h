@@ -29,4 +29,9 @@
 // Include the fatfs diskio API
 #include "../../3rdparty/fatfs-0.10b/src/diskio.h"
 
+#if GFILE_FATFS_CACHE_SECTORS && !GFILE_FATFS_EXTERNAL_LIB
+	// Throw away any cached sectors for a physical drive
+	void _gfileFatfsCacheInvalidate(BYTE pdrv);
+#endif
+
 #endif //_FATFS_WRAPPER
@@ -30,6 +30,11 @@ struct GFILE {
 		#define GFILEFLG_TRUNC			0x0400		// On open truncate the file
 	void *					obj;
 	long int				pos;
+	#if GFILE_NEED_READAHEAD
+		uint8_t *			rabuf;				// The read-ahead buffer (if any). pos is the file-system position at its end.
+		uint16_t			rapos;				// The next unread byte in the read-ahead buffer
+		uint16_t			ralen;				// The number of valid bytes in the read-ahead buffer
+	#endif
 };
 
 struct gfileList {
@@ -65,8 +70,16 @@ typedef struct GFILEVMT {
 		const char *(*flread)	(gfileList *pfl);
 		void		(*flclose)	(gfileList *pfl);
 	#endif
+	const void *(*direct)	(GFILE *f, long int *len);		// Pointer to the data at f->pos. Only for GFSFLG_FAST file-systems that read from f->pos.
 } GFILEVMT;
 
 GFILE *_gfileFindSlot(const char *mode);
 
+// Every GFILE constructor must call this before the file is used
+#if GFILE_NEED_READAHEAD
+	#define _gfileInitReadAhead(f)		{ (f)->rabuf = 0; (f)->rapos = (f)->ralen = 0; }
+#else
+	#define _gfileInitReadAhead(f)
+#endif
+
 #endif //_GFILE_FS_H
@@ -32,6 +32,7 @@ static const GFILEVMT FsCHIBIOSVMT = {
 	#if GFILE_NEED_FILELISTS
 		0, 0, 0,
 	#endif
+	0,
 };
 
 #if CH_KERNEL_MAJOR == 2
@@ -57,11 +57,12 @@ const GFILEVMT FsFatFSVMT = {
 	fatfsMount, fatfsUnmount, fatfsSync,
 	#if GFILE_NEED_FILELISTS
 		#if _FS_MINIMIZE <= 1
-			fatfsFlOpen, fatfsFlRead, fatfsFlClose
+			fatfsFlOpen, fatfsFlRead, fatfsFlClose,
 		#else
-			0, 0, 0
+			0, 0, 0,
 		#endif
 	#endif
+	0,
 };
 
 // Our directory list structure
@@ -141,6 +142,31 @@ static bool_t fatfsRename(const char* oldname, const char* newname)
 	return TRUE;
 }
 
+#if _USE_FASTSEEK
+	// Build a cluster link map table so that seeks don't need to walk the FAT chain
+	static void fatfs_linkmap(FIL* fd)
+	{
+		DWORD*	tbl;
+		DWORD	len;
+		FRESULT	ferr;
+
+		// Start with enough for 3 fragments and grow it if the file is more fragmented
+		for(len = 8; ; ) {
+			if (!(tbl = gfxAlloc(len * sizeof(DWORD))))
+				break;
+			tbl[0] = len;
+			fd->cltbl = tbl;
+			if ((ferr = f_lseek(fd, CREATE_LINKMAP)) == FR_OK)
+				return;
+			len = tbl[0];
+			gfxFree(tbl);
+			if (ferr != FR_NOT_ENOUGH_CORE)
+				break;
+		}
+		fd->cltbl = 0;
+	}
+#endif
+
 static bool_t fatfsOpen(GFILE* f, const char* fname)
 {
 	FIL* fd;
@@ -162,6 +188,12 @@ static bool_t fatfsOpen(GFILE* f, const char* fname)
 
 	f->obj = (void*)fd;
 
+	#if _USE_FASTSEEK
+		// FatFS can't extend a file in fast seek mode so we only use it for read-only files
+		if (!(f->flags & GFILEFLG_WRITE) && f_size(fd))
+			fatfs_linkmap(fd);
+	#endif
+
 	#if !GFILE_NEED_NOAUTOSYNC
 		// no need to sync when not opening for write
 		if (f->flags & GFILEFLG_WRITE) {
@@ -176,6 +208,10 @@ static void fatfsClose(GFILE* f)
 {
 	if ((FIL*)f->obj != 0) { 
 		f_close( (FIL*)f->obj );
+		#if _USE_FASTSEEK
+			if (((FIL*)f->obj)->cltbl)
+				gfxFree(((FIL*)f->obj)->cltbl);
+		#endif
 		gfxFree( (FIL*)f->obj );
 	}
 }
@@ -247,6 +283,10 @@ static bool_t fatfsUnmount(const char* drive)
 	if (fatfs_mounted) {
 		// FatFS does not provide an unmount routine.
 		fatfs_mounted = FALSE;
+		#if GFILE_FATFS_CACHE_SECTORS && !GFILE_FATFS_EXTERNAL_LIB
+			// The media may be changed before the next mount
+			_gfileFatfsCacheInvalidate(fatfs_fs.drv);
+		#endif
 		return TRUE;
 	}
 
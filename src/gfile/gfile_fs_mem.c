@@ -20,9 +20,10 @@
 static int MEMRead(GFILE *f, void *buf, int size);
 static int MEMWrite(GFILE *f, const void *buf, int size);
 static bool_t MEMSetpos(GFILE *f, long int pos);
+static const void *MEMDirect(GFILE *f, long int *len);
 
 static const GFILEVMT FsMemVMT = {
-	GFSFLG_SEEKABLE|GFSFLG_WRITEABLE,					// flags
+	GFSFLG_SEEKABLE|GFSFLG_WRITEABLE|GFSFLG_FAST,		// flags
 	0,													// prefix
 	0, 0, 0, 0,
 	0, 0, MEMRead, MEMWrite,
@@ -31,6 +32,7 @@ static const GFILEVMT FsMemVMT = {
 	#if GFILE_NEED_FILELISTS
 		0, 0, 0,
 	#endif
+	MEMDirect,
 };
 
 static int MEMRead(GFILE *f, void *buf, int size) {
@@ -46,6 +48,10 @@ static bool_t MEMSetpos(GFILE *f, long int pos) {
 	(void) pos;
 	return TRUE;
 }
+static const void *MEMDirect(GFILE *f, long int *len) {
+	(void) len;
+	return ((char *)f->obj)+f->pos;
+}
 
 GFILE *	gfileOpenMemory(void *memptr, const char *mode) {
 	GFILE	*f;
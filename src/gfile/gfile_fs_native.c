@@ -52,8 +52,9 @@ const GFILEVMT FsNativeVMT = {
 	NativeSetpos, NativeGetsize, NativeEof,
 	0, 0, 0,
 	#if GFILE_NEED_FILELISTS
-		NativeFlOpen, NativeFlRead, NativeFlClose
+		NativeFlOpen, NativeFlRead, NativeFlClose,
 	#endif
+	0,
 };
 
 void _gfileNativeAssignStdio(void) {
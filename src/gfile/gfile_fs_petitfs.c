@@ -43,11 +43,12 @@ const GFILEVMT FsPetitFSVMT = {
 	0, 0, 0,			// No Mount, UnMount or Sync
 	#if GFILE_NEED_FILELISTS
 		#if _USE_DIR
-			petitfsFlOpen, petitfsFlRead, petitfsFlClose
+			petitfsFlOpen, petitfsFlRead, petitfsFlClose,
 		#else
-			0, 0, 0
+			0, 0, 0,
 		#endif
 	#endif
+	0,
 };
 
 // Our directory list structure
@@ -15,18 +15,381 @@
 
 #include "gfile_fs.h"
 
-#error "GFILE: RAMFS Not implemented yet"
+#include <string.h>
+
+#if (GFILE_RAMFS_BLOCK_SIZE & (GFILE_RAMFS_BLOCK_SIZE-1)) || GFILE_RAMFS_BLOCK_SIZE < 16
+	#error "GFILE: GFILE_RAMFS_BLOCK_SIZE must be a power of 2 and at least 16"
+#endif
+
+/**
+ * Each file is a linked list of fixed size blocks allocated with gfxAlloc().
+ * There are no directories - just a flat list of file names.
+ */
+typedef struct RAMBlock {
+	struct RAMBlock *		next;
+	uint8_t					data[GFILE_RAMFS_BLOCK_SIZE];
+} RAMBlock;
+
+typedef struct RAMFile {
+	struct RAMFile *		next;
+	char *					name;
+	RAMBlock *				first;
+	RAMBlock *				last;
+	long int				size;
+	uint16_t				opencnt;		// The number of GFILE's that have this file open
+	uint16_t				gen;			// Incremented whenever blocks are freed so open cursors can be invalidated
+	bool_t					deleted;		// Deleted while open - free it on the last close
+} RAMFile;
+
+// An open file. The cursor remembers the block we last used so sequential access doesn't rescan the list.
+typedef struct RAMOpenFile {
+	RAMFile *				file;
+	RAMBlock *				blk;			// The cursor block (or NULL)
+	long int				blkpos;			// The file position of the start of the cursor block
+	uint16_t				gen;			// The file generation the cursor is valid for
+} RAMOpenFile;
+
+typedef struct RAMFileList {
+	gfileList				fl;
+	unsigned				index;			// The index of the next file to return
+} RAMFileList;
+
+static RAMFile *			RAMHead;
+#if GFILE_RAMFS_SIZE
+	static long int			RAMUsed;		// The number of bytes used by file blocks
+#endif
+
+static bool_t RAMDel(const char *fname);
+static bool_t RAMExists(const char *fname);
+static long int	RAMFilesize(const char *fname);
+static bool_t RAMRen(const char *oldname, const char *newname);
+static bool_t RAMOpen(GFILE *f, const char *fname);
+static void RAMClose(GFILE *f);
+static int RAMRead(GFILE *f, void *buf, int size);
+static int RAMWrite(GFILE *f, const void *buf, int size);
+static bool_t RAMSetpos(GFILE *f, long int pos);
+static long int RAMGetsize(GFILE *f);
+static bool_t RAMEof(GFILE *f);
+static const void *RAMDirect(GFILE *f, long int *len);
+#if GFILE_NEED_FILELISTS
+	static gfileList *RAMFlOpen(const char *path, bool_t dirs);
+	static const char *RAMFlRead(gfileList *pfl);
+	static void RAMFlClose(gfileList *pfl);
+#endif
 
 const GFILEVMT FsRAMVMT = {
-	0,								// flags
-	'R',							// prefix
-	0, 0, 0, 0,
-	0, 0, 0, 0,
-	0, 0, 0,
+	GFSFLG_WRITEABLE|GFSFLG_CASESENSITIVE|GFSFLG_SEEKABLE|GFSFLG_FAST,	// flags
+	'R',																// prefix
+	RAMDel, RAMExists, RAMFilesize, RAMRen,
+	RAMOpen, RAMClose, RAMRead, RAMWrite,
+	RAMSetpos, RAMGetsize, RAMEof,
 	0, 0, 0,
 	#if GFILE_NEED_FILELISTS
-		0, 0, 0,
+		RAMFlOpen, RAMFlRead, RAMFlClose,
 	#endif
+	RAMDirect,
 };
 
+static RAMFile *RAMFindFile(const char *fname, RAMFile ***pprev)
+{
+	RAMFile	**pp;
+
+	for(pp = &RAMHead; *pp; pp = &pp[0]->next) {
+		if (!strcmp(pp[0]->name, fname)) {
+			if (pprev)
+				*pprev = pp;
+			return *pp;
+		}
+	}
+	return 0;
+}
+
+static void RAMTruncate(RAMFile *p)
+{
+	RAMBlock	*b;
+
+	while((b = p->first)) {
+		p->first = b->next;
+		gfxFree(b);
+		#if GFILE_RAMFS_SIZE
+			RAMUsed -= GFILE_RAMFS_BLOCK_SIZE;
+		#endif
+	}
+	p->last = 0;
+	p->size = 0;
+	p->gen++;
+}
+
+static void RAMFreeFile(RAMFile *p)
+{
+	RAMTruncate(p);
+	gfxFree(p->name);
+	gfxFree(p);
+}
+
+// Find the block containing file position pos. Returns NULL if pos is past the last block.
+static RAMBlock *RAMSeek(RAMOpenFile *o, long int pos)
+{
+	RAMBlock	*b;
+	long int	bpos;
+
+	// Start from the cursor if we can, otherwise from the start of the file
+	if (o->blk && o->gen == o->file->gen && o->blkpos <= pos) {
+		b = o->blk;
+		bpos = o->blkpos;
+	} else {
+		b = o->file->first;
+		bpos = 0;
+	}
+	for(; b && pos >= bpos + GFILE_RAMFS_BLOCK_SIZE; b = b->next)
+		bpos += GFILE_RAMFS_BLOCK_SIZE;
+	if (b) {
+		o->blk = b;
+		o->blkpos = bpos;
+		o->gen = o->file->gen;
+	}
+	return b;
+}
+
+static bool_t RAMDel(const char *fname)
+{
+	RAMFile	*p, **pp;
+
+	if (!(p = RAMFindFile(fname, &pp)))
+		return FALSE;
+	*pp = p->next;
+
+	// Files that are still open are freed when they are closed
+	if (p->opencnt)
+		p->deleted = TRUE;
+	else
+		RAMFreeFile(p);
+	return TRUE;
+}
+
+static bool_t RAMExists(const char *fname)
+{
+	return RAMFindFile(fname, 0) != 0;
+}
+
+static long int	RAMFilesize(const char *fname)
+{
+	RAMFile	*p;
+
+	if (!(p = RAMFindFile(fname, 0))) return -1;
+	return p->size;
+}
+
+static bool_t RAMRen(const char *oldname, const char *newname)
+{
+	RAMFile	*p;
+	char	*n;
+
+	if (!(p = RAMFindFile(oldname, 0)) || RAMFindFile(newname, 0))
+		return FALSE;
+	if (!(n = gfxAlloc(strlen(newname)+1)))
+		return FALSE;
+	strcpy(n, newname);
+	gfxFree(p->name);
+	p->name = n;
+	return TRUE;
+}
+
+static bool_t RAMOpen(GFILE *f, const char *fname)
+{
+	RAMFile		*p;
+	RAMOpenFile	*o;
+
+	if ((p = RAMFindFile(fname, 0))) {
+		if ((f->flags & GFILEFLG_MUSTNOTEXIST))
+			return FALSE;
+	} else if ((f->flags & GFILEFLG_MUSTEXIST) || !fname[0])
+		return FALSE;
+
+	if (!(o = gfxAlloc(sizeof(RAMOpenFile))))
+		return FALSE;
+
+	// Create the file if required
+	if (!p) {
+		if (!(p = gfxAlloc(sizeof(RAMFile)))) {
+			gfxFree(o);
+			return FALSE;
+		}
+		if (!(p->name = gfxAlloc(strlen(fname)+1))) {
+			gfxFree(p);
+			gfxFree(o);
+			return FALSE;
+		}
+		strcpy(p->name, fname);
+		p->first = p->last = 0;
+		p->size = 0;
+		p->opencnt = 0;
+		p->gen = 0;
+		p->deleted = FALSE;
+		p->next = RAMHead;
+		RAMHead = p;
+	} else if ((f->flags & GFILEFLG_TRUNC))
+		RAMTruncate(p);
+
+	p->opencnt++;
+	o->file = p;
+	o->blk = 0;
+	o->blkpos = 0;
+	o->gen = p->gen;
+	f->obj = (void *)o;
+	return TRUE;
+}
+
+static void RAMClose(GFILE *f)
+{
+	RAMOpenFile	*o;
+
+	o = (RAMOpenFile *)f->obj;
+	if (!--o->file->opencnt && o->file->deleted)
+		RAMFreeFile(o->file);
+	gfxFree(o);
+}
+
+static int RAMRead(GFILE *f, void *buf, int size)
+{
+	RAMOpenFile	*o;
+	RAMBlock	*b;
+	long int	pos;
+	int			done, len;
+
+	o = (RAMOpenFile *)f->obj;
+	if (o->file->size - f->pos < size)
+		size = o->file->size - f->pos;
+	if (size <= 0)	return 0;
+
+	pos = f->pos;
+	b = RAMSeek(o, pos);
+	for(done = 0; b && done < size; done += len, pos += len, b = b->next) {
+		o->blk = b;
+		o->blkpos = pos & ~(long int)(GFILE_RAMFS_BLOCK_SIZE-1);
+		len = GFILE_RAMFS_BLOCK_SIZE - (pos & (GFILE_RAMFS_BLOCK_SIZE-1));
+		if (len > size - done)
+			len = size - done;
+		memcpy((char *)buf + done, b->data + (pos & (GFILE_RAMFS_BLOCK_SIZE-1)), len);
+	}
+	return done;
+}
+
+static int RAMWrite(GFILE *f, const void *buf, int size)
+{
+	RAMOpenFile	*o;
+	RAMFile		*p;
+	RAMBlock	*b;
+	long int	pos;
+	int			done, len;
+
+	o = (RAMOpenFile *)f->obj;
+	p = o->file;
+	// Another handle may have truncated the file under us
+	if ((f->flags & GFILEFLG_APPEND) || f->pos > p->size)
+		f->pos = p->size;
+	if (size <= 0)	return 0;
+
+	pos = f->pos;
+	for(done = 0; done < size; done += len, pos += len) {
+		// Add a block to the end of the file if required
+		if (!(b = RAMSeek(o, pos))) {
+			#if GFILE_RAMFS_SIZE
+				if (RAMUsed + GFILE_RAMFS_BLOCK_SIZE > GFILE_RAMFS_SIZE)
+					break;
+			#endif
+			if (!(b = gfxAlloc(sizeof(RAMBlock))))
+				break;
+			#if GFILE_RAMFS_SIZE
+				RAMUsed += GFILE_RAMFS_BLOCK_SIZE;
+			#endif
+			b->next = 0;
+			if (p->last)
+				p->last->next = b;
+			else
+				p->first = b;
+			p->last = b;
+			o->blk = b;
+			o->blkpos = pos;
+			o->gen = p->gen;
+		}
+		len = GFILE_RAMFS_BLOCK_SIZE - (pos & (GFILE_RAMFS_BLOCK_SIZE-1));
+		if (len > size - done)
+			len = size - done;
+		memcpy(b->data + (pos & (GFILE_RAMFS_BLOCK_SIZE-1)), (const char *)buf + done, len);
+		if (pos + len > p->size)
+			p->size = pos + len;
+	}
+	return done;
+}
+
+static bool_t RAMSetpos(GFILE *f, long int pos)
+{
+	return pos >= 0 && pos <= ((RAMOpenFile *)f->obj)->file->size;
+}
+
+static long int RAMGetsize(GFILE *f)
+{
+	return ((RAMOpenFile *)f->obj)->file->size;
+}
+
+static bool_t RAMEof(GFILE *f)
+{
+	return f->pos >= ((RAMOpenFile *)f->obj)->file->size;
+}
+
+static const void *RAMDirect(GFILE *f, long int *len)
+{
+	RAMOpenFile	*o;
+	RAMBlock	*b;
+	long int	cnt;
+
+	o = (RAMOpenFile *)f->obj;
+	if (!(b = RAMSeek(o, f->pos)))
+		return 0;
+
+	// We can only return up to the end of the block
+	cnt = GFILE_RAMFS_BLOCK_SIZE - (f->pos & (GFILE_RAMFS_BLOCK_SIZE-1));
+	if (cnt > o->file->size - f->pos)
+		cnt = o->file->size - f->pos;
+	if (cnt < *len)
+		*len = cnt;
+	return b->data + (f->pos & (GFILE_RAMFS_BLOCK_SIZE-1));
+}
+
+#if GFILE_NEED_FILELISTS
+	static gfileList *RAMFlOpen(const char *path, bool_t dirs) {
+		RAMFileList *	p;
+		(void)			path;
+
+		// We don't support directories or path searching
+		if (dirs)
+			return 0;
+
+		// Allocate the list buffer
+		if (!(p = gfxAlloc(sizeof(RAMFileList))))
+			return 0;
+
+		// Initialize it and return it.
+		p->index = 0;
+		return &p->fl;
+	}
+
+	static const char *RAMFlRead(gfileList *pfl) {
+		RAMFile		*p;
+		unsigned	i;
+
+		// We count rather than remember the entry as files may be deleted while we are listing
+		for(p = RAMHead, i = ((RAMFileList *)pfl)->index; p && i; p = p->next, i--);
+		if (!p)
+			return 0;
+		((RAMFileList *)pfl)->index++;
+		return p->name;
+	}
+
+	static void RAMFlClose(gfileList *pfl) {
+		gfxFree(pfl);
+	}
+#endif
+
 #endif //GFX_USE_GFILE && GFILE_NEED_RAMFS
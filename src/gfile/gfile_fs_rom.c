@@ -22,6 +22,13 @@
 
 // Compression Formats
 #define ROMFS_CMP_UNCOMPRESSED		0
+#define ROMFS_CMP_LZ4				1		// Independent LZ4 blocks - see below
+
+#if GFILE_NEED_ROMFS_COMPRESSED
+	#define ROMFS_CMP_MAX			ROMFS_CMP_LZ4
+#else
+	#define ROMFS_CMP_MAX			ROMFS_CMP_UNCOMPRESSED
+#endif
 
 typedef struct ROMFS_DIRENTRY {
 	uint16_t						ver;			// Directory Entry Version
@@ -36,11 +43,46 @@ typedef struct ROMFS_DIRENTRY {
 #include "romfs_files.h"
 static const ROMFS_DIRENTRY const *FsROMHead = ROMFS_DIRENTRY_HEAD;
 
+/**
+ * An optional index generated by "file2c -i" lists the directory entries sorted by name.
+ * It is only trusted for a missing file if it covers every entry in the linked list,
+ * otherwise we fall back to searching the list for any hand-written entries.
+ */
+#ifdef ROMFS_DIRENTRY_INDEX
+	#define ROMFS_INDEX_SIZE		(sizeof(ROMFS_DIRENTRY_INDEX)/sizeof(ROMFS_DIRENTRY_INDEX[0]))
+	#define ROMFS_INDEX_UNKNOWN		0
+	#define ROMFS_INDEX_COMPLETE	1
+	#define ROMFS_INDEX_PARTIAL		2
+	static uint8_t FsROMIndexState = ROMFS_INDEX_UNKNOWN;
+#endif
+
 typedef struct ROMFileList {
 	gfileList				fl;
 	const ROMFS_DIRENTRY	*pdir;
 } ROMFileList;
 
+#if GFILE_NEED_ROMFS_COMPRESSED
+	/**
+	 * A ROMFS_CMP_LZ4 file is split into blocks of (1 << blockbits) bytes that are each compressed
+	 * as an independent LZ4 block. This gives us a restart point at the start of every block.
+	 * The data pointed to by the directory entry is:
+	 *		uint8_t		blockbits				- From 8 to 15
+	 *		uint32_t	offsets[nblocks+1]		- Little endian offset of each block from the start of the data
+	 *		uint8_t		blocks[]				- The LZ4 compressed blocks
+	 * The directory entry size is the uncompressed size of the file.
+	 */
+	#define ROMFS_LZ4_MINBITS		8
+	#define ROMFS_LZ4_MAXBITS		15
+
+	// An open compressed file
+	typedef struct ROMCmpFile {
+		ROMFS_DIRENTRY			dir;			// A copy of the directory entry. This must be the first element.
+		long int				blockpos;		// The file position of the block in buf (-1 if none)
+		unsigned				blocklen;		// The number of bytes in buf
+		uint8_t					buf[1];			// The decompressed block (1 << blockbits bytes)
+	} ROMCmpFile;
+#endif
+
 
 static bool_t ROMExists(const char *fname);
 static long int	ROMFilesize(const char *fname);
@@ -50,6 +92,7 @@ static int ROMRead(GFILE *f, void *buf, int size);
 static bool_t ROMSetpos(GFILE *f, long int pos);
 static long int ROMGetsize(GFILE *f);
 static bool_t ROMEof(GFILE *f);
+static const void *ROMDirect(GFILE *f, long int *len);
 #if GFILE_NEED_FILELISTS
 	static gfileList *ROMFlOpen(const char *path, bool_t dirs);
 	static const char *ROMFlRead(gfileList *pfl);
@@ -64,16 +107,48 @@ const GFILEVMT FsROMVMT = {
 	ROMSetpos, ROMGetsize, ROMEof,
 	0, 0, 0,
 	#if GFILE_NEED_FILELISTS
-		ROMFlOpen, ROMFlRead, ROMFlClose
+		ROMFlOpen, ROMFlRead, ROMFlClose,
 	#endif
+	ROMDirect,
 };
 
 static const ROMFS_DIRENTRY *ROMFindFile(const char *fname)
 {
 	const ROMFS_DIRENTRY *p;
 
+	#ifdef ROMFS_DIRENTRY_INDEX
+	{
+		unsigned	lo, hi, mid;
+		int			cmp;
+
+		// Binary search the sorted index
+		for(lo = 0, hi = ROMFS_INDEX_SIZE; lo < hi; ) {
+			mid = (lo + hi) / 2;
+			p = ROMFS_DIRENTRY_INDEX[mid];
+			if (!(cmp = strcmp(fname, p->name))) {
+				if (p->ver <= ROMFS_DIR_VER_MAX && p->cmp <= ROMFS_CMP_MAX)
+					return p;
+				break;
+			}
+			if (cmp < 0)
+				hi = mid;
+			else
+				lo = mid + 1;
+		}
+
+		// Check once whether the index covers the whole list
+		if (FsROMIndexState == ROMFS_INDEX_UNKNOWN) {
+			for(mid = 0, p = FsROMHead; p; p = p->next)
+				mid++;
+			FsROMIndexState = mid == ROMFS_INDEX_SIZE ? ROMFS_INDEX_COMPLETE : ROMFS_INDEX_PARTIAL;
+		}
+		if (FsROMIndexState == ROMFS_INDEX_COMPLETE)
+			return 0;
+	}
+	#endif
+
 	for(p = FsROMHead; p; p = p->next) {
-		if (p->ver <= ROMFS_DIR_VER_MAX && p->cmp == ROMFS_CMP_UNCOMPRESSED && !strcmp(p->name, fname))
+		if (p->ver <= ROMFS_DIR_VER_MAX && p->cmp <= ROMFS_CMP_MAX && !strcmp(p->name, fname))
 			break;
 	}
 	return p;
@@ -92,18 +167,122 @@ static long int	ROMFilesize(const char *fname)
 	return p->size;
 }
 
+#if GFILE_NEED_ROMFS_COMPRESSED
+	static uint32_t ROMGetLE32(const uint8_t *p)
+	{
+		return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+	}
+
+	// Decompress one LZ4 block. Returns the number of bytes produced or -1 on error.
+	static int ROMUnLZ4(const uint8_t *src, const uint8_t *end, uint8_t *dst, unsigned dstlen)
+	{
+		uint8_t			*d;
+		const uint8_t	*m;
+		unsigned		tok, len, b;
+
+		for(d = dst; src < end; ) {
+			tok = *src++;
+
+			// The literals
+			len = tok >> 4;
+			if (len == 15) {
+				do {
+					if (src >= end) return -1;
+					len += (b = *src++);
+				} while (b == 255);
+			}
+			if (len > (unsigned)(end - src) || len > dstlen - (unsigned)(d - dst)) return -1;
+			memcpy(d, src, len);
+			d += len;
+			src += len;
+
+			// The last sequence has no match
+			if (src >= end)
+				break;
+
+			// The match
+			if (end - src < 2) return -1;
+			b = src[0] | (src[1] << 8);
+			src += 2;
+			if (!b || b > (unsigned)(d - dst)) return -1;
+			m = d - b;
+			len = tok & 15;
+			if (len == 15) {
+				do {
+					if (src >= end) return -1;
+					len += (b = *src++);
+				} while (b == 255);
+			}
+			len += 4;
+			if (len > dstlen - (unsigned)(d - dst)) return -1;
+
+			// The match may overlap what we are writing so copy a byte at a time
+			while(len--)
+				*d++ = *m++;
+		}
+		return d - dst;
+	}
+
+	// Make sure the block containing file position pos is decompressed into the buffer
+	static bool_t ROMLoadBlock(ROMCmpFile *c, long int pos)
+	{
+		const uint8_t	*hdr;
+		unsigned		bits, blk;
+		int				len;
+
+		hdr = (const uint8_t *)c->dir.file;
+		bits = hdr[0];
+		if ((pos & ~((1L << bits)-1)) == c->blockpos)
+			return TRUE;
+		blk = pos >> bits;
+		len = ROMUnLZ4((const uint8_t *)c->dir.file + ROMGetLE32(hdr+1+4*blk), (const uint8_t *)c->dir.file + ROMGetLE32(hdr+1+4*(blk+1)), c->buf, 1 << bits);
+		if (len <= 0) {
+			c->blockpos = -1;
+			return FALSE;
+		}
+		c->blockpos = (long int)blk << bits;
+		c->blocklen = len;
+		return TRUE;
+	}
+#endif
+
 static bool_t ROMOpen(GFILE *f, const char *fname)
 {
 	const ROMFS_DIRENTRY *p;
 
 	if (!(p = ROMFindFile(fname))) return FALSE;
+
+	#if GFILE_NEED_ROMFS_COMPRESSED
+		// Compressed files need somewhere to decompress a block
+		if (p->cmp == ROMFS_CMP_LZ4) {
+			ROMCmpFile	*c;
+			unsigned	bits;
+
+			bits = ((const uint8_t *)p->file)[0];
+			if (bits < ROMFS_LZ4_MINBITS || bits > ROMFS_LZ4_MAXBITS)
+				return FALSE;
+			if (!(c = gfxAlloc(sizeof(ROMCmpFile) - sizeof(c->buf) + (1 << bits))))
+				return FALSE;
+			c->dir = *p;
+			c->blockpos = -1;
+			c->blocklen = 0;
+			f->obj = (void *)c;
+			return TRUE;
+		}
+	#endif
+
 	f->obj = (void *)p;
 	return TRUE;
 }
 
 static void ROMClose(GFILE *f)
 {
-	(void)f;
+	#if GFILE_NEED_ROMFS_COMPRESSED
+		if (((const ROMFS_DIRENTRY *)f->obj)->cmp != ROMFS_CMP_UNCOMPRESSED)
+			gfxFree(f->obj);
+	#else
+		(void)f;
+	#endif
 }
 
 static int ROMRead(GFILE *f, void *buf, int size)
@@ -114,6 +293,28 @@ static int ROMRead(GFILE *f, void *buf, int size)
 	if (p->size - f->pos < size)
 		size = p->size - f->pos;
 	if (size <= 0)	return 0;
+
+	#if GFILE_NEED_ROMFS_COMPRESSED
+		if (p->cmp == ROMFS_CMP_LZ4) {
+			ROMCmpFile	*c;
+			long int	pos;
+			int			len, done;
+
+			c = (ROMCmpFile *)f->obj;
+			for(pos = f->pos, done = 0; done < size; pos += len, done += len) {
+				if (!ROMLoadBlock(c, pos))
+					break;
+				len = c->blocklen - (pos - c->blockpos);
+				if (len > size - done)
+					len = size - done;
+				if (len <= 0)
+					break;
+				memcpy((char *)buf + done, c->buf + (pos - c->blockpos), len);
+			}
+			return done;
+		}
+	#endif
+
 	memcpy(buf, p->file+f->pos, size);
 	return size;
 }
@@ -133,6 +334,18 @@ static bool_t ROMEof(GFILE *f)
 	return f->pos >= ((const ROMFS_DIRENTRY *)f->obj)->size;
 }
 
+static const void *ROMDirect(GFILE *f, long int *len)
+{
+	const ROMFS_DIRENTRY *p;
+
+	p = (const ROMFS_DIRENTRY *)f->obj;
+	if (p->cmp != ROMFS_CMP_UNCOMPRESSED)
+		return 0;
+	if (p->size - f->pos < *len)
+		*len = p->size - f->pos;
+	return p->file+f->pos;
+}
+
 #if GFILE_NEED_FILELISTS
 	static gfileList *ROMFlOpen(const char *path, bool_t dirs) {
 		ROMFileList *	p;
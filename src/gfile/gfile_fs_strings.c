@@ -53,6 +53,7 @@ static const GFILEVMT StringVMT = {
 	#if GFILE_NEED_FILELISTS
 		0, 0, 0,
 	#endif
+	0,
 };
 
 static void gfileOpenStringFromStaticGFILE(GFILE *f, char *str) {
@@ -62,6 +63,7 @@ static void gfileOpenStringFromStaticGFILE(GFILE *f, char *str) {
 	f->obj = str;
 	f->pos = 0;
 	f->flags |= GFILEFLG_OPEN|GFILEFLG_CANSEEK;
+	_gfileInitReadAhead(f);
 }
 
 GFILE *gfileOpenString(char *str, const char *mode) {
@@ -99,18 +99,33 @@
 	 * @note	This requires a file called romfs_files.h to be in the
 	 * 			users project include path. This file should include all the files
 	 * 			converted to .h files using the file2c utility (using flags "-dbcs").
+	 * @note	For faster file lookups with many files, generate an index from those .h files
+	 * 			using "file2c -i" and include it last in romfs_files.h.
 	 */
 	#ifndef GFILE_NEED_ROMFS
 		#define GFILE_NEED_ROMFS		FALSE
 	#endif
+	/**
+	 * @brief   Include support for compressed files in the ROM file system
+	 * @details	Defaults to FALSE
+	 * @note	Compressed files are created using the file2c utility with the "-z" flag.
+	 * 			Without this option they are ignored by the ROM file system.
+	 * @note	Each open compressed file allocates a buffer the size of its compression
+	 * 			block (1K by default).
+	 * @note	@p gfileReadDirect() is not supported for compressed files.
+	 */
+	#ifndef GFILE_NEED_ROMFS_COMPRESSED
+		#define GFILE_NEED_ROMFS_COMPRESSED	FALSE
+	#endif
 	/**
 	 * @brief   Include the RAM file system
 	 * @details	Defaults to FALSE
 	 * @note	If GFILE_ALLOW_DEVICESPECIFIC is on then you can ensure that you are
 	 * 			opening a file on the RAM file system by prefixing
 	 * 			its name with "R|" (the letter 'R', followed by a vertical bar).
-	 * @note	You must also define GFILE_RAMFS_SIZE with the size of the file system
-	 * 			to be allocated in RAM.
+	 * @note	Files are allocated in blocks of GFILE_RAMFS_BLOCK_SIZE bytes using gfxAlloc().
+	 * 			Define GFILE_RAMFS_SIZE to limit the total size of the file system.
+	 * @note	There are no directories. The contents are lost when the program exits.
 	 */
 	#ifndef GFILE_NEED_RAMFS
 		#define GFILE_NEED_RAMFS		FALSE
@@ -187,6 +202,18 @@
 	#ifndef GFILE_NEED_FILELISTS
 		#define GFILE_NEED_FILELISTS	FALSE
 	#endif
+	/**
+	 * @brief   Buffer reads from slow file systems
+	 * @details	Defaults to FALSE
+	 * @note	Files opened read-only on a file system that is not memory based get a read-ahead
+	 * 			buffer of GFILE_READAHEAD_SIZE bytes. Small reads and short seeks within the
+	 * 			buffered data then don't need to go to the file system.
+	 * @note	The buffer is allocated using gfxAlloc() when the file is opened. If there is
+	 * 			not enough memory the file is just read unbuffered.
+	 */
+	#ifndef GFILE_NEED_READAHEAD
+		#define GFILE_NEED_READAHEAD	FALSE
+	#endif
 /**
  * @}
  *
@@ -216,6 +243,31 @@
 	#ifndef GFILE_MAX_GFILES
 		#define GFILE_MAX_GFILES		3
 	#endif
+	/**
+	 * @brief   The size of the read-ahead buffer for each open file (in bytes)
+	 * @details	Defaults to 512
+	 * @note	Only used if GFILE_NEED_READAHEAD is TRUE. It must be less than 65536.
+	 * @note	Matching the sector size of the underlying media works best.
+	 */
+	#ifndef GFILE_READAHEAD_SIZE
+		#define GFILE_READAHEAD_SIZE	512
+	#endif
+	/**
+	 * @brief   The size of the blocks files are made from in the RAM file system
+	 * @details	Defaults to 512
+	 * @note	Only used if GFILE_NEED_RAMFS is TRUE. It must be a power of 2.
+	 */
+	#ifndef GFILE_RAMFS_BLOCK_SIZE
+		#define GFILE_RAMFS_BLOCK_SIZE	512
+	#endif
+	/**
+	 * @brief   The maximum number of bytes of file data in the RAM file system
+	 * @details	Defaults to 0 which means it is only limited by the available memory
+	 * @note	Only used if GFILE_NEED_RAMFS is TRUE.
+	 */
+	#ifndef GFILE_RAMFS_SIZE
+		#define GFILE_RAMFS_SIZE		0
+	#endif
 	/**
 	 * @brief   TUse an external FATFS library instead of the uGFX inbuilt one
 	 * @note	This is applicable when GFILE_NEED_FATFS is specified. It allows
@@ -230,6 +282,17 @@
 	#ifndef GFILE_FATFS_EXTERNAL_LIB
 		#define GFILE_FATFS_EXTERNAL_LIB		FALSE
 	#endif
+	/**
+	 * @brief   The number of disk sectors the FATFS driver caches
+	 * @details	Defaults to 0 (no cache)
+	 * @note	This is applicable when GFILE_NEED_FATFS is specified and GFILE_FATFS_EXTERNAL_LIB is not.
+	 * @note	The cache is shared by all files and is write-through. The least recently used
+	 * 			sector is replaced. It mostly saves re-reading FAT and directory sectors.
+	 * @note	Each sector uses _MAX_SS bytes (usually 512) of RAM.
+	 */
+	#ifndef GFILE_FATFS_CACHE_SECTORS
+		#define GFILE_FATFS_CACHE_SECTORS		0
+	#endif
 	/**
 	 * @brief   TUse an external PETITFS library instead of the uGFX inbuilt one
 	 * @note	This is applicable when GFILE_NEED_PETITFS is specified. It allows
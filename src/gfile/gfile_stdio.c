@@ -28,7 +28,7 @@ int gstdioSeek(GFILE *f, size_t offset, int origin) {
 	case SEEK_SET:
 		break;
 	case SEEK_CUR:
-		offset += f->pos;
+		offset += gfileGetPos(f);
 		break;
 	case SEEK_END:
 		offset += gfileGetSize(f);
@@ -42,7 +42,7 @@ int gstdioSeek(GFILE *f, size_t offset, int origin) {
 int gstdioGetpos(GFILE *f, long int *pos) {
 	if (!(f->flags & GFILEFLG_OPEN))
 		return -1;
-	*pos = f->pos;
+	*pos = gfileGetPos(f);
 	return 0;
 }
 
@@ -80,6 +80,7 @@ GSourceHandle ginputGetDial(uint16_t instance) {
 			pds->lastvalue = 0;
 		}
 		ginput_lld_dial_init();
+		gtimerSetThread(&DialTimer, GTIMER_INPUT_THREAD);
 		gtimerStart(&DialTimer, (GTimerFunction)ginput_lld_dial_poll, DialCallback, TRUE, GINPUT_DIAL_POLL_PERIOD);
 	}
 
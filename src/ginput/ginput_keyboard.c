@@ -69,7 +69,8 @@ static void SendKeyboardEventToListener(GSourceListener	*psl, GKeyboard *k) {
 	for(; i < 8; i++)				pe->c[i] = 0;
 	pe->keystate = k->keystate | psl->srcflags;
 	psl->srcflags = 0;
-	geventSendEvent(psl);
+	if (!geventSendEvent(psl))
+		psl->srcflags |= GKEYSTATE_MISSED_EVENT;
 }
 
 static void SendKeyboardEvent(GKeyboard *k) {
@@ -505,8 +506,10 @@ bool_t _gkeyboardInitDriver(GDriver *g, void *param, unsigned driverinstance, un
         return FALSE;
 
 	// Ensure the Poll timer is started
-	if (!gtimerIsActive(&KeyboardTimer))
+	if (!gtimerIsActive(&KeyboardTimer)) {
+		gtimerSetThread(&KeyboardTimer, GTIMER_INPUT_THREAD);
 		gtimerStart(&KeyboardTimer, KeyboardPoll, 0, TRUE, GINPUT_KEYBOARD_POLL_PERIOD);
+	}
 
     return TRUE;
 
@@ -98,7 +98,10 @@ static void SendMouseEvent(GSourceListener	*psl, GMouse *m, GMouseReading *r) {
 	pe->buttons = r->buttons | psl->srcflags;
 	psl->srcflags = 0;
 	pe->display = m->display;
-	geventSendEvent(psl);
+	if (!geventSendEvent(psl)) {
+		// The listener's queue was full - save the meta events that have happened
+		psl->srcflags |= ((r->buttons & GMETA_MASK)|GINPUT_MISSED_MOUSE_EVENT);
+	}
 }
 
 static void GetMouseReading(GMouse *m) {
@@ -678,8 +681,10 @@ bool_t _gmouseInitDriver(GDriver *g, void *display, unsigned driverinstance, uns
         return FALSE;
 
 	// Ensure the Poll timer is started
-	if (!gtimerIsActive(&MouseTimer))
+	if (!gtimerIsActive(&MouseTimer)) {
+		gtimerSetThread(&MouseTimer, GTIMER_INPUT_THREAD);
 		gtimerStart(&MouseTimer, MousePoll, 0, TRUE, GINPUT_MOUSE_POLL_PERIOD);
+	}
 
     return TRUE;
 
@@ -771,6 +776,27 @@ bool_t ginputGetMouseStatus(unsigned instance, GEventMouse *pe) {
 	return TRUE;
 }
 
+#if GEVENT_LISTENER_QUEUE_SIZE
+	bool_t ginputMouseCoalesce(GEvent *pqueued, const GEvent *pe) {
+		#define pq		((GEventMouse *)pqueued)
+		#define pm		((const GEventMouse *)pe)
+
+		// Only plain movements with the same buttons down can be merged. Button transitions must all be seen.
+		if ((pm->type != GEVENT_MOUSE && pm->type != GEVENT_TOUCH)
+				|| pq->buttons != pm->buttons
+				|| (pm->buttons & (GMETA_MASK|GINPUT_MISSED_MOUSE_EVENT))
+				|| pq->display != pm->display)
+			return FALSE;
+
+		// Keep the latest position
+		*pq = *pm;
+		return TRUE;
+
+		#undef pq
+		#undef pm
+	}
+#endif
+
 #if !GINPUT_TOUCH_NOTOUCH
 	void ginputSetFingerMode(unsigned instance, bool_t on) {
 		GMouse *m;
@@ -141,6 +141,22 @@ extern "C" {
 	 */
 	bool_t ginputGetMouseStatus(unsigned instance, GEventMouse *pmouse);
 
+	#if GEVENT_LISTENER_QUEUE_SIZE || defined(__DOXYGEN__)
+		/**
+		 * @brief	A coalesce function that merges consecutive mouse movements
+		 * @details	Register this with @p geventRegisterCoalesce() so that a listener which falls behind
+		 * 			only receives the latest position of a mouse movement. Events with button
+		 * 			transitions (eg GMETA_MOUSE_DOWN) or a change in the buttons are never merged.
+		 * @note	Only available when GEVENT_LISTENER_QUEUE_SIZE is non-zero
+		 *
+		 * @param[in] pqueued	The last queued event
+		 * @param[in] pe		The new event
+		 *
+		 * @return	TRUE if the new event has been merged into the queued event
+		 */
+		bool_t ginputMouseCoalesce(GEvent *pqueued, const GEvent *pe);
+	#endif
+
 	/**
 	 * @brief	Performs a calibration
 	 *
@@ -102,6 +102,7 @@ GSourceHandle ginputGetToggle(uint16_t instance) {
 	if (!gtimerIsActive(&ToggleTimer)) {
 		for(ptc = GInputToggleConfigTable; ptc < GInputToggleConfigTable+sizeof(GInputToggleConfigTable)/sizeof(GInputToggleConfigTable[0]); ptc++)
 			ginput_lld_toggle_init(ptc);
+		gtimerSetThread(&ToggleTimer, GTIMER_INPUT_THREAD);
 		gtimerStart(&ToggleTimer, TogglePoll, 0, TRUE, GINPUT_TOGGLE_POLL_PERIOD);
 	}
 		
@@ -24,6 +24,15 @@
 #else
 	#define linuxyield()	pthread_yield()
 #endif
+#if GFX_LINUX_USE_THREAD_PRIORITY || GFX_LINUX_CPU_AFFINITY
+	#include <sys/syscall.h>
+#endif
+#if GFX_LINUX_USE_THREAD_PRIORITY
+	#include <sys/resource.h>
+#endif
+#if GFX_LINUX_USE_THREAD_STACKSIZE
+	#include <limits.h>
+#endif
 
 static gfxMutex		SystemMutex;
 
@@ -109,20 +118,98 @@ systemticks_t gfxSystemTicks(void) {
 	return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
 }
 
+#if GFX_LINUX_USE_THREAD_PRIORITY || GFX_LINUX_CPU_AFFINITY
+	typedef struct linuxThreadStart {
+		DECLARE_THREAD_FUNCTION((*fn),p);
+		void *				param;
+		threadpriority_t	prio;
+	} linuxThreadStart;
+
+	// Set up the scheduling of the new thread before running the real thread function.
+	//	This is done in the new thread as the nice level is set using its (Linux) thread id.
+	static DECLARE_THREAD_FUNCTION(linuxThreadStarter, param) {
+		linuxThreadStart	s;
+
+		s = *(linuxThreadStart *)param;
+		free(param);
+
+		#if GFX_LINUX_CPU_AFFINITY
+		{
+			// The raw system call takes a plain bit mask and doesn't need the GNU cpu_set_t extensions
+			unsigned long	cpus;
+
+			cpus = (unsigned long)(GFX_LINUX_CPU_AFFINITY);
+			syscall(SYS_sched_setaffinity, 0, sizeof(cpus), &cpus);
+		}
+		#endif
+
+		#if GFX_LINUX_USE_THREAD_PRIORITY
+			if (s.prio < NORMAL_PRIORITY) {
+				struct sched_param	sp;
+				int					lo, hi;
+
+				// Higher than normal priority - use the real time scheduler
+				lo = sched_get_priority_min(SCHED_FIFO);
+				hi = sched_get_priority_max(SCHED_FIFO);
+				sp.sched_priority = -s.prio;
+				if (sp.sched_priority < lo)	sp.sched_priority = lo;
+				if (sp.sched_priority > hi)	sp.sched_priority = hi;
+				if (!pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp))
+					return s.fn(s.param);
+			}
+
+			// Normal scheduler (or we are not allowed real time). The nice level is per thread on Linux.
+			if (s.prio != NORMAL_PRIORITY)
+				setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), s.prio > 19 ? 19 : (s.prio < -20 ? -20 : s.prio));
+		#endif
+
+		return s.fn(s.param);
+	}
+#endif
+
 gfxThreadHandle gfxThreadCreate(void *stackarea, size_t stacksz, threadpriority_t prio, DECLARE_THREAD_FUNCTION((*fn),p), void *param) {
 	gfxThreadHandle		th;
+	pthread_attr_t		attr;
+	int					res;
 	(void)				stackarea;
-	(void)				stacksz;
-	(void)				prio;
 
 	// Implementing priority with pthreads is a rats nest that is also pthreads implementation dependent.
 	// Only some pthreads schedulers support it, some implementations use the operating system process priority mechanisms.
 	// Even those that do support it can have different ranges of priority and "normal" priority is an undefined concept.
 	// Across different UNIX style operating systems things can be very different (let alone OS's such as Windows).
 	// Even just Linux changes the way priority works with different kernel schedulers and across kernel versions.
-	// For these reasons we ignore the priority.
+	// For these reasons we ignore the priority unless GFX_LINUX_USE_THREAD_PRIORITY is set.
+
+	pthread_attr_init(&attr);
+
+	#if GFX_LINUX_USE_THREAD_STACKSIZE
+		if (stacksz)
+			pthread_attr_setstacksize(&attr, stacksz < PTHREAD_STACK_MIN ? PTHREAD_STACK_MIN : stacksz);
+	#else
+		(void)			stacksz;
+	#endif
+
+	#if GFX_LINUX_USE_THREAD_PRIORITY || GFX_LINUX_CPU_AFFINITY
+	{
+		linuxThreadStart	*s;
+
+		if (!(s = malloc(sizeof(linuxThreadStart)))) {
+			pthread_attr_destroy(&attr);
+			return 0;
+		}
+		s->fn = fn;
+		s->param = param;
+		s->prio = prio;
+		if ((res = pthread_create(&th, &attr, linuxThreadStarter, s)))
+			free(s);
+	}
+	#else
+		(void)			prio;
+		res = pthread_create(&th, &attr, fn, param);
+	#endif
 
-	if (pthread_create(&th, 0, fn, param))
+	pthread_attr_destroy(&attr);
+	if (res)
 		return 0;
 
 	return th;
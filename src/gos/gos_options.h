@@ -212,6 +212,38 @@
  	#ifndef GFX_FREERTOS_USE_TRACE
  		#define GFX_FREERTOS_USE_TRACE	FALSE
  	#endif
+ 	/**
+ 	 * @brief	Should Linux threads be given a scheduling priority
+ 	 * @details	Defaults to FALSE
+ 	 * @note	Only used by the Linux port. By default all threads run at the same priority.
+ 	 * @note	Threads with a priority higher than NORMAL_PRIORITY (eg HIGH_PRIORITY) are run with the
+ 	 * 			SCHED_FIFO real time scheduler. Other threads use the normal scheduler with the priority
+ 	 * 			as the nice level (eg LOW_PRIORITY is nice 10).
+ 	 * @note	Real time scheduling and negative nice levels need the CAP_SYS_NICE capability (or suitable
+ 	 * 			RLIMIT_RTPRIO and RLIMIT_NICE limits). Without them the thread falls back to
+ 	 * 			the nice level and then to the default priority.
+ 	 */
+ 	#ifndef GFX_LINUX_USE_THREAD_PRIORITY
+ 		#define GFX_LINUX_USE_THREAD_PRIORITY	FALSE
+ 	#endif
+ 	/**
+ 	 * @brief	Should Linux threads use the stack size passed to gfxThreadCreate()
+ 	 * @details	Defaults to FALSE
+ 	 * @note	Only used by the Linux port. By default threads get the pthreads default stack size (usually 8MB of virtual memory).
+ 	 * @note	Stack sizes smaller than PTHREAD_STACK_MIN are rounded up. A stack size of 0 uses the default.
+ 	 */
+ 	#ifndef GFX_LINUX_USE_THREAD_STACKSIZE
+ 		#define GFX_LINUX_USE_THREAD_STACKSIZE	FALSE
+ 	#endif
+ 	/**
+ 	 * @brief	Which CPU's should threads created by gfxThreadCreate() run on
+ 	 * @details	Defaults to 0 (no restriction)
+ 	 * @note	Only used by the Linux port. This is a bit mask of CPU numbers eg 0x02 runs the
+ 	 * 			uGFX threads (such as the GTIMER thread) only on the second CPU.
+ 	 */
+ 	#ifndef GFX_LINUX_CPU_AFFINITY
+ 		#define GFX_LINUX_CPU_AFFINITY		0
+ 	#endif
  	/**
  	 * @brief	How much RAM should uGFX use for the heap when using its own internal heap allocator
  	 * @details	Defaults to 0.
@@ -28,6 +28,10 @@
  	#error "GOS: GFX_FREERTOS_USE_TRACE is only available for the FreeRTOS port."
 #endif
 
+#if (GFX_LINUX_USE_THREAD_PRIORITY || GFX_LINUX_USE_THREAD_STACKSIZE || GFX_LINUX_CPU_AFFINITY) && !GFX_USE_OS_LINUX
+ 	#error "GOS: GFX_LINUX_USE_THREAD_PRIORITY, GFX_LINUX_USE_THREAD_STACKSIZE and GFX_LINUX_CPU_AFFINITY are only available for the Linux port."
+#endif
+
 #if GFX_EMULATE_MALLOC
 	#if GFX_USE_OS_WIN32 || GFX_USE_OS_LINUX || GFX_USE_OS_OSX || GFX_USE_OS_ECOS || \
 			(GFX_OS_HEAP_SIZE == 0 && (GFX_USE_OS_RAW32 || GFX_USE_OS_ARDUINO || GFX_USE_OS_CMSIS || GFX_USE_OS_KEIL))
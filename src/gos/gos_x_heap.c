@@ -32,70 +32,257 @@
 
 #else
 
+	/*
+	 * A segregated fit allocator.
+	 *
+	 * Free slots are kept in lists by size class. Each power of two is split into SL_COUNT
+	 * classes and a bitmap records which lists are non-empty so finding a free slot that is
+	 * big enough is a constant time operation. Free slots also store their size in their
+	 * last word (a boundary tag) so that freeing can merge with both neighbouring slots
+	 * without searching.
+	 */
+
 	// Slot structure - user memory follows
 	typedef struct memslot {
-		size_t			sz;			// Includes the size of this memslot.
+		size_t			sz;			// Includes the size of this memslot. The bottom bits are the SLOT_xxx flags.
 		} memslot;
 
-	// Free Slot - immediately follows the memslot structure
+	// Free Slot - immediately follows the memslot structure. The size of the slot is also stored in its last word.
 	typedef struct freeslot {
-		memslot *nextfree;			// The next free slot
+		memslot *nextfree;			// The next free slot in this size class
+		memslot *prevfree;			// The previous free slot in this size class
 	} freeslot;
 
-	#define GetSlotSize(sz)		((((sz) + (sizeof(freeslot) - 1)) & ~(sizeof(freeslot) - 1)) + sizeof(memslot))
+	#define SLOT_USED			0x01		// This slot is allocated
+	#define SLOT_PREVFREE		0x02		// The slot immediately before this one is free
+	#define SLOT_FLAGS			(SLOT_USED|SLOT_PREVFREE)
+	#define SLOT_ALIGN			sizeof(freeslot)
+	#define SLOT_MIN			((sizeof(memslot) + sizeof(freeslot) + sizeof(size_t) + SLOT_ALIGN - 1) & ~(SLOT_ALIGN - 1))
+
+	#define SL_BITS				2						// Each power of two is split into 2^SL_BITS size classes
+	#define SL_COUNT			(1 << SL_BITS)
+	#define FL_SHIFT			4						// The smallest slot is at least 2^FL_SHIFT bytes
+	#define FL_COUNT			24						// Slots of 2^(FL_SHIFT+FL_COUNT) bytes or more share the last size class
+
+	#define GetSlotSize(sz)		((sz) + sizeof(memslot) <= SLOT_MIN ? SLOT_MIN : (((sz) + sizeof(memslot) + (SLOT_ALIGN - 1)) & ~(SLOT_ALIGN - 1)))
+	#define SlotSize(pslot)		((pslot)->sz & ~(size_t)SLOT_FLAGS)
+	#define NextSlot(pslot)		((memslot *)((char *)(pslot) + SlotSize(pslot)))
+	#define PrevSlot(pslot)		((memslot *)((char *)(pslot) - ((size_t *)(pslot))[-1]))
 	#define NextFree(pslot)		((freeslot *)Slot2Ptr(pslot))->nextfree
+	#define PrevFree(pslot)		((freeslot *)Slot2Ptr(pslot))->prevfree
 	#define Ptr2Slot(p)			((memslot *)(p) - 1)
 	#define Slot2Ptr(pslot)		((pslot)+1)
 
-	static memslot *			freeSlots;
+	static memslot *			freeSlots[FL_COUNT][SL_COUNT];
+	static uint32_t				flBitmap;				// Which first level classes have free slots
+	static uint8_t				slBitmap[FL_COUNT];		// Which second level classes have free slots
+	static memslot *			lastEnd;				// The end marker of the last block added to the heap
+	static char *				heapEnd;				// The end of the last block added to the heap
+	static gfxHeapStats			stats;
 	static char					heap[GFX_OS_HEAP_SIZE];
 
+	/* Find the lowest bit set (bits must not be 0) */
+	static unsigned lowBit(uint32_t bits) {
+		static const uint8_t debruijn[32] = {
+			0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+			31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+			};
+		return debruijn[(uint32_t)((bits & (~bits + 1)) * 0x077CB531UL) >> 27];
+	}
+
+	/* Find the highest bit set (sz must not be 0) */
+	static unsigned highBit(size_t sz) {
+		unsigned	bit, step;
+
+		bit = 0;
+		for(step = sizeof(size_t)*4; step; step >>= 1) {
+			if ((sz >> step)) {
+				sz >>= step;
+				bit += step;
+			}
+		}
+		return bit;
+	}
+
+	/* Find the size class for a slot size */
+	static void getClass(size_t sz, unsigned *pfl, unsigned *psl) {
+		unsigned	fl;
+
+		fl = highBit(sz);
+		if (fl >= FL_SHIFT + FL_COUNT) {
+			*pfl = FL_COUNT - 1;
+			*psl = SL_COUNT - 1;
+			return;
+		}
+		*pfl = fl - FL_SHIFT;
+		*psl = (unsigned)(sz >> (fl - SL_BITS)) & (SL_COUNT - 1);
+	}
+
+	/* Add a slot to the free lists */
+	static void freeInsert(memslot *p) {
+		unsigned	fl, sl;
+		memslot		*pn;
+
+		// Set the boundary tag and tell the next slot that we are free
+		pn = NextSlot(p);
+		((size_t *)pn)[-1] = SlotSize(p);
+		pn->sz |= SLOT_PREVFREE;
+
+		getClass(SlotSize(p), &fl, &sl);
+		PrevFree(p) = 0;
+		NextFree(p) = freeSlots[fl][sl];
+		if (NextFree(p))
+			PrevFree(NextFree(p)) = p;
+		freeSlots[fl][sl] = p;
+		slBitmap[fl] |= 1 << sl;
+		flBitmap |= (uint32_t)1 << fl;
+		stats.freeslots++;
+	}
+
+	/* Remove a slot from the free lists */
+	static void freeRemove(memslot *p) {
+		unsigned	fl, sl;
+
+		getClass(SlotSize(p), &fl, &sl);
+		if (PrevFree(p))
+			NextFree(PrevFree(p)) = NextFree(p);
+		else if (!(freeSlots[fl][sl] = NextFree(p))) {
+			slBitmap[fl] &= ~(1 << sl);
+			if (!slBitmap[fl])
+				flBitmap &= ~((uint32_t)1 << fl);
+		}
+		if (NextFree(p))
+			PrevFree(NextFree(p)) = PrevFree(p);
+		NextSlot(p)->sz &= ~(size_t)SLOT_PREVFREE;
+		stats.freeslots--;
+	}
+
+	/* Find the first free slot in a size class that is at least sz bytes */
+	static memslot *freeSearch(unsigned fl, unsigned sl, size_t sz) {
+		memslot		*p;
+
+		for(p = freeSlots[fl][sl]; p && SlotSize(p) < sz; p = NextFree(p));
+		return p;
+	}
+
+	/* Find a free slot that is at least sz bytes */
+	static memslot *freeFind(size_t sz) {
+		unsigned	fl, sl, fl2, sl2;
+		uint32_t	bits;
+		memslot		*p;
+
+		// Round up to the next size class so that every slot in the class found is big enough
+		fl = highBit(sz);
+		getClass(fl >= SL_BITS ? sz + ((size_t)1 << (fl - SL_BITS)) - 1 : sz, &fl, &sl);
+
+		// Find the first non-empty size class at or above that
+		if ((bits = slBitmap[fl] & (~0U << sl)))
+			sl2 = lowBit(bits), fl2 = fl;
+		else if (fl + 1 < FL_COUNT && (bits = flBitmap & (~(uint32_t)0 << (fl + 1))))
+			fl2 = lowBit(bits), sl2 = lowBit(slBitmap[fl2]);
+		else
+			fl2 = FL_COUNT;
+
+		// Slots in the last size class may still be too small
+		if (fl2 < FL_COUNT && (p = freeSearch(fl2, sl2, sz)))
+			return p;
+
+		// Try the size class of the slot itself (some of its slots may be big enough)
+		getClass(sz, &fl, &sl);
+		return freeSearch(fl, sl, sz);
+	}
+
+	/* Merge a slot (not on the free lists) with any free neighbours and add it to the free lists */
+	static void freeSlot(memslot *p) {
+		memslot		*pn;
+
+		p->sz &= ~(size_t)SLOT_USED;
+
+		// Merge with the slot after if it is free
+		pn = NextSlot(p);
+		if (!(pn->sz & SLOT_USED)) {
+			freeRemove(pn);
+			p->sz += SlotSize(pn);
+		}
+
+		// Merge with the slot before if it is free
+		if ((p->sz & SLOT_PREVFREE)) {
+			pn = PrevSlot(p);
+			freeRemove(pn);
+			pn->sz += SlotSize(p);
+			p = pn;
+		}
+
+		freeInsert(p);
+	}
+
+	/* Return the end of an allocated slot to the free lists if it is big enough to be useful */
+	static void splitSlot(memslot *p, size_t sz) {
+		memslot		*pn;
+
+		if (SlotSize(p) < sz + SLOT_MIN)
+			return;
+		pn = (memslot *)((char *)p + sz);
+		pn->sz = (SlotSize(p) - sz) | SLOT_USED;
+		p->sz = sz | (p->sz & SLOT_FLAGS);
+		freeSlot(pn);
+	}
+
 	void _gosHeapInit(void) {
 		gfxAddHeapBlock(heap, GFX_OS_HEAP_SIZE);
 	}
 
 	void gfxAddHeapBlock(void *ptr, size_t sz) {
-		if (sz < sizeof(memslot)+sizeof(freeslot))
-			return;
+		memslot		*p;
+		size_t		adj;
+
+		if (lastEnd && (char *)ptr == heapEnd) {
+			// This block follows on from the last block so we start at its end marker
+			p = lastEnd;
+			sz += (char *)ptr - (char *)p;
+		} else {
+			// Align the start of the block
+			adj = (0 - (size_t)ptr) & (sizeof(size_t) - 1);
+			if (sz < adj + SLOT_MIN + sizeof(memslot))
+				return;
+			p = (memslot *)((char *)ptr + adj);
+			p->sz = 0;
+			sz -= adj;
+		}
+		heapEnd = (char *)p + sz;
+
+		// Leave room for an end marker
+		sz = (sz - sizeof(memslot)) & ~(SLOT_ALIGN - 1);
+		p->sz = sz | SLOT_USED | (p->sz & SLOT_PREVFREE);
+		lastEnd = NextSlot(p);
+		lastEnd->sz = SLOT_USED;
 
-		((memslot *)ptr)->sz = sz;
-		gfxFree(Slot2Ptr((memslot *)ptr));
+		stats.total += sz;
+		freeSlot(p);
 	}
 
 	void *gfxAlloc(size_t sz) {
-		register memslot *prev, *p, *pnew;
+		register memslot *p;
 
-		if (!sz) return 0;
+		if (!sz || sz > ~(size_t)0 - SLOT_MIN - SLOT_ALIGN) return 0;
 		sz = GetSlotSize(sz);
-		for (prev = 0, p = freeSlots; p != 0; prev = p, p = NextFree(p)) {
-			// Loop till we have a block big enough
-			if (p->sz < sz)
-				continue;
-				
-			// Can we save some memory by splitting this block?
-			if (p->sz >= sz + sizeof(memslot)+sizeof(freeslot)) {
-				pnew = (memslot *)((char *)p + sz);
-				pnew->sz = p->sz - sz;
-				p->sz = sz;
-				NextFree(pnew) = NextFree(p);
-				NextFree(p) = pnew;
-			}
-			
-			// Remove it from the free list
-			if (prev)
-				NextFree(prev) = NextFree(p);
-			else
-				freeSlots = NextFree(p);
-				
-			// Return the result found
-			return Slot2Ptr(p);
-		}
-		// No slots large enough
-		return 0;
+		if (!(p = freeFind(sz)))
+			return 0;
+
+		freeRemove(p);
+		p->sz |= SLOT_USED;
+		splitSlot(p, sz);
+
+		stats.used += SlotSize(p);
+		if (stats.used > stats.maxused)
+			stats.maxused = stats.used;
+		stats.allocs++;
+		return Slot2Ptr(p);
 	}
 
 	void *gfxRealloc(void *ptr, size_t oldsz, size_t sz) {
-		register memslot *prev, *p, *pfree;
+		register memslot *p, *pn;
+		void		*pnew;
 		(void) oldsz;
 
 		if (!ptr)
@@ -104,80 +291,66 @@
 			gfxFree(ptr);
 			return 0;
 		}
+		if (sz > ~(size_t)0 - SLOT_MIN - SLOT_ALIGN)
+			return 0;
 
 		p = Ptr2Slot(ptr);
 		sz = GetSlotSize(sz);
+		stats.used -= SlotSize(p);
 
-		// If the next slot is free (and contiguous) merge it into this one
-		for (prev = 0, pfree = freeSlots; pfree != 0; prev = pfree, pfree = NextFree(pfree)) {
-			if (pfree == (memslot *)((char *)p + p->sz)) {
-				p->sz += pfree->sz;
-				if (prev)
-					NextFree(prev) = NextFree(pfree);
-				else
-					freeSlots = NextFree(pfree);
-				break;
-			}
+		// If the next slot is free and gives us enough room merge it into this one
+		pn = NextSlot(p);
+		if (SlotSize(p) < sz && !(pn->sz & SLOT_USED) && SlotSize(p) + SlotSize(pn) >= sz) {
+			freeRemove(pn);
+			p->sz += SlotSize(pn);
 		}
 
 		// If this block is large enough we are nearly done
-		if (sz < p->sz) {
-			// Can we save some memory by splitting this block?
-			if (p->sz >= sz + sizeof(memslot)+sizeof(freeslot)) {
-				pfree = (memslot *)((char *)p + sz);
-				pfree->sz = p->sz - sz;
-				p->sz = sz;
-				NextFree(pfree) = freeSlots;
-				freeSlots = pfree;
-			}
-			return Slot2Ptr(p);
+		if (SlotSize(p) >= sz) {
+			splitSlot(p, sz);
+			stats.used += SlotSize(p);
+			if (stats.used > stats.maxused)
+				stats.maxused = stats.used;
+			return ptr;
 		}
+		stats.used += SlotSize(p);
 
 		// We need to do this the hard way
-		pfree = gfxAlloc(sz);
-		if (pfree)
+		if (!(pnew = gfxAlloc(sz - sizeof(memslot))))
 			return 0;
-		memcpy(pfree, ptr, p->sz - sizeof(memslot));
+		memcpy(pnew, ptr, SlotSize(p) - sizeof(memslot));
 		gfxFree(ptr);
-		return pfree;
+		return pnew;
 	}
 
 	void gfxFree(void *ptr) {
-		register memslot *prev, *p, *pfree;
+		register memslot *p;
 
 		if (!ptr)
 			return;
 
 		p = Ptr2Slot(ptr);
+		stats.used -= SlotSize(p);
+		stats.allocs--;
+		freeSlot(p);
+	}
 
-		// Find a free slot that is contiguous precceding and merge it into us
-		for (prev = 0, pfree = freeSlots; pfree != 0; prev = pfree, pfree = NextFree(pfree)) {
-			if (p == (memslot *)((char *)pfree + pfree->sz)) {
-				pfree->sz += p->sz;
-				if (prev)
-					NextFree(prev) = NextFree(pfree);
-				else
-					freeSlots = NextFree(pfree);
-				p = pfree;
-				break;
-			}
-		}
-		
-		// Find a free slot that is contiguous after and merge it into this one
-		for (prev = 0, pfree = freeSlots; pfree != 0; prev = pfree, pfree = NextFree(pfree)) {
-			if (pfree == (memslot *)((char *)p + p->sz)) {
-				p->sz += pfree->sz;
-				if (prev)
-					NextFree(prev) = NextFree(pfree);
-				else
-					freeSlots = NextFree(pfree);
-				break;
+	void gfxGetHeapStats(gfxHeapStats *pstats) {
+		unsigned	fl, sl;
+		memslot		*p;
+
+		*pstats = stats;
+
+		// The largest free slot is in the highest non-empty size class
+		pstats->largestfree = 0;
+		if (flBitmap) {
+			for(fl = FL_COUNT-1; !(flBitmap & ((uint32_t)1 << fl)); fl--);
+			for(sl = SL_COUNT-1; !(slBitmap[fl] & (1 << sl)); sl--);
+			for(p = freeSlots[fl][sl]; p; p = NextFree(p)) {
+				if (SlotSize(p) > pstats->largestfree)
+					pstats->largestfree = SlotSize(p);
 			}
 		}
-
-		// Add it into the free chain
-		NextFree(p) = freeSlots;
-		freeSlots = p;
 	}
 #endif
 
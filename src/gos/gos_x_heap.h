@@ -14,6 +14,23 @@
 /* Type definitions                                                          */
 /*===========================================================================*/
 
+#if GFX_OS_HEAP_SIZE != 0 || defined(__DOXYGEN__)
+	/**
+	 * @brief	Heap statistics returned by @p gfxGetHeapStats()
+	 * @note	All sizes are in bytes and include the allocator overheads.
+	 * @note	The heap is fragmented when @p largestfree is much smaller than
+	 * 			@p total - @p used.
+	 */
+	typedef struct gfxHeapStats {
+		size_t		total;			/**< The size of all the memory given to the heap */
+		size_t		used;			/**< The memory currently allocated */
+		size_t		maxused;		/**< The most memory that has ever been allocated at once */
+		size_t		largestfree;	/**< The largest free block */
+		unsigned	allocs;			/**< The number of allocated blocks */
+		unsigned	freeslots;		/**< The number of free blocks */
+	} gfxHeapStats;
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -23,13 +40,21 @@ extern "C" {
 		 * @brief	Take a chunk of memory and add it to the available heap
 		 * @note	Memory added must obviously not already be on the heap.
 		 * @note	It is allowable to add multiple non-contiguous blocks of memory
-		 * 			to the heap. If however it is contiguous with a previously added block
-		 * 			it will get merged with the existing block in order to allow
+		 * 			to the heap. If however it immediately follows the previously added block
+		 * 			it will get merged with that block in order to allow
 		 * 			allocations that span the boundary.
 		 * @pre		GFX_OS_HEAP_SIZE != 0 and an operating system that uses the
 		 * 			internal ugfx heap allocator rather than its own allocator.
 		 */
 		void gfxAddHeapBlock(void *ptr, size_t sz);
+
+		/**
+		 * @brief	Get the heap statistics
+		 * @param[out] pstats	The structure to fill in
+		 * @pre		GFX_OS_HEAP_SIZE != 0 and an operating system that uses the
+		 * 			internal ugfx heap allocator rather than its own allocator.
+		 */
+		void gfxGetHeapStats(gfxHeapStats *pstats);
 	#endif
 
 	void *gfxAlloc(size_t sz);
@@ -14,14 +14,30 @@
 #define GTIMER_FLG_JABBED		0x0004
 #define GTIMER_FLG_SCHEDULED	0x0008
 
-/* Don't rework this macro to use a ternary operator - the gcc compiler stuffs it up */
-#define TimeIsWithin(x, start, end)	((end >= start && x >= start && x <= end) || (end < start && (x >= start || x <= end)))
+/* Is time a before time b. This works even when the system tick counter wraps. */
+#define TimeIsBefore(a, b)	((systemticks_t)((a) - (b)) > (((systemticks_t)-1) >> 1))
+
+/* The timers run by each timer thread */
+typedef struct GTimerThread {
+	gfxThreadHandle		hThread;
+	GTimer				*pTimerHead;		// All scheduled timers (a circular list)
+	GTimer				*pTimerHeap;		// The scheduled timers that aren't infinite (a pairing heap ordered by when)
+	volatile bool_t		jabbed;				// A timer has been jabbed
+	gfxSem				waitsem;
+	#if GTIMER_THREADS > 1
+		GTimer			*running;			// The timer whose callback is currently running
+	#endif
+} GTimerThread;
+
+#if GTIMER_THREADS > 1
+	#define timerThread(pt)		(&TimerThreads[(pt)->thread])
+#else
+	#define timerThread(pt)		(&TimerThreads[0])
+#endif
 
 /* This mutex protects access to our tables */
 static gfxMutex			mutex;
-static gfxThreadHandle	hThread = 0;
-static GTimer			*pTimerHead = 0;
-static gfxSem			waitsem;
+static GTimerThread		TimerThreads[GTIMER_THREADS];
 static systemticks_t	ticks2ms;
 static DECLARE_THREAD_STACK(waTimerThread, GTIMER_THREAD_WORKAREA_SIZE);
 
@@ -29,133 +45,306 @@ static DECLARE_THREAD_STACK(waTimerThread, GTIMER_THREAD_WORKAREA_SIZE);
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+/* Remove a timer from the list of all timers */
+/* We already have the mutex */
+static void listRemove(GTimerThread *ptt, GTimer *pt) {
+	if (pt->next == pt)
+		ptt->pTimerHead = 0;
+	else {
+		pt->next->prev = pt->prev;
+		pt->prev->next = pt->next;
+		if (ptt->pTimerHead == pt)
+			ptt->pTimerHead = pt->next;
+	}
+}
+
+/* Add a timer to the end of the list of all timers */
+/* We already have the mutex */
+static void listAdd(GTimerThread *ptt, GTimer *pt) {
+	if (ptt->pTimerHead) {
+		pt->next = ptt->pTimerHead;
+		pt->prev = ptt->pTimerHead->prev;
+		pt->prev->next = pt;
+		pt->next->prev = pt;
+	} else
+		pt->next = pt->prev = ptt->pTimerHead = pt;
+}
+
+/* Merge two heaps. Both must be heap roots (heapnext and heapprev are 0). */
+static GTimer *heapMeld(GTimer *a, GTimer *b) {
+	GTimer	*t;
+
+	// The earliest becomes the root with the other as its first child
+	if (TimeIsBefore(b->when, a->when)) {
+		t = a; a = b; b = t;
+	}
+	b->heapnext = a->heapchild;
+	if (a->heapchild)
+		a->heapchild->heapprev = b;
+	b->heapprev = a;
+	a->heapchild = b;
+	return a;
+}
+
+/* Merge a list of sibling heaps into one heap (the standard two pass pairing) */
+static GTimer *heapCombine(GTimer *first) {
+	GTimer	*a, *b, *stack;
+
+	if (!first)
+		return 0;
+
+	// Merge pairs from the left, stacking the results
+	for(stack = 0; first; stack = a) {
+		a = first;
+		b = a->heapnext;
+		first = b ? b->heapnext : 0;
+		a->heapnext = a->heapprev = 0;
+		if (b) {
+			b->heapnext = b->heapprev = 0;
+			a = heapMeld(a, b);
+		}
+		a->heapnext = stack;
+	}
+
+	// Merge the results from the right
+	a = stack;
+	stack = a->heapnext;
+	a->heapnext = 0;
+	while(stack) {
+		b = stack;
+		stack = b->heapnext;
+		b->heapnext = 0;
+		a = heapMeld(a, b);
+	}
+	return a;
+}
+
+/* Add a timer to the heap */
+/* We already have the mutex */
+static void heapInsert(GTimerThread *ptt, GTimer *pt) {
+	pt->heapchild = pt->heapnext = pt->heapprev = 0;
+	ptt->pTimerHeap = ptt->pTimerHeap ? heapMeld(ptt->pTimerHeap, pt) : pt;
+}
+
+/* Remove a timer from the heap */
+/* We already have the mutex */
+static void heapRemove(GTimerThread *ptt, GTimer *pt) {
+	GTimer	*sub;
+
+	if (pt == ptt->pTimerHeap) {
+		ptt->pTimerHeap = heapCombine(pt->heapchild);
+		return;
+	}
+
+	// Cut it (and its children) out of the tree then merge its children back in
+	if (pt->heapprev->heapchild == pt)
+		pt->heapprev->heapchild = pt->heapnext;
+	else
+		pt->heapprev->heapnext = pt->heapnext;
+	if (pt->heapnext)
+		pt->heapnext->heapprev = pt->heapprev;
+	if ((sub = heapCombine(pt->heapchild)))
+		ptt->pTimerHeap = heapMeld(ptt->pTimerHeap, sub);
+}
+
+/* Find a jabbed timer */
+/* We already have the mutex */
+static GTimer *findJabbed(GTimerThread *ptt) {
+	GTimer	*pt;
+
+	// Clear the flag before looking so that a jab while we are looking isn't lost
+	if (!ptt->jabbed || !ptt->pTimerHead)
+		return 0;
+	ptt->jabbed = FALSE;
+	pt = ptt->pTimerHead;
+	do {
+		if ((pt->flags & GTIMER_FLG_JABBED)) {
+			ptt->jabbed = TRUE;				// There may be more
+			return pt;
+		}
+		pt = pt->next;
+	} while(pt != ptt->pTimerHead);
+	return 0;
+}
+
+/* Take a timer off its thread */
+/* We already have the mutex */
+static void timerRemove(GTimer *pt) {
+	GTimerThread	*ptt;
+
+	ptt = timerThread(pt);
+	if (!(pt->flags & GTIMER_FLG_INFINITE))
+		heapRemove(ptt, pt);
+	listRemove(ptt, pt);
+}
+
+static DECLARE_THREAD_FUNCTION(GTimerThreadHandler, arg);
+#if GTIMER_THREADS > 1
+	static void timerMove(GTimer *pt);
+#endif
+
+/* Give a timer to its thread (starting the thread if needed) */
+/* We already have the mutex */
+static void timerAdd(GTimer *pt) {
+	GTimerThread	*ptt;
+
+	ptt = timerThread(pt);
+
+	// Start the thread if not already going
+	if (!ptt->hThread) {
+		// The first thread uses our static stack. Any others get one allocated by the operating system.
+		if (ptt == TimerThreads)
+			ptt->hThread = gfxThreadCreate(waTimerThread, GTIMER_THREAD_WORKAREA_SIZE, GTIMER_THREAD_PRIORITY, GTimerThreadHandler, ptt);
+		#if GTIMER_THREADS > 1
+			else
+				ptt->hThread = gfxThreadCreate(0, GTIMER_THREAD_WORKAREA_SIZE, GTIMER_EXTRA_THREAD_PRIORITY, GTimerThreadHandler, ptt);
+		#endif
+		if (ptt->hThread) {gfxThreadClose(ptt->hThread);}		// We never really need the handle again
+	}
+
+	// Just pop it on the end of the list
+	listAdd(ptt, pt);
+
+	// Add it to the heap and bump the thread if it is now the first timer due
+	if (!(pt->flags & GTIMER_FLG_INFINITE)) {
+		heapInsert(ptt, pt);
+		if (ptt->pTimerHeap == pt)
+			gfxSemSignal(&ptt->waitsem);
+	}
+}
+
 static DECLARE_THREAD_FUNCTION(GTimerThreadHandler, arg) {
+	GTimerThread	*ptt;
 	GTimer			*pt;
 	systemticks_t	tm;
 	systemticks_t	nxtTimeout;
-	systemticks_t	lastTime;
 	GTimerFunction	fn;
 	void			*param;
-	(void)			arg;
+
+	ptt = (GTimerThread *)arg;
 
 	nxtTimeout = TIME_INFINITE;
-	lastTime = 0;
 	while(1) {
 		/* Wait for work to do. */
 		gfxYield();					// Give someone else a go no matter how busy we are
-		gfxSemWait(&waitsem, nxtTimeout);
-		
-	restartTimerChecks:
-	
-		// Our reference time
-		tm = gfxSystemTicks();
-		nxtTimeout = TIME_INFINITE;
+		gfxSemWait(&ptt->waitsem, nxtTimeout);
 		
-		/* We need to obtain the mutex */
-		gfxMutexEnter(&mutex);
+		while(1) {
+			// Our reference time
+			tm = gfxSystemTicks();
 
-		if (pTimerHead) {
-			pt = pTimerHead;
-			do {
-				// Do we have something to do for this timer?
-				if ((pt->flags & GTIMER_FLG_JABBED) || (!(pt->flags & GTIMER_FLG_INFINITE) && TimeIsWithin(pt->when, lastTime, tm))) {
-				
-					// Is this timer periodic?
-					if ((pt->flags & GTIMER_FLG_PERIODIC) && pt->period != TIME_IMMEDIATE) {
-						// Yes - Update ready for the next period
-						if (!(pt->flags & GTIMER_FLG_INFINITE)) {
-							// We may have skipped a period.
-							// We use this complicated formulae rather than a loop
-							//	because the gcc compiler stuffs up the loop so that it
-							//	either loops forever or doesn't get executed at all.
-							pt->when += ((tm + pt->period - pt->when) / pt->period) * pt->period;
-						}
-
-						// We are definitely no longer jabbed
-						pt->flags &= ~GTIMER_FLG_JABBED;
-						
-					} else {
-						// No - get us off the timers list
-						if (pt->next == pt)
-							pTimerHead = 0;
-						else {
-							pt->next->prev = pt->prev;
-							pt->prev->next = pt->next;
-							if (pTimerHead == pt)
-								pTimerHead = pt->next;
-						}
-						pt->flags = 0;
-					}
-					
-					// Call the callback function
-					fn = pt->fn;
-					param = pt->param;
-					gfxMutexExit(&mutex);
-					fn(param);
-					
-					// We no longer hold the mutex, the callback function may have taken a while
-					// and our list may have been altered so start again!
-					goto restartTimerChecks;
+			/* We need to obtain the mutex */
+			gfxMutexEnter(&mutex);
+
+			#if GTIMER_THREADS > 1
+				// A timer moved to another thread while its callback was running can go now
+				if (ptt->running) {
+					if (ptt->running->newthread != ptt->running->thread)
+						timerMove(ptt->running);
+					ptt->running = 0;
 				}
-				
+			#endif
+
+			// Is a timer jabbed or is the earliest timer due?
+			if (!(pt = findJabbed(ptt)) && ptt->pTimerHeap && !TimeIsBefore(tm, ptt->pTimerHeap->when))
+				pt = ptt->pTimerHeap;
+
+			if (!pt) {
 				// Find when we next need to wake up
-				if (!(pt->flags & GTIMER_FLG_INFINITE) && pt->when - tm < nxtTimeout)
-					nxtTimeout = (pt->when - tm)/ticks2ms;
-				pt = pt->next;
-			} while(pt != pTimerHead);
-		}
+				nxtTimeout = ptt->pTimerHeap ? (ptt->pTimerHeap->when - tm)/ticks2ms : TIME_INFINITE;
+				gfxMutexExit(&mutex);
+				break;
+			}
 
-		// Ready for the next loop
-		lastTime = tm;
-		gfxMutexExit(&mutex);
+			// Is this timer periodic?
+			if ((pt->flags & GTIMER_FLG_PERIODIC) && pt->period != TIME_IMMEDIATE) {
+				// Yes - Update ready for the next period
+				if (!(pt->flags & GTIMER_FLG_INFINITE)) {
+					// We may have skipped a period.
+					// We use this complicated formulae rather than a loop
+					//	because the gcc compiler stuffs up the loop so that it
+					//	either loops forever or doesn't get executed at all.
+					if (!TimeIsBefore(tm, pt->when))
+						pt->when += ((tm + pt->period - pt->when) / pt->period) * pt->period;
+
+					// Move it to its new place in the heap
+					heapRemove(ptt, pt);
+					heapInsert(ptt, pt);
+				}
+
+				// We are definitely no longer jabbed
+				pt->flags &= ~GTIMER_FLG_JABBED;
+				
+			} else {
+				// No - get us off the timers list
+				timerRemove(pt);
+				pt->flags = 0;
+			}
+			
+			// Call the callback function
+			fn = pt->fn;
+			param = pt->param;
+			#if GTIMER_THREADS > 1
+				ptt->running = pt;
+			#endif
+			gfxMutexExit(&mutex);
+			fn(param);
+			
+			// We no longer hold the mutex, the callback function may have taken a while
+			// and our timers may have been altered so get the time again and look for the next timer.
+		}
 	}
 	THREAD_RETURN(0);
 }
 
 void _gtimerInit(void)
 {
-	gfxSemInit(&waitsem, 0, 1);
+	unsigned	i;
+
+	for(i = 0; i < GTIMER_THREADS; i++)
+		gfxSemInit(&TimerThreads[i].waitsem, 0, 1);
 	gfxMutexInit(&mutex);
 	ticks2ms = gfxMillisecondsToTicks(1);
 }
 
 void _gtimerDeinit(void)
 {
-	gfxSemDestroy(&waitsem);
+	unsigned	i;
+
+	for(i = 0; i < GTIMER_THREADS; i++)
+		gfxSemDestroy(&TimerThreads[i].waitsem);
 	gfxMutexDestroy(&mutex);
-	// Need to destroy GTimer thread here
+	// Need to destroy GTimer threads here
 }
 
 void gtimerInit(GTimer* pt)
 {
 	pt->flags = 0;
+	#if GTIMER_THREADS > 1
+		pt->thread = pt->newthread = 0;
+	#endif
 }
 
 void gtimerDeinit(GTimer* pt)
 {
 	gtimerStop(pt);
+
+	#if GTIMER_THREADS > 1
+		// Make sure its thread doesn't touch it again after its callback
+		gfxMutexEnter(&mutex);
+		if (timerThread(pt)->running == pt)
+			timerThread(pt)->running = 0;
+		gfxMutexExit(&mutex);
+	#endif
 }
 
 void gtimerStart(GTimer *pt, GTimerFunction fn, void *param, bool_t periodic, delaytime_t millisec) {
 	gfxMutexEnter(&mutex);
 	
-	// Start our thread if not already going
-	if (!hThread) {
-		hThread = gfxThreadCreate(waTimerThread, GTIMER_THREAD_WORKAREA_SIZE, GTIMER_THREAD_PRIORITY, GTimerThreadHandler, 0);
-		if (hThread) {gfxThreadClose(hThread);}		// We never really need the handle again
-	}
-
 	// Is this already scheduled?
 	if (pt->flags & GTIMER_FLG_SCHEDULED) {
 		// Cancel it!
-		if (pt->next == pt)
-			pTimerHead = 0;
-		else {
-			pt->next->prev = pt->prev;
-			pt->prev->next = pt->next;
-			if (pTimerHead == pt)
-				pTimerHead = pt->next;
-		}
+		timerRemove(pt);
 	}
 	
 	// Set up the timer structure
@@ -172,18 +361,8 @@ void gtimerStart(GTimer *pt, GTimerFunction fn, void *param, bool_t periodic, de
 		pt->when = gfxSystemTicks() + pt->period;
 	}
 
-	// Just pop it on the end of the queue
-	if (pTimerHead) {
-		pt->next = pTimerHead;
-		pt->prev = pTimerHead->prev;
-		pt->prev->next = pt;
-		pt->next->prev = pt;
-	} else
-		pt->next = pt->prev = pTimerHead = pt;
-
-	// Bump the thread
-	if (!(pt->flags & GTIMER_FLG_INFINITE))
-		gfxSemSignal(&waitsem);
+	// Give it to its thread
+	timerAdd(pt);
 	gfxMutexExit(&mutex);
 }
 
@@ -191,20 +370,44 @@ void gtimerStop(GTimer *pt) {
 	gfxMutexEnter(&mutex);
 	if (pt->flags & GTIMER_FLG_SCHEDULED) {
 		// Cancel it!
-		if (pt->next == pt)
-			pTimerHead = 0;
-		else {
-			pt->next->prev = pt->prev;
-			pt->prev->next = pt->next;
-			if (pTimerHead == pt)
-				pTimerHead = pt->next;
-		}
+		timerRemove(pt);
 		// Make sure we know the structure is dead!
 		pt->flags = 0;
 	}
 	gfxMutexExit(&mutex);
 }
 
+#if GTIMER_THREADS > 1
+	/* Move a timer to its new thread */
+	/* We already have the mutex */
+	static void timerMove(GTimer *pt) {
+		if (pt->flags & GTIMER_FLG_SCHEDULED) {
+			timerRemove(pt);
+			pt->thread = pt->newthread;
+			timerAdd(pt);
+			if ((pt->flags & GTIMER_FLG_JABBED)) {
+				timerThread(pt)->jabbed = TRUE;
+				gfxSemSignal(&timerThread(pt)->waitsem);
+			}
+		} else
+			pt->thread = pt->newthread;
+	}
+
+	void gtimerSetThread(GTimer *pt, unsigned thread) {
+		if (thread >= GTIMER_THREADS)
+			thread = GTIMER_THREADS-1;
+
+		gfxMutexEnter(&mutex);
+		pt->newthread = thread;
+
+		// If its callback is running its current thread moves it when the callback returns.
+		//	This stops the callback from ever running on two threads at once.
+		if (pt->thread != thread && timerThread(pt)->running != pt)
+			timerMove(pt);
+		gfxMutexExit(&mutex);
+	}
+#endif
+
 bool_t gtimerIsActive(GTimer *pt) {
 	return (pt->flags & GTIMER_FLG_SCHEDULED) ? TRUE : FALSE;
 }
@@ -214,18 +417,20 @@ void gtimerJab(GTimer *pt) {
 	
 	// Jab it!
 	pt->flags |= GTIMER_FLG_JABBED;
+	timerThread(pt)->jabbed = TRUE;
 
 	// Bump the thread
-	gfxSemSignal(&waitsem);
+	gfxSemSignal(&timerThread(pt)->waitsem);
 	gfxMutexExit(&mutex);
 }
 
 void gtimerJabI(GTimer *pt) {
 	// Jab it!
 	pt->flags |= GTIMER_FLG_JABBED;
+	timerThread(pt)->jabbed = TRUE;
 
 	// Bump the thread
-	gfxSemSignalI(&waitsem);
+	gfxSemSignalI(&timerThread(pt)->waitsem);
 }
 
 #endif /* GFX_USE_GTIMER */
@@ -38,7 +38,11 @@
 /*===========================================================================*/
 
 /* Data part of a static GTimer initialiser */
-#define _GTIMER_DATA() {0,0,0,0,0,0,0}
+#if GTIMER_THREADS > 1
+	#define _GTIMER_DATA() {0,0,0,0,0,0,0,0,0,0,0,0}
+#else
+	#define _GTIMER_DATA() {0,0,0,0,0,0,0,0,0,0}
+#endif
 
 /* Static GTimer initialiser */
 #define GTIMER_DECL(name) GTimer name = _GTIMER_DATA()
@@ -57,8 +61,20 @@ typedef struct GTimer_t {
 	uint16_t			flags;
 	struct GTimer_t		*next;
 	struct GTimer_t		*prev;
+	struct GTimer_t		*heapchild;
+	struct GTimer_t		*heapnext;
+	struct GTimer_t		*heapprev;
+	#if GTIMER_THREADS > 1
+		uint8_t			thread;
+		uint8_t			newthread;
+	#endif
 } GTimer;
 
+/**
+ * @brief	The timer thread used by the GINPUT polling timers
+ */
+#define GTIMER_INPUT_THREAD		(GTIMER_THREADS-1)
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -127,6 +143,26 @@ void gtimerStart(GTimer *pt, GTimerFunction fn, void *param, bool_t periodic, de
  */
 void gtimerStop(GTimer *pt);
 
+#if GTIMER_THREADS > 1 || defined(__DOXYGEN__)
+	/**
+	 * @brief   Choose the timer thread that runs a timer
+	 *
+	 * @param[in] pt		Pointer to a GTimer structure
+	 * @param[in] thread	The timer thread (0 to GTIMER_THREADS-1)
+	 *
+	 * @note				An active timer is moved to the new thread without being restarted.
+	 * @note				If the timer's callback is currently running the move happens when the
+	 * 						callback returns so the callback never runs on two threads at once.
+	 * @note				gtimerInit() puts the timer back on thread 0.
+	 * @note				Does nothing if GTIMER_THREADS is 1.
+	 *
+	 * @api
+	 */
+	void gtimerSetThread(GTimer *pt, unsigned thread);
+#else
+	#define gtimerSetThread(pt, thread)		((void)0)
+#endif
+
 /**
  * @brief   Test if a timer is currently active
  *
@@ -33,6 +33,25 @@
 	#ifndef GTIMER_THREAD_PRIORITY
 		#define GTIMER_THREAD_PRIORITY			HIGH_PRIORITY
 	#endif
+	/**
+	 * @brief	The number of timer threads
+	 * @details	Defaults to 1
+	 * @details	Each timer is run by one timer thread and a slow callback only delays the
+	 * 			timers on the same thread. Use gtimerSetThread() to choose the thread for a timer.
+	 * 			New timers use thread 0. The GINPUT polling timers use the last thread.
+	 * @note	Threads other than thread 0 have their stacks allocated by the operating system
+	 * 			when they are first needed.
+	 */
+	#ifndef GTIMER_THREADS
+		#define GTIMER_THREADS					1
+	#endif
+	/**
+	 * @brief	Defines the priority of the timer threads other than thread 0
+	 * @details	Defaults to GTIMER_THREAD_PRIORITY
+	 */
+	#ifndef GTIMER_EXTRA_THREAD_PRIORITY
+		#define GTIMER_EXTRA_THREAD_PRIORITY	GTIMER_THREAD_PRIORITY
+	#endif
 	/**
 	 * @brief   Defines the size of the timer threads work area (stack+structures).
 	 * @details	Defaults to 2048 bytes
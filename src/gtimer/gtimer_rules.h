@@ -17,6 +17,9 @@
 #define _GTIMER_RULES_H
 
 #if GFX_USE_GTIMER
+	#if GTIMER_THREADS < 1 || GTIMER_THREADS > 255
+		#error "GTIMER: GTIMER_THREADS must be between 1 and 255"
+	#endif
 	#if GFX_USE_GDISP && !GDISP_NEED_MULTITHREAD
 		#if GFX_DISPLAY_RULE_WARNINGS
 			#warning "GTIMER: GDISP_NEED_MULTITHREAD has not been specified."
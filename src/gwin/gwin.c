@@ -94,7 +94,7 @@ GHandle _gwindowCreate(GDisplay *g, GWindowObject *pgw, const GWindowInit *pInit
 		pgw->flags = flags;
 	
 	// Initialise all basic fields
-	pgw->display = g;
+	pgw->display = _gwinCompositorDisplay(g);
 	pgw->vmt = vmt;
 	pgw->color = defaultFgColor;
 	pgw->bgcolor = defaultBgColor;
@@ -268,6 +268,35 @@ void _gwinDestroy(GHandle gh, GRedrawMethod how);
  */
 bool_t _gwinWMAdd(GHandle gh, const GWindowInit *pInit);
 
+#if GWIN_NEED_COMPOSITOR || defined(__DOXYGEN__)
+	/**
+	 * @brief	Get the display that GWIN draws on in place of a real display
+	 * @return	The off-screen pixmap for the display. The display itself is returned if the pixmap can't be created.
+	 *
+	 * @param[in]	g		The real display
+	 *
+	 * @note	The pixmap is created the first time this is called for a display.
+	 *
+	 * @notapi
+	 */
+	GDisplay *_gwinCompositorDisplay(GDisplay *g);
+
+	/**
+	 * @brief	Get the display that GWIN draws on in place of a real display without creating it
+	 * @return	The off-screen pixmap for the display. The display itself is returned if there is no pixmap yet.
+	 *
+	 * @param[in]	g		The real display
+	 *
+	 * @note	Unlike @p _gwinCompositorDisplay() this never allocates or locks so it is safe from input handlers.
+	 *
+	 * @notapi
+	 */
+	GDisplay *_gwinCompositorFindDisplay(GDisplay *g);
+#else
+	#define _gwinCompositorDisplay(g)		(g)
+	#define _gwinCompositorFindDisplay(g)	(g)
+#endif
+
 #if GWIN_NEED_WIDGET || defined(__DOXYGEN__)
 	/**
 	 * @brief	Initialise (and allocate if necessary) the base Widget object
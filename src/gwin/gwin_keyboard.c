@@ -154,7 +154,8 @@ static void SendVirtualKeyEventToListener(GSourceListener	*psl, GKeyboardObject
 		pe->c[i] = 0;
 	pe->keystate = psl->srcflags;
 	psl->srcflags = 0;
-	geventSendEvent(psl);
+	if (!geventSendEvent(psl))
+		psl->srcflags |= GKEYSTATE_MISSED_EVENT;
 }
 
 static void SendVirtualKeyEvent(GKeyboardObject *gk) {
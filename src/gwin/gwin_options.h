@@ -30,6 +30,21 @@
 	#ifndef GWIN_NEED_WINDOWMANAGER
 		#define GWIN_NEED_WINDOWMANAGER	FALSE
 	#endif
+	/**
+	 * @brief   Should windows be composed off-screen before being sent to the display
+	 * @details	Defaults to FALSE
+	 * @note	When TRUE each display used by GWIN gets a full screen pixmap that all windows
+	 * 			draw into. The area changed is sent to the real display in a single blit once
+	 * 			all pending redraws are complete. This removes flicker and turns many small
+	 * 			display operations into one transfer which suits slow (eg SPI) displays.
+	 * @note	Requires GWIN_NEED_WINDOWMANAGER and enough RAM for a copy of each display.
+	 * 			GDISP_NEED_PIXMAP is turned on automatically.
+	 * @note	Drawing directly on the real display with GDISP calls will be overwritten
+	 * 			where windows change. Use the window's display (gh->display) instead.
+	 */
+	#ifndef GWIN_NEED_COMPOSITOR
+		#define GWIN_NEED_COMPOSITOR	FALSE
+	#endif
 	/**
 	 * @brief	Should the widget hierarchy be included. This provides parent-child features.
 	 * @details	Defaults to FALSE
@@ -214,6 +229,21 @@
 	#ifndef GWIN_REDRAW_SINGLEOP
 		#define GWIN_REDRAW_SINGLEOP	FALSE
 	#endif
+	/**
+	 * @brief	Only redraw the visible and damaged parts of each window
+	 * @details	Defaults to FALSE
+	 * @note	Normally a window is redrawn in full even when other windows cover part of it.
+	 * 			Windows then above it (including the children of a container) are redrawn too.
+	 * 			Setting this option tracks the damaged area of each display as a region and
+	 * 			redraws each window only through the parts of it that are both visible and damaged.
+	 * 			This saves a lot of drawing when windows overlap or containers are used.
+	 * @note	Requires GWIN_NEED_WINDOWMANAGER and GDISP_NEED_CLIP. GDISP_NEED_REGIONS is turned on automatically.
+	 * @note	Windows must fully paint their own area (as all standard widgets do) as the area
+	 * 			underneath them is no longer drawn by their parent.
+	 */
+	#ifndef GWIN_REDRAW_REGIONS
+		#define GWIN_REDRAW_REGIONS		FALSE
+	#endif
 	/**
 	 * @brief   Buttons should not insist the mouse is over the button on mouse release
 	 * @details	Defaults to FALSE
@@ -99,6 +99,33 @@
 			#define GFX_USE_GTIMER		TRUE
 		#endif
 	#endif
+	#if GWIN_NEED_COMPOSITOR
+		#if !GWIN_NEED_WINDOWMANAGER
+			#error "GWIN: GWIN_NEED_WINDOWMANAGER is required if GWIN_NEED_COMPOSITOR is TRUE."
+		#endif
+		#if !GDISP_NEED_PIXMAP
+			#if GFX_DISPLAY_RULE_WARNINGS
+				#warning "GWIN: GDISP_NEED_PIXMAP is required if GWIN_NEED_COMPOSITOR is TRUE. It has been turned on for you."
+			#endif
+			#undef GDISP_NEED_PIXMAP
+			#define GDISP_NEED_PIXMAP	TRUE
+		#endif
+	#endif
+	#if GWIN_REDRAW_REGIONS
+		#if !GWIN_NEED_WINDOWMANAGER
+			#error "GWIN: GWIN_NEED_WINDOWMANAGER is required if GWIN_REDRAW_REGIONS is TRUE."
+		#endif
+		#if !GDISP_NEED_CLIP
+			#error "GWIN: GDISP_NEED_CLIP is required if GWIN_REDRAW_REGIONS is TRUE."
+		#endif
+		#if !GDISP_NEED_REGIONS
+			#if GFX_DISPLAY_RULE_WARNINGS
+				#warning "GWIN: GDISP_NEED_REGIONS is required if GWIN_REDRAW_REGIONS is TRUE. It has been turned on for you."
+			#endif
+			#undef GDISP_NEED_REGIONS
+			#define GDISP_NEED_REGIONS	TRUE
+		#endif
+	#endif
 
 	// Rules for individual objects
 	#if GWIN_NEED_LIST
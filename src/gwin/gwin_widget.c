@@ -101,6 +101,9 @@ static void gwidgetEvent(void *param, GEvent *pe) {
 
 	GHandle				h;
 	GHandle				gh;
+	#if GFX_USE_GINPUT && GINPUT_NEED_MOUSE
+		GDisplay *		g;
+	#endif
 	#if GFX_USE_GINPUT && (GINPUT_NEED_TOGGLE || GINPUT_NEED_DIAL)
 		uint16_t		role;
 	#endif
@@ -112,11 +115,14 @@ static void gwidgetEvent(void *param, GEvent *pe) {
 	#if GFX_USE_GINPUT && GINPUT_NEED_MOUSE
 	case GEVENT_MOUSE:
 	case GEVENT_TOUCH:
+		// Windows on this display draw on its compositor pixmap (if any)
+		g = _gwinCompositorFindDisplay(pme->display);
+
 		// Cycle through all windows
 		for (gh = 0, h = gwinGetNextWindow(0); h; h = gwinGetNextWindow(h)) {
 
 			// The window must be on this display and visible to be relevant
-			if (h->display != pme->display || !(h->flags & GWIN_FLG_SYSVISIBLE))
+			if (h->display != g || !(h->flags & GWIN_FLG_SYSVISIBLE))
 				continue;
 
 			// Is the mouse currently captured by this widget?
@@ -175,6 +175,22 @@ static volatile uint8_t		RedrawPending;
 	#define DOREDRAW_INVISIBLES		0x01
 	#define DOREDRAW_VISIBLES		0x02
 	#define DOREDRAW_FLASHRUNNING	0x04
+	#define DOREDRAW_COMPOSE		0x08
+
+#if GWIN_NEED_COMPOSITOR
+	typedef struct compositor {
+		GDisplay *		real;				// The real display
+		GDisplay *		pixmap;				// The pixmap that GWIN draws on instead
+		coord_t			x0, y0, x1, y1;		// The area changed since the last frame
+	} compositor;
+
+	static compositor		Compositors[GDISP_TOTAL_DISPLAYS];
+	static void				CompositorDirty(GHandle gh);
+	static void				CompositorFlush(void);
+	#define MarkDirty(gh)	CompositorDirty(gh)
+#else
+	#define MarkDirty(gh)
+#endif
 
 
 /*-----------------------------------------------
@@ -207,6 +223,17 @@ void _gwmDeinit(void)
 	#if !GWIN_REDRAW_IMMEDIATE
 		gtimerDeinit(&RedrawTimer);
 	#endif
+	#if GWIN_NEED_COMPOSITOR
+		{
+			unsigned	i;
+
+			for(i = 0; i < GDISP_TOTAL_DISPLAYS; i++) {
+				if (Compositors[i].pixmap)
+					gdispPixmapDelete(Compositors[i].pixmap);
+				Compositors[i].real = Compositors[i].pixmap = 0;
+			}
+		}
+	#endif
 	gfxQueueASyncDeinit(&_GWINList);
 	gfxSemDestroy(&gwinsem);
 }
@@ -222,8 +249,199 @@ void _gwmDeinit(void)
 	}
 #endif
 
+#if GWIN_NEED_COMPOSITOR
+	GDisplay *_gwinCompositorDisplay(GDisplay *g) {
+		compositor	*pc;
+
+		for(pc = Compositors; pc < Compositors+GDISP_TOTAL_DISPLAYS; pc++) {
+			if (pc->real == g || pc->pixmap == g)
+				return pc->pixmap;
+			if (pc->real)
+				continue;
+
+			// Create the pixmap for this display (the lock stops two threads doing this at once)
+			gfxSemWait(&gwinsem, TIME_INFINITE);
+			if (!pc->real) {
+				if ((pc->pixmap = gdispPixmapCreate(gdispGGetWidth(g), gdispGGetHeight(g)))) {
+					gdispGFillArea(pc->pixmap, 0, 0, gdispGGetWidth(g), gdispGGetHeight(g), gwinGetDefaultBgColor());
+					pc->x0 = pc->y0 = pc->x1 = pc->y1 = 0;
+					pc->real = g;
+				}
+			}
+			gfxSemSignal(&gwinsem);
+			if (!pc->real)
+				return g;
+			if (pc->real == g)
+				return pc->pixmap;
+		}
+		return g;
+	}
+
+	GDisplay *_gwinCompositorFindDisplay(GDisplay *g) {
+		compositor	*pc;
+
+		for(pc = Compositors; pc < Compositors+GDISP_TOTAL_DISPLAYS; pc++) {
+			if (pc->real == g || pc->pixmap == g)
+				return pc->pixmap;
+		}
+		return g;
+	}
+
+	// Add a window's area to the area to be sent to the real display
+	static void CompositorDirty(GHandle gh) {
+		compositor	*pc;
+
+		for(pc = Compositors; pc < Compositors+GDISP_TOTAL_DISPLAYS; pc++) {
+			if (pc->pixmap != gh->display)
+				continue;
+			if (pc->x1 <= pc->x0) {
+				pc->x0 = gh->x; pc->x1 = gh->x+gh->width;
+				pc->y0 = gh->y; pc->y1 = gh->y+gh->height;
+			} else {
+				if (gh->x < pc->x0)						pc->x0 = gh->x;
+				if (gh->y < pc->y0)						pc->y0 = gh->y;
+				if (gh->x+gh->width > pc->x1)			pc->x1 = gh->x+gh->width;
+				if (gh->y+gh->height > pc->y1)			pc->y1 = gh->y+gh->height;
+			}
+			RedrawPending |= DOREDRAW_COMPOSE;
+			return;
+		}
+	}
+
+	#if (GDISP_PIXELFORMAT & GDISP_COLORSYSTEM_MASK) == GDISP_COLORSYSTEM_GRAYSCALE && (GDISP_PIXELFORMAT & 0xFF) < 8
+		#define COMPOSITOR_BITS		(GDISP_PIXELFORMAT & 0xFF)
+
+		// Packed pixmaps can't be blitted directly - unpack them a line at a time.
+		//	The pixmap stores each row MSB first padded out to a whole byte.
+		static bool_t CompositorBlit(compositor *pc) {
+			const uint8_t	*src;
+			pixel_t			*line;
+			coord_t			x, y, cx;
+			unsigned		pitch, bit;
+
+			cx = pc->x1 - pc->x0;
+			if (!(line = gfxAlloc(cx * sizeof(pixel_t))))
+				return FALSE;
+			pitch = (gdispGGetWidth(pc->pixmap) * COMPOSITOR_BITS + 7) / 8;
+			for(y = pc->y0; y < pc->y1; y++) {
+				src = (const uint8_t *)gdispPixmapGetBits(pc->pixmap) + y * pitch;
+				for(x = 0; x < cx; x++) {
+					bit = (pc->x0 + x) * COMPOSITOR_BITS;
+					line[x] = (pixel_t)((src[bit >> 3] >> (8 - COMPOSITOR_BITS - (bit & 7))) & ((1 << COMPOSITOR_BITS) - 1));
+				}
+				gdispGBlitArea(pc->real, pc->x0, y, cx, 1, 0, 0, cx, line);
+			}
+			gfxFree(line);
+			return TRUE;
+		}
+	#else
+		static bool_t CompositorBlit(compositor *pc) {
+			gdispGBlitArea(pc->real, pc->x0, pc->y0, pc->x1-pc->x0, pc->y1-pc->y0, pc->x0, pc->y0, gdispGGetWidth(pc->pixmap), gdispPixmapGetBits(pc->pixmap));
+			return TRUE;
+		}
+	#endif
+
+	// Send the changed area of each pixmap to its real display
+	static void CompositorFlush(void) {
+		compositor	*pc;
+
+		RedrawPending &= ~DOREDRAW_COMPOSE;
+		for(pc = Compositors; pc < Compositors+GDISP_TOTAL_DISPLAYS && pc->real; pc++) {
+			if (pc->x1 <= pc->x0)
+				continue;
+			if (!CompositorBlit(pc)) {
+				// Out of memory - try again next time
+				RedrawPending |= DOREDRAW_COMPOSE;
+				continue;
+			}
+			pc->x0 = pc->y0 = pc->x1 = pc->y1 = 0;
+		}
+	}
+#endif
+
+#if GWIN_REDRAW_REGIONS
+	// These are only used while holding gwinsem
+	static gdispRegion		damage;
+	static gdispRegion		rgn;
+
+	#if GWIN_NEED_CONTAINERS
+		#define IsTopLevel(gh)		(!(gh)->parent)
+	#else
+		#define IsTopLevel(gh)		TRUE
+	#endif
+
+	// Remove the parts covered by visible windows above this one.
+	//	If the region gets too complex and markAbove is set, the covering windows are marked for redraw instead.
+	static void ExcludeWindowsAbove(gdispRegion *prgn, GHandle gh, bool_t markAbove) {
+		GHandle		gx;
+
+		for(gx = gwinGetNextWindow(gh); gx; gx = gwinGetNextWindow(gx)) {
+			if (!(gx->flags & GWIN_FLG_SYSVISIBLE) || gx->display != gh->display)
+				continue;
+			if (!gdispRegionSubtractRect(prgn, gx->x, gx->y, gx->width, gx->height) && markAbove) {
+				gx->flags |= GWIN_FLG_NEEDREDRAW;
+				RedrawPending |= DOREDRAW_VISIBLES;
+			}
+		}
+	}
+
+	// Redraw a window through each rectangle of a region
+	static void RedrawWindowRegion(GHandle gh, const gdispRegion *prgn) {
+		uint32_t	flags;
+		unsigned	i;
+
+		// The window manager clears the redraw flags so put them back for each rectangle
+		flags = gh->flags & (GWIN_FLG_NEEDREDRAW|GWIN_FLG_BGREDRAW);
+		for(i = 0; i < prgn->cnt; i++) {
+			gh->flags |= flags;
+			gdispGSetClip(gh->display, prgn->rects[i].x, prgn->rects[i].y, prgn->rects[i].cx, prgn->rects[i].cy);
+			_GWINwm->vmt->Redraw(gh);
+		}
+		gdispGUnsetClip(gh->display);
+		gh->flags &= ~(GWIN_FLG_NEEDREDRAW|GWIN_FLG_BGREDRAW);
+	}
+
+	// Repaint the damaged area of a display
+	static void RedrawDamage(GDisplay *g) {
+		GHandle		gx;
+		unsigned	i;
+
+		// Clear the parts not covered by any window.
+		//	If that gets too complex it doesn't matter as the windows get drawn over it.
+		rgn = damage;
+		for(gx = gwinGetNextWindow(0); gx; gx = gwinGetNextWindow(gx)) {
+			if ((gx->flags & GWIN_FLG_SYSVISIBLE) && gx->display == g && IsTopLevel(gx))
+				gdispRegionSubtractRect(&rgn, gx->x, gx->y, gx->width, gx->height);
+		}
+		gdispGFillRegion(g, &rgn, gwinGetDefaultBgColor());
+
+		// Redraw the exposed part of each window from the bottom up.
+		//	If that gets too complex it doesn't matter as the windows above get drawn over it.
+		for(gx = gwinGetNextWindow(0); gx; gx = gwinGetNextWindow(gx)) {
+			if (!(gx->flags & GWIN_FLG_SYSVISIBLE) || gx->display != g || !gdispRegionOverlapsRect(&damage, gx->x, gx->y, gx->width, gx->height))
+				continue;
+			rgn = damage;
+			gdispRegionIntersectRect(&rgn, gx->x, gx->y, gx->width, gx->height);
+			ExcludeWindowsAbove(&rgn, gx, FALSE);
+			if (!gx->vmt->Redraw) {
+				// We can't redraw this window but we want full coverage so just clear the area
+				gdispGFillRegion(g, &rgn, gx->bgcolor);
+				continue;
+			}
+			for(i = 0; i < rgn.cnt; i++) {
+				gdispGSetClip(g, rgn.rects[i].x, rgn.rects[i].y, rgn.rects[i].cx, rgn.rects[i].cy);
+				gx->vmt->Redraw(gx);
+			}
+			gdispGUnsetClip(g);
+		}
+	}
+#endif
+
 void _gwinFlushRedraws(GRedrawMethod how) {
 	GHandle		gh;
+	#if GWIN_REDRAW_REGIONS
+		GDisplay *	g;
+	#endif
 
 	// Do we really need to do anything?
 	if (!RedrawPending)
@@ -237,6 +455,44 @@ void _gwinFlushRedraws(GRedrawMethod how) {
 		return;
 
 	// Do loss of visibility first
+	#if GWIN_REDRAW_REGIONS
+		while ((RedrawPending & DOREDRAW_INVISIBLES)) {
+			RedrawPending &= ~DOREDRAW_INVISIBLES;				// Catch new requests
+
+			// Gather the area uncovered on one display. Other displays are done on the next pass.
+			g = 0;
+			gdispRegionClear(&damage);
+			for(gh = gwinGetNextWindow(0); gh; gh = gwinGetNextWindow(gh)) {
+				if ((gh->flags & (GWIN_FLG_NEEDREDRAW|GWIN_FLG_SYSVISIBLE)) != GWIN_FLG_NEEDREDRAW)
+					continue;
+				if (!g)
+					g = gh->display;
+				else if (gh->display != g) {
+					RedrawPending |= DOREDRAW_INVISIBLES;
+					continue;
+				}
+				if ((gh->flags & GWIN_FLG_BGREDRAW)) {
+					gdispRegionAddRect(&damage, gh->x, gh->y, gh->width, gh->height);
+					MarkDirty(gh);
+				}
+				gh->flags &= ~(GWIN_FLG_NEEDREDRAW|GWIN_FLG_BGREDRAW);
+			}
+			if (!g)
+				break;
+
+			// Do the redraw
+			RedrawDamage(g);
+
+			// Postpone further redraws
+			#if !GWIN_REDRAW_IMMEDIATE && !GWIN_REDRAW_SINGLEOP
+				if (how == REDRAW_NOWAIT) {
+					if ((RedrawPending & (DOREDRAW_INVISIBLES|DOREDRAW_VISIBLES)))
+						TriggerRedraw();
+					goto releaselock;
+				}
+			#endif
+		}
+	#else
 	while ((RedrawPending & DOREDRAW_INVISIBLES)) {
 		RedrawPending &= ~DOREDRAW_INVISIBLES;				// Catch new requests
 
@@ -245,6 +501,7 @@ void _gwinFlushRedraws(GRedrawMethod how) {
 				continue;
 
 			// Do the redraw
+			MarkDirty(gh);
 			#if GDISP_NEED_CLIP
 				gdispGSetClip(gh->display, gh->x, gh->y, gh->width, gh->height);
 				_GWINwm->vmt->Redraw(gh);
@@ -263,6 +520,7 @@ void _gwinFlushRedraws(GRedrawMethod how) {
 			#endif
 		}
 	}
+	#endif
 
 	// Do the visible windows next
 	while ((RedrawPending & DOREDRAW_VISIBLES)) {
@@ -273,7 +531,13 @@ void _gwinFlushRedraws(GRedrawMethod how) {
 				continue;
 
 			// Do the redraw
-			#if GDISP_NEED_CLIP
+			MarkDirty(gh);
+			#if GWIN_REDRAW_REGIONS
+				// Only the visible part of the window
+				gdispRegionSetRect(&rgn, gh->x, gh->y, gh->width, gh->height);
+				ExcludeWindowsAbove(&rgn, gh, TRUE);
+				RedrawWindowRegion(gh, &rgn);
+			#elif GDISP_NEED_CLIP
 				gdispGSetClip(gh->display, gh->x, gh->y, gh->width, gh->height);
 				_GWINwm->vmt->Redraw(gh);
 				gdispGUnsetClip(gh->display);
@@ -301,6 +565,13 @@ void _gwinFlushRedraws(GRedrawMethod how) {
 		releaselock:
 	#endif
 
+	#if GWIN_NEED_COMPOSITOR
+		// Once everything is drawn send the frame to the real displays
+		if ((RedrawPending & (DOREDRAW_INVISIBLES|DOREDRAW_VISIBLES|DOREDRAW_COMPOSE)) == DOREDRAW_COMPOSE
+				&& (how != REDRAW_INSESSION || GWIN_REDRAW_IMMEDIATE))
+			CompositorFlush();
+	#endif
+
 	// Release the lock
 	if (how == REDRAW_WAIT || how == REDRAW_NOWAIT)
 		gfxSemSignal(&gwinsem);
@@ -382,6 +653,7 @@ bool_t _gwinDrawStart(GHandle gh) {
 	}
 
 	// OK - we are ready to draw.
+	MarkDirty(gh);
 	#if GDISP_NEED_CLIP
 		gdispGSetClip(gh->display, gh->x, gh->y, gh->width, gh->height);
 	#endif
@@ -397,6 +669,12 @@ void _gwinDrawEnd(GHandle gh) {
 	// Look for something to redraw
 	_gwinFlushRedraws(REDRAW_INSESSION);
 
+	// Send the changes to the real display on the next frame
+	#if GWIN_NEED_COMPOSITOR && !GWIN_REDRAW_IMMEDIATE
+		if ((RedrawPending & DOREDRAW_COMPOSE))
+			TriggerRedraw();
+	#endif
+
 	// Release the lock
 	gfxSemSignal(&gwinsem);
 }
@@ -580,13 +858,16 @@ GWindowMinMax gwinGetMinMax(GHandle gh) {
 void gwinRedrawDisplay(GDisplay *g, bool_t preserve) {
 	GHandle	gh;
 
+	if (g)
+		g = _gwinCompositorFindDisplay(g);
+
 	for(gh = gwinGetNextWindow(0); gh; gh = gwinGetNextWindow(gh)) {
 
 		// Skip if it is for a different display
 		if (g && gh->display != g)
 			continue;
 
-		#if GWIN_NEED_CONTAINERS
+		#if GWIN_NEED_CONTAINERS && !GWIN_REDRAW_REGIONS
 			// Skip if it is not a top level window (parents internally take care of their children)
 			if (gh->parent)
 				continue;
@@ -768,10 +1049,11 @@ static void WM_Redraw(GHandle gh) {
 				gh->vmt->AfterClear(gh);
 		}
 
-		#if GWIN_NEED_CONTAINERS
+		#if GWIN_NEED_CONTAINERS && !GWIN_REDRAW_REGIONS
 			// If this is container but not a parent reveal, mark any visible children for redraw
 			//	We redraw our children here as we have overwritten them in redrawing the parent
 			//	as GDISP/GWIN doesn't support complex clipping regions.
+			//	With GWIN_REDRAW_REGIONS the children are excluded from the area we redraw.
 			if ((flags & (GWIN_FLG_CONTAINER|GWIN_FLG_PARENTREVEAL)) == GWIN_FLG_CONTAINER) {
 
 				// Container redraw is done
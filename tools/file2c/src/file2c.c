@@ -47,6 +47,142 @@ static char *clean4c(char *fname) {
 	return fname;
 }
 
+/*
+ * LZ4 block compression for compressed ROMFS entries.
+ * This is a simple greedy compressor. Each block is compressed independently.
+ */
+#define LZ4_HASHBITS	12
+#define LZ4_MINMATCH	4
+#define LZ4_MFLIMIT		12			/* A match can't start within this many bytes of the block end */
+#define LZ4_LASTLITERALS	5		/* The last bytes of a block are always literals */
+
+static unsigned lz4hash(const unsigned char *p) {
+	unsigned long v;
+
+	v = (unsigned long)p[0] | ((unsigned long)p[1] << 8) | ((unsigned long)p[2] << 16) | ((unsigned long)p[3] << 24);
+	return (unsigned)(((v * 2654435761UL) & 0xFFFFFFFFUL) >> (32 - LZ4_HASHBITS));
+}
+
+static unsigned char *lz4length(unsigned char *op, size_t len) {
+	for(; len >= 255; len -= 255)
+		*op++ = 255;
+	*op++ = (unsigned char)len;
+	return op;
+}
+
+static unsigned char *lz4sequence(unsigned char *op, const unsigned char *lit, size_t litlen, size_t offset, size_t mlen) {
+	unsigned char *tok;
+
+	tok = op++;
+	*tok = (unsigned char)((litlen >= 15 ? 15 : litlen) << 4);
+	if (litlen >= 15)
+		op = lz4length(op, litlen - 15);
+	memcpy(op, lit, litlen);
+	op += litlen;
+	if (mlen) {
+		*op++ = (unsigned char)offset;
+		*op++ = (unsigned char)(offset >> 8);
+		mlen -= LZ4_MINMATCH;
+		*tok |= (unsigned char)(mlen >= 15 ? 15 : mlen);
+		if (mlen >= 15)
+			op = lz4length(op, mlen - 15);
+	}
+	return op;
+}
+
+static size_t lz4block(const unsigned char *src, size_t len, unsigned char *dst) {
+	static long		htab[1 << LZ4_HASHBITS];
+	unsigned char	*op;
+	size_t			ip, anchor, mlen;
+	long			ref;
+	unsigned		h;
+
+	for(h = 0; h < (1 << LZ4_HASHBITS); h++)
+		htab[h] = -1;
+	op = dst;
+	anchor = ip = 0;
+	while (ip + LZ4_MFLIMIT < len) {
+		h = lz4hash(src+ip);
+		ref = htab[h];
+		htab[h] = (long)ip;
+		if (ref < 0 || ip - ref > 65535 || memcmp(src+ref, src+ip, LZ4_MINMATCH)) {
+			ip++;
+			continue;
+		}
+		for(mlen = LZ4_MINMATCH; ip + mlen < len - LZ4_LASTLITERALS && src[ref+mlen] == src[ip+mlen]; mlen++);
+		op = lz4sequence(op, src+anchor, ip-anchor, ip-ref, mlen);
+		ip += mlen;
+		anchor = ip;
+	}
+	return lz4sequence(op, src+anchor, len-anchor, 0, 0) - dst;
+}
+
+/* Compress a whole file into the compressed ROMFS format. Returns the compressed length. */
+static size_t romfscompress(const unsigned char *src, size_t len, unsigned blockbits, unsigned char **pdst) {
+	unsigned char	*dst;
+	size_t			nblocks, blk, pos, bsize, hdrlen;
+
+	bsize = (size_t)1 << blockbits;
+	nblocks = (len + bsize - 1) >> blockbits;
+	hdrlen = 1 + 4 * (nblocks + 1);
+	if (!(dst = malloc(hdrlen + len + len/255 + 16*nblocks + 16)))
+		return 0;
+	dst[0] = (unsigned char)blockbits;
+	for(pos = hdrlen, blk = 0; blk <= nblocks; blk++) {
+		dst[1+4*blk+0] = (unsigned char)pos;
+		dst[1+4*blk+1] = (unsigned char)(pos >> 8);
+		dst[1+4*blk+2] = (unsigned char)(pos >> 16);
+		dst[1+4*blk+3] = (unsigned char)(pos >> 24);
+		if (blk < nblocks)
+			pos += lz4block(src + (blk << blockbits), blk == nblocks-1 ? len - (blk << blockbits) : bsize, dst+pos);
+	}
+	*pdst = dst;
+	return pos;
+}
+
+/*
+ * A sorted index of the ROMFS directory entries found in previously generated files.
+ */
+typedef struct romfsentry {
+	char *	name;
+	char *	dirname;
+} romfsentry;
+
+static int romfsentrycmp(const void *a, const void *b) {
+	return strcmp(((const romfsentry *)a)->dirname, ((const romfsentry *)b)->dirname);
+}
+
+/* Scan a generated file for its directory entries. Returns the new number of entries or -1 on error. */
+static int romfsscan(const char *fname, romfsentry **pentries, int cnt) {
+	FILE *	f;
+	char	line[FILENAME_MAX*2+256];
+	char	*p, *e, *n;
+
+	if (!(f = fopen(fname, "r"))) {
+		fprintf(stderr, "Could not open input file '%s'\n", fname);
+		return -1;
+	}
+	while(fgets(line, sizeof(line), f)) {
+		/* We are looking for:	ROMFS_DIRENTRY name_dir = { 0, 0, ROMFS_DIRENTRY_HEAD, "dirname", ... */
+		if (!(p = strstr(line, "ROMFS_DIRENTRY ")) || !(e = strstr(p, " = {")))
+			continue;
+		p += 15;
+		if (!(n = strchr(e, '"')) || !(e[0] = 0, e = strchr(++n, '"')))
+			continue;
+		*e = 0;
+		if (!(*pentries = realloc(*pentries, (cnt+1) * sizeof(romfsentry)))
+				|| !((*pentries)[cnt].name = strdup(p))
+				|| !((*pentries)[cnt].dirname = strdup(n))) {
+			fprintf(stderr, "Out of memory\n");
+			fclose(f);
+			return -1;
+		}
+		cnt++;
+	}
+	fclose(f);
+	return cnt;
+}
+
 int main(int argc, char * argv[])
 {
 char *		opt_progname;
@@ -56,6 +192,8 @@ char *		opt_arrayname;
 char *		opt_dirname;
 int			opt_breakblocks;
 int			opt_romdir;
+int			opt_index;
+unsigned	opt_compress;
 char *		opt_static;
 char *		opt_const;
 FILE *		f_input;
@@ -63,38 +201,60 @@ FILE *		f_output;
 unsigned	blocknum;
 size_t		len, totallen;
 size_t		i;
+unsigned char *	filebuf;
+unsigned char *	cmpbuf;
+char **		files;
+int			nfiles;
+romfsentry *	entries;
+int			nentries;
 
 	/* Default values for our parameters */
 	opt_progname = basenameof(argv[0]);
 	opt_inputfile = opt_outputfile = opt_arrayname = opt_dirname = 0;
-	opt_breakblocks = opt_romdir = 0;
+	opt_breakblocks = opt_romdir = opt_index = 0;
+	opt_compress = 0;
 	opt_static = opt_const = "";
 
 	/* Read the arguments */
+	if (!(files = malloc(argc * sizeof(char *)))) {
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	nfiles = 0;
 	while(*++argv) {
 		if (argv[0][0] == '-') {
 			while (*++(argv[0])) {
 				switch(argv[0][0]) {
 				case '?': case 'h':										goto usage;
 				case 'd':		opt_romdir = 1;							break;
+				case 'i':		opt_index = 1;							break;
 				case 'b':		opt_breakblocks = 1;					break;
 				case 'c':		opt_const = "const ";					break;
 				case 's':		opt_static = "static ";					break;
 				case 'n':		opt_arrayname = *++argv;				goto nextarg;
 				case 'f':		opt_romdir = 1; opt_dirname = *++argv;	goto nextarg;
+				case 'z':		opt_romdir = 1; if (!opt_compress) opt_compress = 10;	break;
+				case 'w':
+					opt_romdir = 1;
+					i = (size_t)atoi(*++argv);
+					for(opt_compress = 8; opt_compress <= 15 && ((size_t)1 << opt_compress) != i; opt_compress++);
+					if (opt_compress > 15) {
+						fprintf(stderr, "The compression block size must be a power of 2 from 256 to 32768\n");
+						goto usage;
+					}
+					goto nextarg;
 				default:
 					fprintf(stderr, "Unknown flag -%c\n", argv[0][0]);
 					goto usage;
 				}
 			}
-		} else if (!opt_inputfile)
-			opt_inputfile = argv[0];
-		else if (!opt_outputfile)
-			opt_outputfile = argv[0];
+		} else if (opt_index || nfiles < 2)
+			files[nfiles++] = argv[0];
 		else {
 			usage:
 			fprintf(stderr, "Usage:\n\n%s -?\n"
-							"%s [-dbcs] [-n name] [-f file] [inputfile] [outputfile]\n"
+							"%s [-dbcsz] [-n name] [-f file] [-w size] [inputfile] [outputfile]\n"
+							"%s -i [-n name] generatedfile...\n"
 							"\t-?\tThis help\n"
 							"\t-h\tThis help\n"
 							"\t-d\tAdd a directory entry for the ROM file system\n"
@@ -103,12 +263,62 @@ size_t		i;
 							"\t-s\tDeclare as static\n"
 							"\t-n name\tUse \"name\" as the name of the array\n"
 							"\t-f file\tUse \"file\" as the filename in the ROM directory entry\n"
-					, opt_progname, opt_progname);
+							"\t-z\tCompress the file for the ROM file system (implies -d)\n"
+							"\t-w size\tCompress using blocks of \"size\" bytes (default 1024, implies -z)\n"
+							"\t-i\tOutput a sorted index of the ROM directory entries in the\n"
+							"\t\tgenerated files. Include it after them in romfs_files.h\n"
+					, opt_progname, opt_progname, opt_progname);
 			return 1;
 		}
 	nextarg:	;
 	}
 
+	/* Generate a directory index from previously generated files */
+	if (opt_index) {
+		if (opt_romdir || opt_breakblocks || opt_dirname || !nfiles) {
+			fprintf(stderr, "The -i flag needs a list of generated files and can only be combined with -n\n");
+			goto usage;
+		}
+		entries = 0;
+		for(nentries = 0, i = 0; i < (size_t)nfiles; i++) {
+			if ((nentries = romfsscan(files[i], &entries, nentries)) < 0)
+				return 1;
+		}
+		qsort(entries, nentries, sizeof(romfsentry), romfsentrycmp);
+		for(i = 1; i < (size_t)nentries; i++) {
+			if (!strcmp(entries[i-1].dirname, entries[i].dirname)) {
+				fprintf(stderr, "Duplicate ROM directory entry \"%s\"\n", entries[i].dirname);
+				return 1;
+			}
+		}
+		if (!nentries) {
+			fprintf(stderr, "No ROM directory entries found\n");
+			return 1;
+		}
+		printf("/**\n * This file was generated using...\n *\n *\t%s -i", opt_progname);
+		if (opt_arrayname) printf(" -n %s", opt_arrayname);
+		else opt_arrayname = "romfs_index";
+		for(i = 0; i < (size_t)nfiles; i++)
+			printf(" %s", files[i]);
+		printf("\n *\n * Include it after the files above in romfs_files.h\n */\n");
+		printf("\n#ifdef ROMFS_DIRENTRY_HEAD\n");
+		printf("\tstatic const ROMFS_DIRENTRY * const %s[] = {\n", opt_arrayname);
+		for(i = 0; i < (size_t)nentries; i++)
+			printf("\t\t&%s,\t\t// %s\n", entries[i].name, entries[i].dirname);
+		printf("\t};\n\t#define ROMFS_DIRENTRY_INDEX %s\n#endif\n", opt_arrayname);
+		if (ferror(stdout))
+			fprintf(stderr, "Output file write error - disk full?\n");
+		return 0;
+	}
+	if (nfiles > 0) opt_inputfile = files[0];
+	if (nfiles > 1) opt_outputfile = files[1];
+
+	/* Compressed data must be one array */
+	if (opt_compress && opt_breakblocks) {
+		fprintf(stderr, "The -b flag can't be used with compression\n");
+		goto usage;
+	}
+
 	/* Make sure we can generate a default directory name if required */
 	if (opt_romdir && !opt_dirname && !opt_inputfile) {
 		fprintf(stderr, "If using -d you must either specify an input filename or use -f to specify a directory entry filename\n");
@@ -154,8 +364,10 @@ size_t		i;
 		if (opt_breakblocks) fprintf(f_output, "b");
 		if (opt_const[0]) fprintf(f_output, "c");
 		if (opt_static[0]) fprintf(f_output, "s");
+		if (opt_compress) fprintf(f_output, "z");
 		if (opt_arrayname) fprintf(f_output, "n %s", opt_arrayname);
 		if (opt_dirname) fprintf(f_output, (opt_arrayname ? " -f %s" : "f %s"), opt_dirname);
+		if (opt_compress && opt_compress != 10) fprintf(f_output, " -w %u", 1U << opt_compress);
 	}
 	if (opt_inputfile) fprintf(f_output, " %s", opt_inputfile);
 	if (opt_outputfile) fprintf(f_output, " %s", opt_outputfile);
@@ -177,6 +389,42 @@ size_t		i;
 	if (opt_romdir && !opt_dirname)
 		opt_dirname = filenameof(opt_inputfile);
 
+	/* Compressed files are read completely and then output as a single block */
+	if (opt_compress) {
+		filebuf = 0;
+		totallen = 0;
+		while((len = fread(buf, 1, sizeof(buf), f_input))) {
+			if (!(filebuf = realloc(filebuf, totallen + len))) {
+				fprintf(stderr, "Out of memory\n");
+				return 1;
+			}
+			memcpy(filebuf+totallen, buf, len);
+			totallen += len;
+		}
+		if (!(len = romfscompress(filebuf, totallen, opt_compress, &cmpbuf))) {
+			fprintf(stderr, "Out of memory\n");
+			return 1;
+		}
+		fprintf(stderr, "%s: %u bytes compressed to %u bytes\n", opt_dirname, (unsigned)totallen, (unsigned)len);
+
+		/* Store it uncompressed if compression doesn't help */
+		if (len >= totallen) {
+			fprintf(stderr, "%s: Storing uncompressed\n", opt_dirname);
+			free(cmpbuf);
+			cmpbuf = filebuf;
+			len = totallen;
+			opt_compress = 0;
+		}
+		fprintf(f_output, "%s%schar %s[] = {", opt_static, opt_const, opt_arrayname);
+		for(i = 0; i < len; i++)
+			fprintf(f_output, (i & 0x0F) ? " 0x%02X," : "\n\t0x%02X,", cmpbuf[i]);
+		fprintf(f_output, "\n};\n");
+		if (cmpbuf != filebuf)
+			free(cmpbuf);
+		free(filebuf);
+		goto direntry;
+	}
+
 	/* Read the file processing 1K at a time */
 	blocknum = 0;
 	totallen = 0;
@@ -193,9 +441,10 @@ size_t		i;
 	fprintf(f_output, "\n};\n");
 
 	/* Add the directory entry if required */
+direntry:
 	if (opt_romdir) {
 		fprintf(f_output, "\n#ifdef ROMFS_DIRENTRY_HEAD\n");
-		fprintf(f_output, "\t%s%sROMFS_DIRENTRY %s_dir = { 0, 0, ROMFS_DIRENTRY_HEAD, \"%s\", %u, %s };\n", opt_static, opt_const, opt_arrayname, opt_dirname, totallen, opt_arrayname);
+		fprintf(f_output, "\t%s%sROMFS_DIRENTRY %s_dir = { 0, %u, ROMFS_DIRENTRY_HEAD, \"%s\", %u, %s };\n", opt_static, opt_const, opt_arrayname, opt_compress ? 1 : 0, opt_dirname, (unsigned)totallen, opt_arrayname);
 		fprintf(f_output, "\t#undef ROMFS_DIRENTRY_HEAD\n\t#define ROMFS_DIRENTRY_HEAD &%s_dir\n#endif\n", opt_arrayname);
 	}
 